@@ -0,0 +1,58 @@
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.arrow.*;
+import static org.bytedeco.arrow.global.arrow.*;
+
+/**
+ * Converts rows packed like the C struct below into a RecordBatch with a
+ * single call to RowConverter, instead of one Append() per value as in
+ * RowWiseConversionExample, and converts the batch back to rows.
+ *
+ *   struct { int64_t id; double cost; int32_t quantity; uint8_t validity; }
+ */
+public class PackedRowConversionExample {
+    public static void THROW_ON_FAILURE(Status status_) {
+        if (!status_.ok()) {
+          throw new RuntimeException(status_.message());
+        }
+    }
+
+    public static void main(String args[]) {
+        int numRows = args.length > 0 ? Integer.parseInt(args[0]) : 1000000;
+
+        Schema schema = new Schema(new FieldVector(
+                new Field("id", int64()), new Field("cost", float64()), new Field("quantity", int32())));
+        RowConverter converter = new RowConverter(null);
+        THROW_ON_FAILURE(RowConverter.Make(schema, true, default_memory_pool(), converter));
+        int rowSize = (int)converter.row_size();
+        int validityOffset = (int)converter.validity_offset();
+
+        // fill the rows, leaving the cost of every tenth row null
+        BytePointer rows = new BytePointer((long)numRows * rowSize);
+        ByteBuffer buffer = rows.asByteBuffer().order(ByteOrder.nativeOrder());
+        for (int i = 0; i < numRows; i++) {
+            int row = i * rowSize;
+            buffer.putLong(row + (int)converter.field_offset(0), i);
+            buffer.putDouble(row + (int)converter.field_offset(1), i * 0.25);
+            buffer.putInt(row + (int)converter.field_offset(2), i % 100);
+            buffer.put(row + validityOffset, (byte)(i % 10 == 0 ? 0x5 : 0x7));
+        }
+
+        long start = System.nanoTime();
+        RecordBatch batch = new RecordBatch(null);
+        THROW_ON_FAILURE(converter.ToRecordBatch(rows, numRows, batch));
+        long middle = System.nanoTime();
+        ArrowBuffer packed = new ArrowBuffer((Pointer)null);
+        THROW_ON_FAILURE(converter.ToRows(batch, packed));
+        long end = System.nanoTime();
+
+        System.out.println(batch.Slice(0, 3).ToString());
+        System.out.println("nulls in cost: " + batch.column(1).null_count());
+        System.out.printf("%d rows to batch: %.1f Mrows/s, back to rows: %.1f Mrows/s%n", numRows,
+                numRows / ((middle - start) / 1e3), numRows / ((end - middle) / 1e3));
+        System.out.println("same rows: " + (packed.size() == rows.capacity()
+                && packed.data().capacity(packed.size()).asByteBuffer().equals(rows.asByteBuffer())));
+        System.exit(0);
+    }
+}
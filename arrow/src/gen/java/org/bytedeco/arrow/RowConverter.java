@@ -0,0 +1,116 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.arrow;
+
+import org.bytedeco.arrow.Function;
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.arrow.global.arrow.*;
+
+
+/** \class RowConverter
+ *  \brief Converts between packed rows of fixed size and record batches
+ * 
+ *  Supported are the fields of fixed width such as integers, floating-point
+ *  numbers, temporal types, decimals, and fixed-size binary. Boolean values
+ *  take one byte in a row, zero meaning false. Bit i of the validity bytes of
+ *  a row, in least-significant bit order like Arrow bitmaps, is set when field
+ *  i is not null. */
+@Namespace("arrow") @NoOffset @Properties(inherit = org.bytedeco.arrow.presets.arrow.class)
+public class RowConverter extends Pointer {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public RowConverter(Pointer p) { super(p); }
+
+  /** \brief Create a converter for rows laid out like a C struct
+   * 
+   *  The fields are placed in order at their natural alignment, followed by
+   *  the validity bytes if requested, and the size of a row is padded to the
+   *  largest alignment.
+   * 
+   *  @param schema [in] the schema of the record batches
+   *  @param with_validity [in] whether rows contain validity bits
+   *  @param pool [in] the MemoryPool used for the buffers of record batches
+   *  @param out [out] the created converter
+   *  @return Status */
+  public static native @ByVal Status Make(@Const @SharedPtr @ByRef Schema schema, @Cast("bool") boolean with_validity,
+                       MemoryPool pool, @UniquePtr RowConverter out);
+
+  /** \brief Create a converter for rows with the given layout
+   * 
+   *  @param schema [in] the schema of the record batches
+   *  @param field_offsets [in] the byte offset in a row of each field of the schema
+   *  @param row_size [in] the size of a row in bytes
+   *  @param validity_offset [in] the byte offset in a row of the validity bits,
+   *             or -1 if rows have no validity bits
+   *  @param pool [in] the MemoryPool used for the buffers of record batches
+   *  @param out [out] the created converter
+   *  @return Status */
+  public static native @ByVal Status Make(@Const @SharedPtr @ByRef Schema schema, @Cast("const int64_t*") LongPointer field_offsets,
+                       @Cast("int64_t") long row_size, @Cast("int64_t") long validity_offset, MemoryPool pool,
+                       @UniquePtr RowConverter out);
+  public static native @ByVal Status Make(@Const @SharedPtr @ByRef Schema schema, @Cast("const int64_t*") LongBuffer field_offsets,
+                       @Cast("int64_t") long row_size, @Cast("int64_t") long validity_offset, MemoryPool pool,
+                       @UniquePtr RowConverter out);
+  public static native @ByVal Status Make(@Const @SharedPtr @ByRef Schema schema, @Cast("const int64_t*") long[] field_offsets,
+                       @Cast("int64_t") long row_size, @Cast("int64_t") long validity_offset, MemoryPool pool,
+                       @UniquePtr RowConverter out);
+
+  /** \brief The schema of the record batches */
+  public native @Const @SharedPtr @ByRef Schema schema();
+
+  /** \brief The size of a row in bytes */
+  public native @Cast("int64_t") long row_size();
+
+  /** \brief The byte offset in a row of field i */
+  public native @Cast("int64_t") long field_offset(int i);
+
+  /** \brief The byte offset in a row of the validity bits, or -1 if there are none */
+  public native @Cast("int64_t") long validity_offset();
+
+  /** \brief Convert packed rows to a record batch
+   * 
+   *  @param rows [in] the buffer of num_rows * row_size() bytes
+   *  @param num_rows [in] the number of rows
+   *  @param out [out] the resulting RecordBatch
+   *  @return Status */
+  public native @ByVal Status ToRecordBatch(@Cast("const uint8_t*") BytePointer rows, @Cast("int64_t") long num_rows,
+                         @SharedPtr RecordBatch out);
+  public native @ByVal Status ToRecordBatch(@Cast("const uint8_t*") ByteBuffer rows, @Cast("int64_t") long num_rows,
+                         @SharedPtr RecordBatch out);
+  public native @ByVal Status ToRecordBatch(@Cast("const uint8_t*") byte[] rows, @Cast("int64_t") long num_rows,
+                         @SharedPtr RecordBatch out);
+
+  /** \brief Append packed rows to the field builders of a RecordBatchBuilder
+   * 
+   *  @param rows [in] the buffer of num_rows * row_size() bytes
+   *  @param num_rows [in] the number of rows
+   *  @param builder [in] a builder with the same schema
+   *  @return Status */
+  public native @ByVal Status Append(@Cast("const uint8_t*") BytePointer rows, @Cast("int64_t") long num_rows, RecordBatchBuilder builder);
+  public native @ByVal Status Append(@Cast("const uint8_t*") ByteBuffer rows, @Cast("int64_t") long num_rows, RecordBatchBuilder builder);
+  public native @ByVal Status Append(@Cast("const uint8_t*") byte[] rows, @Cast("int64_t") long num_rows, RecordBatchBuilder builder);
+
+  /** \brief Convert a record batch to packed rows
+   * 
+   *  Bytes of rows not covered by fields or validity bits are left untouched.
+   * 
+   *  @param batch [in] a record batch with the same schema
+   *  @param rows [out] the buffer of batch.num_rows() * row_size() bytes to fill
+   *  @return Status */
+  public native @ByVal Status ToRows(@Const @ByRef RecordBatch batch, @Cast("uint8_t*") BytePointer rows);
+  public native @ByVal Status ToRows(@Const @ByRef RecordBatch batch, @Cast("uint8_t*") ByteBuffer rows);
+  public native @ByVal Status ToRows(@Const @ByRef RecordBatch batch, @Cast("uint8_t*") byte[] rows);
+
+  /** \brief Convert a record batch to packed rows in a new buffer
+   * 
+   *  @param batch [in] a record batch with the same schema
+   *  @param out [out] the buffer of batch.num_rows() * row_size() bytes, with
+   *              bytes not covered by fields or validity bits zeroed
+   *  @return Status */
+  public native @ByVal Status ToRows(@Const @ByRef RecordBatch batch, @SharedPtr @Cast({"", "std::shared_ptr<arrow::Buffer>*"}) ArrowBuffer out);
+}
@@ -10867,4 +10867,41 @@ public static final int kFeatherV2Version = kFeatherV2Version();
   // namespace arrow
 
 
+// Parsed from row_conversion.h
+
+// Conversion of packed rows of fixed size to and from record batches.
+//
+// A packed row holds the values of the fixed-width fields of a schema at
+// fixed byte offsets, like a C struct, optionally with validity bits, one per
+// field, somewhere in the row. A RowConverter transposes whole buffers of such
+// rows into the columns of a record batch, or into the builders of a
+// RecordBatchBuilder, and back, in a single call. Rows are processed in blocks
+// that stay in cache while all of their fields are gathered or scattered with
+// loops specialized on the width of each field, and validity bitmaps are built
+// a byte at a time instead of a bit at a time.
+
+// #pragma once
+
+// #include <algorithm>
+// #include <cstdint>
+// #include <cstring>
+// #include <memory>
+// #include <utility>
+// #include <vector>
+
+// #include "arrow/array.h"
+// #include "arrow/buffer.h"
+// #include "arrow/memory_pool.h"
+// #include "arrow/record_batch.h"
+// #include "arrow/result.h"
+// #include "arrow/status.h"
+// #include "arrow/table_builder.h"
+// #include "arrow/type.h"
+// Targeting ../RowConverter.java
+
+
+
+  // namespace arrow
+
+
 }
@@ -154,6 +154,7 @@ import org.bytedeco.javacpp.tools.InfoMapper;
                 "arrow/ipc/message.h",
                 "arrow/ipc/reader.h",
                 "arrow/ipc/writer.h",
+                "row_conversion.h",
             },
             link = "arrow@.500"
         ),
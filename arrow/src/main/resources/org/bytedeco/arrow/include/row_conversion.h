@@ -0,0 +1,399 @@
+// Conversion of packed rows of fixed size to and from record batches.
+//
+// A packed row holds the values of the fixed-width fields of a schema at
+// fixed byte offsets, like a C struct, optionally with validity bits, one per
+// field, somewhere in the row. A RowConverter transposes whole buffers of such
+// rows into the columns of a record batch, or into the builders of a
+// RecordBatchBuilder, and back, in a single call. Rows are processed in blocks
+// that stay in cache while all of their fields are gathered or scattered with
+// loops specialized on the width of each field, and validity bitmaps are built
+// a byte at a time instead of a bit at a time.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/record_batch.h"
+#include "arrow/result.h"
+#include "arrow/status.h"
+#include "arrow/table_builder.h"
+#include "arrow/type.h"
+
+namespace arrow {
+
+/// \class RowConverter
+/// \brief Converts between packed rows of fixed size and record batches
+///
+/// Supported are the fields of fixed width such as integers, floating-point
+/// numbers, temporal types, decimals, and fixed-size binary. Boolean values
+/// take one byte in a row, zero meaning false. Bit i of the validity bytes of
+/// a row, in least-significant bit order like Arrow bitmaps, is set when field
+/// i is not null.
+class RowConverter {
+ public:
+  /// \brief Create a converter for rows laid out like a C struct
+  ///
+  /// The fields are placed in order at their natural alignment, followed by
+  /// the validity bytes if requested, and the size of a row is padded to the
+  /// largest alignment.
+  ///
+  /// \param[in] schema the schema of the record batches
+  /// \param[in] with_validity whether rows contain validity bits
+  /// \param[in] pool the MemoryPool used for the buffers of record batches
+  /// \param[out] out the created converter
+  /// \return Status
+  static Status Make(const std::shared_ptr<Schema>& schema, bool with_validity,
+                     MemoryPool* pool, std::unique_ptr<RowConverter>* out) {
+    std::vector<int64_t> widths;
+    ARROW_RETURN_NOT_OK(FieldWidths(*schema, &widths));
+    std::vector<int64_t> offsets(widths.size());
+    int64_t size = 0, max_alignment = 1;
+    for (size_t i = 0; i < widths.size(); i++) {
+      int64_t alignment = 1;
+      while (alignment < 8 && widths[i] % (alignment * 2) == 0) {
+        alignment *= 2;
+      }
+      max_alignment = std::max(max_alignment, alignment);
+      offsets[i] = size = (size + alignment - 1) / alignment * alignment;
+      size += widths[i];
+    }
+    int64_t validity_offset = -1;
+    if (with_validity) {
+      validity_offset = size;
+      size += ValidityBytes(schema->num_fields());
+    }
+    size = (size + max_alignment - 1) / max_alignment * max_alignment;
+    return Make(schema, offsets.data(), size, validity_offset, pool, out);
+  }
+
+  /// \brief Create a converter for rows with the given layout
+  ///
+  /// \param[in] schema the schema of the record batches
+  /// \param[in] field_offsets the byte offset in a row of each field of the schema
+  /// \param[in] row_size the size of a row in bytes
+  /// \param[in] validity_offset the byte offset in a row of the validity bits,
+  ///            or -1 if rows have no validity bits
+  /// \param[in] pool the MemoryPool used for the buffers of record batches
+  /// \param[out] out the created converter
+  /// \return Status
+  static Status Make(const std::shared_ptr<Schema>& schema, const int64_t* field_offsets,
+                     int64_t row_size, int64_t validity_offset, MemoryPool* pool,
+                     std::unique_ptr<RowConverter>* out) {
+    std::vector<int64_t> widths;
+    ARROW_RETURN_NOT_OK(FieldWidths(*schema, &widths));
+    int num_fields = schema->num_fields();
+    if (row_size <= 0) {
+      return Status::Invalid("Row size must be positive");
+    }
+    for (int i = 0; i < num_fields; i++) {
+      if (field_offsets[i] < 0 || field_offsets[i] + widths[i] > row_size) {
+        return Status::Invalid("Field ", schema->field(i)->name(), " at offset ",
+                               field_offsets[i], " does not fit in rows of ", row_size,
+                               " bytes");
+      }
+    }
+    if (validity_offset >= 0 && validity_offset + ValidityBytes(num_fields) > row_size) {
+      return Status::Invalid("Validity bits at offset ", validity_offset,
+                             " do not fit in rows of ", row_size, " bytes");
+    }
+    out->reset(new RowConverter(schema, std::move(widths),
+                                std::vector<int64_t>(field_offsets, field_offsets + num_fields),
+                                row_size, validity_offset < 0 ? -1 : validity_offset,
+                                pool != NULLPTR ? pool : default_memory_pool()));
+    return Status::OK();
+  }
+
+  /// \brief The schema of the record batches
+  const std::shared_ptr<Schema>& schema() const { return schema_; }
+
+  /// \brief The size of a row in bytes
+  int64_t row_size() const { return row_size_; }
+
+  /// \brief The byte offset in a row of field i
+  int64_t field_offset(int i) const { return offsets_[i]; }
+
+  /// \brief The byte offset in a row of the validity bits, or -1 if there are none
+  int64_t validity_offset() const { return validity_offset_; }
+
+  /// \brief Convert packed rows to a record batch
+  ///
+  /// \param[in] rows the buffer of num_rows * row_size() bytes
+  /// \param[in] num_rows the number of rows
+  /// \param[out] out the resulting RecordBatch
+  /// \return Status
+  Status ToRecordBatch(const uint8_t* rows, int64_t num_rows,
+                       std::shared_ptr<RecordBatch>* out) const {
+    std::vector<std::shared_ptr<ArrayData>> columns;
+    ARROW_RETURN_NOT_OK(ToColumns(rows, num_rows, &columns));
+    *out = RecordBatch::Make(schema_, num_rows, std::move(columns));
+    return Status::OK();
+  }
+
+  /// \brief Append packed rows to the field builders of a RecordBatchBuilder
+  ///
+  /// \param[in] rows the buffer of num_rows * row_size() bytes
+  /// \param[in] num_rows the number of rows
+  /// \param[in] builder a builder with the same schema
+  /// \return Status
+  Status Append(const uint8_t* rows, int64_t num_rows, RecordBatchBuilder* builder) const {
+    if (builder->num_fields() != schema_->num_fields() ||
+        !builder->schema()->Equals(*schema_, /*check_metadata=*/false)) {
+      return Status::Invalid("Schema of builder does not match schema of rows");
+    }
+    std::vector<std::shared_ptr<ArrayData>> columns;
+    ARROW_RETURN_NOT_OK(ToColumns(rows, num_rows, &columns));
+    for (int i = 0; i < builder->num_fields(); i++) {
+      ARROW_RETURN_NOT_OK(builder->GetField(i)->AppendArraySlice(*columns[i], 0, num_rows));
+    }
+    return Status::OK();
+  }
+
+  /// \brief Convert a record batch to packed rows
+  ///
+  /// Bytes of rows not covered by fields or validity bits are left untouched.
+  ///
+  /// \param[in] batch a record batch with the same schema
+  /// \param[out] rows the buffer of batch.num_rows() * row_size() bytes to fill
+  /// \return Status
+  Status ToRows(const RecordBatch& batch, uint8_t* rows) const {
+    if (!batch.schema()->Equals(*schema_, /*check_metadata=*/false)) {
+      return Status::Invalid("Schema of record batch does not match schema of rows");
+    }
+    int num_fields = schema_->num_fields();
+    int64_t num_rows = batch.num_rows();
+    std::vector<const uint8_t*> values(num_fields), validity(num_fields);
+    std::vector<int64_t> offsets(num_fields);
+    for (int i = 0; i < num_fields; i++) {
+      const ArrayData& data = *batch.column_data(i);
+      if (data.GetNullCount() > 0) {
+        if (validity_offset_ < 0) {
+          return Status::Invalid("Field ", schema_->field(i)->name(),
+                                 " has nulls but rows have no validity bits");
+        }
+        validity[i] = data.buffers[0]->data();
+      }
+      offsets[i] = data.offset;
+      if (data.buffers[1] == NULLPTR) {
+        continue;
+      }
+      values[i] = data.buffers[1]->data();
+      if (schema_->field(i)->type()->id() != Type::BOOL) {
+        values[i] += data.offset * widths_[i];
+      }
+    }
+
+    for (int64_t start = 0; start < num_rows; start += kBlockRows) {
+      int64_t length = num_rows - start < kBlockRows ? num_rows - start : kBlockRows;
+      uint8_t* block = rows + start * row_size_;
+      if (validity_offset_ >= 0) {
+        int64_t bytes = ValidityBytes(num_fields);
+        for (int64_t j = 0; j < length; j++) {
+          std::memset(block + j * row_size_ + validity_offset_, 0, bytes);
+        }
+      }
+      for (int i = 0; i < num_fields; i++) {
+        uint8_t* field = block + offsets_[i];
+        if (schema_->field(i)->type()->id() == Type::BOOL) {
+          for (int64_t j = 0; j < length; j++) {
+            field[j * row_size_] = GetBit(values[i], offsets[i] + start + j);
+          }
+        } else {
+          Scatter(values[i] + start * widths_[i], widths_[i], length, field);
+        }
+        if (validity_offset_ >= 0) {
+          uint8_t* bits = block + validity_offset_ + i / 8;
+          uint8_t bit = static_cast<uint8_t>(1 << (i % 8));
+          for (int64_t j = 0; j < length; j++) {
+            if (validity[i] == NULLPTR || GetBit(validity[i], offsets[i] + start + j)) {
+              bits[j * row_size_] |= bit;
+            }
+          }
+        }
+      }
+    }
+    return Status::OK();
+  }
+
+  /// \brief Convert a record batch to packed rows in a new buffer
+  ///
+  /// \param[in] batch a record batch with the same schema
+  /// \param[out] out the buffer of batch.num_rows() * row_size() bytes, with
+  ///             bytes not covered by fields or validity bits zeroed
+  /// \return Status
+  Status ToRows(const RecordBatch& batch, std::shared_ptr<Buffer>* out) const {
+    ARROW_ASSIGN_OR_RAISE(std::shared_ptr<Buffer> buffer,
+                          AllocateBuffer(batch.num_rows() * row_size_, pool_));
+    std::memset(buffer->mutable_data(), 0, static_cast<size_t>(buffer->size()));
+    ARROW_RETURN_NOT_OK(ToRows(batch, buffer->mutable_data()));
+    *out = std::move(buffer);
+    return Status::OK();
+  }
+
+ private:
+  // the number of rows processed together, sized so that a block stays in cache
+  static constexpr int64_t kBlockRows = 1024;
+
+  RowConverter(std::shared_ptr<Schema> schema, std::vector<int64_t> widths,
+               std::vector<int64_t> offsets, int64_t row_size, int64_t validity_offset,
+               MemoryPool* pool)
+      : schema_(std::move(schema)),
+        widths_(std::move(widths)),
+        offsets_(std::move(offsets)),
+        row_size_(row_size),
+        validity_offset_(validity_offset),
+        pool_(pool) {}
+
+  struct Bytes16 {
+    uint64_t low, high;
+  };
+
+  static int64_t ValidityBytes(int num_fields) { return (num_fields + 7) / 8; }
+
+  static bool GetBit(const uint8_t* bits, int64_t i) { return (bits[i >> 3] >> (i & 7)) & 1; }
+
+  static Status FieldWidths(const Schema& schema, std::vector<int64_t>* widths) {
+    widths->resize(schema.num_fields());
+    for (int i = 0; i < schema.num_fields(); i++) {
+      const std::shared_ptr<DataType>& type = schema.field(i)->type();
+      auto fixed_width = std::dynamic_pointer_cast<FixedWidthType>(type);
+      if (type->id() == Type::BOOL) {
+        (*widths)[i] = 1;
+      } else if (fixed_width != NULLPTR && type->id() != Type::DICTIONARY &&
+                 type->id() != Type::EXTENSION && fixed_width->bit_width() > 0 &&
+                 fixed_width->bit_width() % 8 == 0) {
+        (*widths)[i] = fixed_width->bit_width() / 8;
+      } else {
+        return Status::NotImplemented("Packed rows cannot hold field ",
+                                      schema.field(i)->name(), " of type ",
+                                      type->ToString());
+      }
+    }
+    return Status::OK();
+  }
+
+  // copies length values of a field from rows into a contiguous column
+  template <typename T>
+  static void GatherAs(const uint8_t* field, int64_t row_size, int64_t length, uint8_t* column) {
+    T* out = reinterpret_cast<T*>(column);
+    for (int64_t j = 0; j < length; j++) {
+      std::memcpy(out + j, field + j * row_size, sizeof(T));
+    }
+  }
+
+  // copies length values of a contiguous column into a field of rows
+  template <typename T>
+  static void ScatterAs(const uint8_t* column, int64_t row_size, int64_t length, uint8_t* field) {
+    const T* in = reinterpret_cast<const T*>(column);
+    for (int64_t j = 0; j < length; j++) {
+      std::memcpy(field + j * row_size, in + j, sizeof(T));
+    }
+  }
+
+  void Gather(const uint8_t* field, int64_t width, int64_t length, uint8_t* column) const {
+    switch (width) {
+      case 1: GatherAs<uint8_t>(field, row_size_, length, column); break;
+      case 2: GatherAs<uint16_t>(field, row_size_, length, column); break;
+      case 4: GatherAs<uint32_t>(field, row_size_, length, column); break;
+      case 8: GatherAs<uint64_t>(field, row_size_, length, column); break;
+      case 16: GatherAs<Bytes16>(field, row_size_, length, column); break;
+      default:
+        for (int64_t j = 0; j < length; j++) {
+          std::memcpy(column + j * width, field + j * row_size_, static_cast<size_t>(width));
+        }
+    }
+  }
+
+  void Scatter(const uint8_t* column, int64_t width, int64_t length, uint8_t* field) const {
+    switch (width) {
+      case 1: ScatterAs<uint8_t>(column, row_size_, length, field); break;
+      case 2: ScatterAs<uint16_t>(column, row_size_, length, field); break;
+      case 4: ScatterAs<uint32_t>(column, row_size_, length, field); break;
+      case 8: ScatterAs<uint64_t>(column, row_size_, length, field); break;
+      case 16: ScatterAs<Bytes16>(column, row_size_, length, field); break;
+      default:
+        for (int64_t j = 0; j < length; j++) {
+          std::memcpy(field + j * row_size_, column + j * width, static_cast<size_t>(width));
+        }
+    }
+  }
+
+  // packs 8 bits at a time, taken from one byte per row, and returns the number of bits set
+  int64_t PackBits(const uint8_t* field, uint8_t mask, int64_t length, uint8_t* bits) const {
+    int64_t count = 0;
+    for (int64_t j = 0; j < length; j += 8) {
+      int64_t n = std::min<int64_t>(8, length - j);
+      uint8_t byte = 0;
+      for (int64_t k = 0; k < n; k++) {
+        byte |= static_cast<uint8_t>(((field[(j + k) * row_size_] & mask) != 0) << k);
+      }
+      bits[j / 8] = byte;
+      for (; byte != 0; byte &= byte - 1) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  Status ToColumns(const uint8_t* rows, int64_t num_rows,
+                   std::vector<std::shared_ptr<ArrayData>>* columns) const {
+    if (num_rows < 0) {
+      return Status::Invalid("Number of rows must not be negative");
+    }
+    int num_fields = schema_->num_fields();
+    int64_t bitmap_size = (num_rows + 7) / 8;
+    std::vector<std::shared_ptr<Buffer>> values(num_fields), validity(num_fields);
+    std::vector<int64_t> valid(num_fields, num_rows);
+    for (int i = 0; i < num_fields; i++) {
+      bool is_bool = schema_->field(i)->type()->id() == Type::BOOL;
+      ARROW_ASSIGN_OR_RAISE(values[i], AllocateBuffer(is_bool ? bitmap_size : num_rows * widths_[i], pool_));
+      if (validity_offset_ >= 0) {
+        ARROW_ASSIGN_OR_RAISE(validity[i], AllocateBuffer(bitmap_size, pool_));
+        valid[i] = 0;
+      }
+    }
+
+    // kBlockRows is a multiple of 8, so the bits of each block start on a byte boundary
+    for (int64_t start = 0; start < num_rows; start += kBlockRows) {
+      int64_t length = num_rows - start < kBlockRows ? num_rows - start : kBlockRows;
+      const uint8_t* block = rows + start * row_size_;
+      for (int i = 0; i < num_fields; i++) {
+        const uint8_t* field = block + offsets_[i];
+        if (schema_->field(i)->type()->id() == Type::BOOL) {
+          PackBits(field, 0xFF, length, values[i]->mutable_data() + start / 8);
+        } else {
+          Gather(field, widths_[i], length, values[i]->mutable_data() + start * widths_[i]);
+        }
+        if (validity_offset_ >= 0) {
+          valid[i] += PackBits(block + validity_offset_ + i / 8, static_cast<uint8_t>(1 << (i % 8)),
+                               length, validity[i]->mutable_data() + start / 8);
+        }
+      }
+    }
+
+    columns->resize(num_fields);
+    for (int i = 0; i < num_fields; i++) {
+      int64_t null_count = num_rows - valid[i];
+      (*columns)[i] = ArrayData::Make(schema_->field(i)->type(), num_rows,
+                                      {null_count > 0 ? validity[i] : NULLPTR, values[i]},
+                                      null_count);
+    }
+    return Status::OK();
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::vector<int64_t> widths_;
+  std::vector<int64_t> offsets_;
+  int64_t row_size_;
+  int64_t validity_offset_;
+  MemoryPool* pool_;
+};
+
+}  // namespace arrow
@@ -0,0 +1,15 @@
+import org.bytedeco.javacpp.*;
+import org.bytedeco.cpu_features.*;
+import static org.bytedeco.cpu_features.global.cpu_features.*;
+
+public class DispatchExample {
+
+    public static void main(String args[]) {
+        for (int target = DISPATCH_BASELINE; target < DISPATCH_LAST_; target++) {
+            System.out.println(GetDispatchTargetName(target).getString() + " supported by host: "
+                    + (IsDispatchTargetSupported(target) != 0));
+        }
+        System.out.println("Kernels compiled with cpu_features_dispatch.h run on: "
+                + GetDispatchTargetName(GetDispatchTarget()).getString());
+    }
+}
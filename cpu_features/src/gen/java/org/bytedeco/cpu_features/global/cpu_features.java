@@ -1019,4 +1019,103 @@ public static final int
 // #endif  // CPU_FEATURES_INCLUDE_CPUINFO_X86_H_
 
 
+// Parsed from cpu_features_dispatch.h
+
+// Runtime dispatch of kernels compiled for several instruction sets
+//
+// A kernel header that includes itself once per target, between
+// CPU_FEATURES_DISPATCH_BEGIN_<TARGET> and CPU_FEATURES_DISPATCH_END, with a
+// macro appending the suffix of the target to the names of its functions, gets
+// one variant for each target the compiler can generate code for function by
+// function, in addition to the baseline built with the flags of the
+// translation unit. GetDispatchTarget() detects once the best target supported
+// by both the host and the compiler, and CPU_FEATURES_DISPATCH_SELECT() picks
+// the matching variant, typically to initialize a function pointer at load:
+//
+//   #define KERNEL(name) name##_baseline
+//   #include "kernels.h"
+//   #undef KERNEL
+//   #ifdef CPU_FEATURES_DISPATCH_HAVE_AVX2
+//   #define KERNEL(name) name##_avx2
+//   CPU_FEATURES_DISPATCH_BEGIN_AVX2
+//   #include "kernels.h"
+//   CPU_FEATURES_DISPATCH_END
+//   #undef KERNEL
+//   #endif
+//   // the same for AVX512
+//   static void (*const kernel)(float*, int) =
+//       CPU_FEATURES_DISPATCH_SELECT(kernel, GetDispatchTarget());
+//
+// On ARM, the baseline gets reported as NEON when the translation unit is
+// compiled with NEON. MSVC cannot change the target of a function, so only the
+// baseline is available there. Setting the CPU_FEATURES_DISPATCH environment
+// variable to the name of a target caps the target selected, for example, to
+// compare the variants or to work around a bug.
+
+// #ifndef CPU_FEATURES_INCLUDE_CPU_FEATURES_DISPATCH_H_
+// #define CPU_FEATURES_INCLUDE_CPU_FEATURES_DISPATCH_H_
+
+// #include <stdlib.h>
+// #include <string.h>
+
+// #include "cpu_features/cpu_features_macros.h"
+// #if defined(CPU_FEATURES_ARCH_X86)
+// #include "cpu_features/cpuinfo_x86.h"
+// #elif defined(CPU_FEATURES_ARCH_AARCH64)
+// #include "cpu_features/cpuinfo_aarch64.h"
+// #elif defined(CPU_FEATURES_ARCH_ARM)
+// #include "cpu_features/cpuinfo_arm.h"
+// #endif
+
+// The targets are those of dispatch_targets.h, shared with other presets.
+// #include "dispatch_targets.h"
+// #if defined(CPU_FEATURES_ARCH_X86) && defined(BYTEDECO_DISPATCH_HAVE_AVX2)
+// #endif
+
+// #if defined(CPU_FEATURES_ARCH_ANY_ARM) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+// #endif
+
+/** enum cpu_features::DispatchTarget */
+public static final int
+  DISPATCH_BASELINE = 0,  // Flags of the translation unit
+  DISPATCH_AVX2 = 1,      // AVX, AVX2 and FMA
+  DISPATCH_AVX512 = 2,    // AVX2 with AVX-512 F, CD, BW, DQ and VL
+  DISPATCH_NEON = 3,      // Advanced SIMD, the baseline compiled with NEON
+  DISPATCH_LAST_ = 4;
+
+// Returns whether the host supports the instructions of a target, whether or
+// not the compiler can generate code for it.
+@Namespace("cpu_features") public static native int IsDispatchTargetSupported(@Cast("cpu_features::DispatchTarget") int target);
+
+// Returns the best target supported by both the host and the compiler, capped
+// by the CPU_FEATURES_DISPATCH environment variable, detected on the first
+// call in C++.
+@Namespace("cpu_features") public static native @Cast("cpu_features::DispatchTarget") int GetDispatchTarget();
+
+// Returns "baseline", "avx2", "avx512", or "neon".
+@Namespace("cpu_features") public static native @Cast("const char*") BytePointer GetDispatchTargetName(@Cast("cpu_features::DispatchTarget") int target);
+// #ifdef __cplusplus
+// #else
+// #endif
+// #ifdef CPU_FEATURES_DISPATCH_HAVE_AVX512
+// #define CPU_FEATURES_DISPATCH_SELECT_AVX512_(name, target)
+//   (target) == CPU_FEATURES_DISPATCH_NS_ DISPATCH_AVX512 ? name##_avx512 :
+// #else
+// #define CPU_FEATURES_DISPATCH_SELECT_AVX512_(name, target)
+// #endif
+// #ifdef CPU_FEATURES_DISPATCH_HAVE_AVX2
+// #define CPU_FEATURES_DISPATCH_SELECT_AVX2_(name, target)
+//   (target) == CPU_FEATURES_DISPATCH_NS_ DISPATCH_AVX2 ? name##_avx2 :
+// #else
+// #define CPU_FEATURES_DISPATCH_SELECT_AVX2_(name, target)
+// #endif
+
+// Evaluates to name##_avx512, name##_avx2, or name##_baseline, for the target.
+// #define CPU_FEATURES_DISPATCH_SELECT(name, target)
+//   (CPU_FEATURES_DISPATCH_SELECT_AVX512_(name, target)
+//        CPU_FEATURES_DISPATCH_SELECT_AVX2_(name, target) name##_baseline)
+
+// #endif  // CPU_FEATURES_INCLUDE_CPU_FEATURES_DISPATCH_H_
+
+
 }
@@ -48,6 +48,7 @@ import org.bytedeco.javacpp.tools.InfoMapper;
                 "cpu_features/cpuinfo_mips.h",
                 "cpu_features/cpuinfo_ppc.h",
                 "cpu_features/cpuinfo_x86.h",
+                "cpu_features_dispatch.h",
             },
             link = "cpu_features",
             resource = {"include", "lib"}
@@ -79,6 +80,10 @@ public class cpu_features implements InfoMapper {
                .put(new Info("cpu_features::CpuFeatures_GetHardwareCapabilities",
                              "cpu_features::CpuFeatures_IsHwCapsSet",
                              "cpu_features::CpuFeatures_GetPlatformPointer",
-                             "cpu_features::CpuFeatures_GetBasePlatformPointer").annotations("@Platform(not=\"windows\")"));
+                             "cpu_features::CpuFeatures_GetBasePlatformPointer").annotations("@Platform(not=\"windows\")"))
+               .put(new Info("cpu_features_dispatch.h").linePatterns("^#ifndef CPU_FEATURES_DISPATCH_PRIVATE_H_$", "^#endif  // CPU_FEATURES_DISPATCH_PRIVATE_H_$").skip())
+               .put(new Info("CPU_FEATURES_DISPATCH_HAVE_AVX2", "CPU_FEATURES_DISPATCH_HAVE_AVX512", "CPU_FEATURES_DISPATCH_HAVE_NEON",
+                             "CPU_FEATURES_DISPATCH_BEGIN_AVX2", "CPU_FEATURES_DISPATCH_BEGIN_AVX512", "CPU_FEATURES_DISPATCH_END",
+                             "CPU_FEATURES_DISPATCH_NS_").skip());
     }
 }
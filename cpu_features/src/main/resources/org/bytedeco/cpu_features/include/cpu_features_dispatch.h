@@ -0,0 +1,176 @@
+// Runtime dispatch of kernels compiled for several instruction sets
+//
+// A kernel header that includes itself once per target, between
+// CPU_FEATURES_DISPATCH_BEGIN_<TARGET> and CPU_FEATURES_DISPATCH_END, with a
+// macro appending the suffix of the target to the names of its functions, gets
+// one variant for each target the compiler can generate code for function by
+// function, in addition to the baseline built with the flags of the
+// translation unit. GetDispatchTarget() detects once the best target supported
+// by both the host and the compiler, and CPU_FEATURES_DISPATCH_SELECT() picks
+// the matching variant, typically to initialize a function pointer at load:
+//
+//   #define KERNEL(name) name##_baseline
+//   #include "kernels.h"
+//   #undef KERNEL
+//   #ifdef CPU_FEATURES_DISPATCH_HAVE_AVX2
+//   #define KERNEL(name) name##_avx2
+//   CPU_FEATURES_DISPATCH_BEGIN_AVX2
+//   #include "kernels.h"
+//   CPU_FEATURES_DISPATCH_END
+//   #undef KERNEL
+//   #endif
+//   // the same for AVX512
+//   static void (*const kernel)(float*, int) =
+//       CPU_FEATURES_DISPATCH_SELECT(kernel, GetDispatchTarget());
+//
+// On ARM, the baseline gets reported as NEON when the translation unit is
+// compiled with NEON. MSVC cannot change the target of a function, so only the
+// baseline is available there. Setting the CPU_FEATURES_DISPATCH environment
+// variable to the name of a target caps the target selected, for example, to
+// compare the variants or to work around a bug.
+
+#ifndef CPU_FEATURES_INCLUDE_CPU_FEATURES_DISPATCH_H_
+#define CPU_FEATURES_INCLUDE_CPU_FEATURES_DISPATCH_H_
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "cpu_features/cpu_features_macros.h"
+#if defined(CPU_FEATURES_ARCH_X86)
+#include "cpu_features/cpuinfo_x86.h"
+#elif defined(CPU_FEATURES_ARCH_AARCH64)
+#include "cpu_features/cpuinfo_aarch64.h"
+#elif defined(CPU_FEATURES_ARCH_ARM)
+#include "cpu_features/cpuinfo_arm.h"
+#endif
+
+// The targets are those of dispatch_targets.h, shared with other presets.
+#include "dispatch_targets.h"
+#if defined(CPU_FEATURES_ARCH_X86) && defined(BYTEDECO_DISPATCH_HAVE_AVX2)
+#define CPU_FEATURES_DISPATCH_HAVE_AVX2 1
+#define CPU_FEATURES_DISPATCH_HAVE_AVX512 1
+#define CPU_FEATURES_DISPATCH_BEGIN_AVX2 BYTEDECO_DISPATCH_BEGIN_AVX2
+#define CPU_FEATURES_DISPATCH_BEGIN_AVX512 BYTEDECO_DISPATCH_BEGIN_AVX512
+#define CPU_FEATURES_DISPATCH_END BYTEDECO_DISPATCH_END
+#endif
+
+#if defined(CPU_FEATURES_ARCH_ANY_ARM) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define CPU_FEATURES_DISPATCH_HAVE_NEON 1
+#endif
+
+CPU_FEATURES_START_CPP_NAMESPACE
+
+typedef enum {
+  DISPATCH_BASELINE,  // Flags of the translation unit
+  DISPATCH_AVX2,      // AVX, AVX2 and FMA
+  DISPATCH_AVX512,    // AVX2 with AVX-512 F, CD, BW, DQ and VL
+  DISPATCH_NEON,      // Advanced SIMD, the baseline compiled with NEON
+  DISPATCH_LAST_,
+} DispatchTarget;
+
+// Returns whether the host supports the instructions of a target, whether or
+// not the compiler can generate code for it.
+static inline int IsDispatchTargetSupported(DispatchTarget target) {
+  switch (target) {
+    case DISPATCH_BASELINE:
+      return 1;
+#if defined(CPU_FEATURES_ARCH_X86)
+    case DISPATCH_AVX2: {
+      const X86Features f = GetX86Info().features;
+      return f.avx && f.avx2 && f.fma3;
+    }
+    case DISPATCH_AVX512: {
+      const X86Features f = GetX86Info().features;
+      return f.avx && f.avx2 && f.fma3 && f.avx512f && f.avx512cd &&
+             f.avx512bw && f.avx512dq && f.avx512vl;
+    }
+#elif defined(CPU_FEATURES_ARCH_AARCH64)
+    case DISPATCH_NEON:
+      return GetAarch64Info().features.asimd;
+#elif defined(CPU_FEATURES_ARCH_ARM)
+    case DISPATCH_NEON:
+      return GetArmInfo().features.neon;
+#endif
+    default:
+      return 0;
+  }
+}
+
+#ifndef CPU_FEATURES_DISPATCH_PRIVATE_H_
+#define CPU_FEATURES_DISPATCH_PRIVATE_H_
+
+static const char* const kDispatchTargetNames_[DISPATCH_LAST_] = {
+    "baseline", "avx2", "avx512", "neon"};
+
+static inline DispatchTarget DetectDispatchTarget_(void) {
+  DispatchTarget target = DISPATCH_BASELINE;
+#if defined(CPU_FEATURES_DISPATCH_HAVE_AVX512)
+  if (IsDispatchTargetSupported(DISPATCH_AVX512)) target = DISPATCH_AVX512;
+#endif
+#if defined(CPU_FEATURES_DISPATCH_HAVE_AVX2)
+  if (target == DISPATCH_BASELINE && IsDispatchTargetSupported(DISPATCH_AVX2))
+    target = DISPATCH_AVX2;
+#endif
+#if defined(CPU_FEATURES_DISPATCH_HAVE_NEON)
+  if (IsDispatchTargetSupported(DISPATCH_NEON)) target = DISPATCH_NEON;
+#endif
+  const char* cap = getenv("CPU_FEATURES_DISPATCH");
+  if (cap != NULL) {
+    for (int i = 0; i < (int)target; i++) {
+      if (strcmp(cap, kDispatchTargetNames_[i]) == 0) {
+        // NEON is also the baseline, so there is nothing between them
+        target = target == DISPATCH_NEON ? DISPATCH_BASELINE : (DispatchTarget)i;
+        break;
+      }
+    }
+  }
+  return target;
+}
+
+#endif  // CPU_FEATURES_DISPATCH_PRIVATE_H_
+
+// Returns the best target supported by both the host and the compiler, capped
+// by the CPU_FEATURES_DISPATCH environment variable, detected on the first
+// call in C++.
+static inline DispatchTarget GetDispatchTarget(void) {
+#ifdef __cplusplus
+  static const DispatchTarget target = DetectDispatchTarget_();
+  return target;
+#else
+  return DetectDispatchTarget_();
+#endif
+}
+
+// Returns "baseline", "avx2", "avx512", or "neon".
+static inline const char* GetDispatchTargetName(DispatchTarget target) {
+  return target >= DISPATCH_BASELINE && target < DISPATCH_LAST_
+             ? kDispatchTargetNames_[target]
+             : "unknown";
+}
+
+CPU_FEATURES_END_CPP_NAMESPACE
+
+#ifdef __cplusplus
+#define CPU_FEATURES_DISPATCH_NS_ cpu_features::
+#else
+#define CPU_FEATURES_DISPATCH_NS_
+#endif
+#ifdef CPU_FEATURES_DISPATCH_HAVE_AVX512
+#define CPU_FEATURES_DISPATCH_SELECT_AVX512_(name, target) \
+  (target) == CPU_FEATURES_DISPATCH_NS_ DISPATCH_AVX512 ? name##_avx512 :
+#else
+#define CPU_FEATURES_DISPATCH_SELECT_AVX512_(name, target)
+#endif
+#ifdef CPU_FEATURES_DISPATCH_HAVE_AVX2
+#define CPU_FEATURES_DISPATCH_SELECT_AVX2_(name, target) \
+  (target) == CPU_FEATURES_DISPATCH_NS_ DISPATCH_AVX2 ? name##_avx2 :
+#else
+#define CPU_FEATURES_DISPATCH_SELECT_AVX2_(name, target)
+#endif
+
+// Evaluates to name##_avx512, name##_avx2, or name##_baseline, for the target.
+#define CPU_FEATURES_DISPATCH_SELECT(name, target)    \
+  (CPU_FEATURES_DISPATCH_SELECT_AVX512_(name, target) \
+       CPU_FEATURES_DISPATCH_SELECT_AVX2_(name, target) name##_baseline)
+
+#endif  // CPU_FEATURES_INCLUDE_CPU_FEATURES_DISPATCH_H_
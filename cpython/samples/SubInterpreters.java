@@ -0,0 +1,85 @@
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.cpython.*;
+import static org.bytedeco.cpython.global.python.*;
+
+/**
+ * Runs Python code from many Java threads at once in a pool of sub-interpreters,
+ * prewarmed with imports, each thread handing its own direct buffer without copy.
+ * With Python 3.12 or newer, each interpreter has its own GIL, but NumPy cannot
+ * be imported then, so the buffers are processed as plain memoryview objects.
+ *
+ * Usage: SubInterpreters [threads] [interpreters] [iterations]
+ */
+public class SubInterpreters {
+    static final String WARMUP = "try:\n"
+                               + "    import numpy as np\n"
+                               + "except ImportError:\n"
+                               + "    np = None\n";
+
+    static final String WORK = "if np is not None:\n"
+                             + "    np.asarray(data)[...] *= 2\n"
+                             + "else:\n"
+                             + "    flat = data.cast('B').cast('f')\n"
+                             + "    for i in range(len(flat)):\n"
+                             + "        flat[i] *= 2\n"
+                             + "    del flat\n";
+
+    public static void main(String[] args) throws Exception {
+        final int threads = args.length > 0 ? Integer.parseInt(args[0]) : Runtime.getRuntime().availableProcessors();
+        final int interpreters = args.length > 1 ? Integer.parseInt(args[1]) : threads;
+        final int iterations = args.length > 2 ? Integer.parseInt(args[2]) : 100;
+        final long[] dims = {64, 64};
+
+        Py_Initialize(cachePackages());
+        final PyInterpreterPool pool = PyInterpreterPool_New(interpreters, 1, WARMUP);
+        if (pool == null) {
+            System.err.println("Fatal error: cannot create interpreters");
+            System.exit(1);
+        }
+        System.out.println(PyInterpreterPool_Size(pool) + " interpreters with "
+                + (PyInterpreterPool_HasOwnGIL(pool) != 0 ? "their own GIL" : "a shared GIL"));
+
+        // let the other threads enter the interpreters
+        PyThreadState main = PyEval_SaveThread();
+        Thread[] list = new Thread[threads];
+        final boolean[] failed = new boolean[1];
+        for (int t = 0; t < threads; t++) {
+            list[t] = new Thread() {
+                @Override public void run() {
+                    ByteBuffer bytes = ByteBuffer.allocateDirect((int)(dims[0] * dims[1] * 4)).order(ByteOrder.nativeOrder());
+                    FloatBuffer floats = bytes.asFloatBuffer();
+                    Pointer data = new Pointer(bytes);
+                    SizeTPointer shape = new SizeTPointer(dims);
+                    for (int i = 0; i < iterations; i++) {
+                        floats.put(0, i);
+                        // sets data and runs the code at once, as another thread may share the interpreter
+                        if (PyInterpreterPool_RunWithBuffer(pool, -1, "data", data, bytes.capacity(), "f",
+                                                            dims.length, shape, 0, WORK) < 0 || floats.get(0) != 2 * i) {
+                            failed[0] = true;
+                            break;
+                        }
+                    }
+                    PyInterpreterPool_Release(pool);
+                }
+            };
+        }
+        long start = System.nanoTime();
+        for (Thread t : list) {
+            t.start();
+        }
+        for (Thread t : list) {
+            t.join();
+        }
+        double seconds = (System.nanoTime() - start) / 1e9;
+        System.out.printf("%d threads ran %d calls each in %.3f s (%.0f calls/s)%s%n", threads, iterations,
+                seconds, threads * iterations / seconds, failed[0] ? ", but some failed" : "");
+
+        PyEval_RestoreThread(main);
+        PyInterpreterPool_Destroy(pool);
+        if (Py_FinalizeEx() < 0) {
+            System.exit(120);
+        }
+        System.exit(failed[0] ? 1 : 0);
+    }
+}
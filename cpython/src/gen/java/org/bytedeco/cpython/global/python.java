@@ -14370,4 +14370,113 @@ public static native PyDateTime_CAPI PyDateTimeAPI(); public static native void
 // #endif /* !Py_LIMITED_API */
 
 
+// Parsed from interpreterpool.h
+
+/* Pool of sub-interpreters for calls from many native threads
+
+   A PyInterpreterPool owns sub-interpreters created, and optionally
+   prewarmed with imports, once from the main interpreter. Any thread can then
+   enter one of them to call the C API: each thread gets its own thread state
+   for each interpreter it enters, and sticks to the same interpreter unless it
+   asks for another one, so the modules it imported and the globals it set are
+   still there on the next call.
+
+   With Python 3.12 or newer, interpreters created with own_gil each have their
+   own GIL, so threads in different interpreters run in parallel. Extension
+   modules that do not support it, like NumPy, refuse to import in them
+   though. Otherwise, the interpreters share the GIL of the main interpreter,
+   which still isolates the modules and globals of each, but serializes them.
+
+   Buffers, for example, of direct NIO buffers, can be handed to an
+   interpreter without copy as memoryview objects, cast to a format and shape,
+   for numpy.asarray() or any other consumer of the buffer protocol. The
+   memory must outlive the objects referencing it. */
+
+// #ifndef Py_INTERPRETERPOOL_H
+// #define Py_INTERPRETERPOOL_H
+// #ifdef __cplusplus
+// #endif
+
+// #include "Python.h"
+// Targeting ../PyInterpreterPool.java
+
+
+
+/* Creates size interpreters, running warmup, if not NULL, in the __main__ module
+   of each, for example, "import json, numpy". Must be called with the GIL of the
+   main interpreter held, which is still held when it returns. Returns NULL on
+   failure, with the error printed. */
+@NoException public static native PyInterpreterPool PyInterpreterPool_New(int size, int own_gil, @Cast("const char*") BytePointer warmup);
+@NoException public static native PyInterpreterPool PyInterpreterPool_New(int size, int own_gil, String warmup);
+
+/* Returns the number of interpreters */
+@NoException public static native int PyInterpreterPool_Size(PyInterpreterPool pool);
+
+/* Returns 1 if each interpreter has its own GIL, or 0 if they share the one of the main interpreter */
+@NoException public static native int PyInterpreterPool_HasOwnGIL(PyInterpreterPool pool);
+
+/* Makes the calling thread, which must not hold any GIL, enter the interpreter
+   at index, or when negative, the one it entered last, or else the one with the
+   fewest threads, and acquires its GIL. Returns the index of the interpreter,
+   or -1 on failure. */
+@NoException public static native int PyInterpreterPool_Enter(PyInterpreterPool pool, int index);
+
+/* Releases the GIL of the interpreter the calling thread entered */
+@NoException public static native void PyInterpreterPool_Exit(PyInterpreterPool pool);
+
+/* Deletes the thread states of the calling thread, which must not hold any GIL,
+   for example, before it ends. Entering again creates new ones. */
+@NoException public static native void PyInterpreterPool_Release(PyInterpreterPool pool);
+
+/* Runs code in the __main__ module of the interpreter at index, or chosen as with
+   PyInterpreterPool_Enter(), from a thread that must not hold any GIL. Returns 0
+   on success, or -1 if an exception was raised, after printing it. */
+@NoException public static native int PyInterpreterPool_RunString(PyInterpreterPool pool, int index, @Cast("const char*") BytePointer code);
+@NoException public static native int PyInterpreterPool_RunString(PyInterpreterPool pool, int index, String code);
+
+/* Returns a new memoryview of size bytes at data, cast to the format, for
+   example, "f" for float, and shape of ndim dimensions, unless ndim is 0, or
+   NULL with an exception set. Must be called with the GIL of an interpreter held. */
+@NoException public static native PyObject PyInterpreterPool_WrapBuffer(Pointer data, @Cast("Py_ssize_t") long size, @Cast("const char*") BytePointer format,
+                             int ndim, @Cast("const Py_ssize_t*") SizeTPointer shape, int readonly);
+@NoException public static native PyObject PyInterpreterPool_WrapBuffer(Pointer data, @Cast("Py_ssize_t") long size, String format,
+                             int ndim, @Cast("const Py_ssize_t*") SizeTPointer shape, int readonly);
+
+/* Sets the global name of the __main__ module, as with
+   PyInterpreterPool_SetBuffer(), runs code, unless NULL, and deletes the global
+   again if the code did not, all without releasing the GIL of the interpreter,
+   so that no other thread can see or replace the buffer. Returns 0 on success,
+   or -1 on failure, after printing the exception. */
+@NoException public static native int PyInterpreterPool_RunWithBuffer(PyInterpreterPool pool, int index, @Cast("const char*") BytePointer name,
+                                Pointer data, @Cast("Py_ssize_t") long size, @Cast("const char*") BytePointer format,
+                                int ndim, @Cast("const Py_ssize_t*") SizeTPointer shape, int readonly,
+                                @Cast("const char*") BytePointer code);
+@NoException public static native int PyInterpreterPool_RunWithBuffer(PyInterpreterPool pool, int index, String name,
+                                Pointer data, @Cast("Py_ssize_t") long size, String format,
+                                int ndim, @Cast("const Py_ssize_t*") SizeTPointer shape, int readonly,
+                                String code);
+
+/* Sets the global name of the __main__ module of the interpreter at index, or
+   chosen as with PyInterpreterPool_Enter(), to a memoryview of the buffer, as
+   with PyInterpreterPool_WrapBuffer(), from a thread that must not hold any
+   GIL. Returns 0 on success, or -1 on failure, after printing the exception.
+   Other threads entering the same interpreter can replace the global before
+   the next call, so PyInterpreterPool_RunWithBuffer() should be used instead
+   to run code with it when there are more threads than interpreters. */
+@NoException public static native int PyInterpreterPool_SetBuffer(PyInterpreterPool pool, int index, @Cast("const char*") BytePointer name,
+                            Pointer data, @Cast("Py_ssize_t") long size, @Cast("const char*") BytePointer format,
+                            int ndim, @Cast("const Py_ssize_t*") SizeTPointer shape, int readonly);
+@NoException public static native int PyInterpreterPool_SetBuffer(PyInterpreterPool pool, int index, String name,
+                            Pointer data, @Cast("Py_ssize_t") long size, String format,
+                            int ndim, @Cast("const Py_ssize_t*") SizeTPointer shape, int readonly);
+
+/* Ends all the interpreters, which no thread may hold the GIL of anymore, from
+   the thread that created the pool, with the GIL of the main interpreter held */
+@NoException public static native void PyInterpreterPool_Destroy(PyInterpreterPool pool);
+
+// #ifdef __cplusplus
+// #endif
+// #endif /* !Py_INTERPRETERPOOL_H */
+
+
 }
@@ -165,6 +165,7 @@ import org.bytedeco.javacpp.tools.InfoMapper;
                 "tracemalloc.h",
 
                 "datetime.h",
+                "interpreterpool.h",
             },
             exclude = {
                 "cpython/pymem.h",
@@ -270,6 +271,8 @@ public class python implements InfoMapper {
     public void map(InfoMap infoMap) {
         infoMap.put(new Info("Python-ast.h").linePatterns("#define Module.*",
                                                           "int PyAST_Check.*").skip())
+               .put(new Info("interpreterpool.h").linePatterns("#ifndef Py_INTERPRETERPOOL_PRIVATE_H",
+                                                               "#endif /\\* Py_INTERPRETERPOOL_PRIVATE_H \\*/").skip())
 
                .put(new Info("COMPILER", "TIMEMODULE_LIB", "NTDDI_VERSION", "Py_NTDDI", "Py_IS_NAN",
                              "copysign", "hypot", "timezone", "daylight", "tzname",
@@ -0,0 +1,388 @@
+/* Pool of sub-interpreters for calls from many native threads
+
+   A PyInterpreterPool owns sub-interpreters created, and optionally
+   prewarmed with imports, once from the main interpreter. Any thread can then
+   enter one of them to call the C API: each thread gets its own thread state
+   for each interpreter it enters, and sticks to the same interpreter unless it
+   asks for another one, so the modules it imported and the globals it set are
+   still there on the next call.
+
+   With Python 3.12 or newer, interpreters created with own_gil each have their
+   own GIL, so threads in different interpreters run in parallel. Extension
+   modules that do not support it, like NumPy, refuse to import in them
+   though. Otherwise, the interpreters share the GIL of the main interpreter,
+   which still isolates the modules and globals of each, but serializes them.
+
+   Buffers, for example, of direct NIO buffers, can be handed to an
+   interpreter without copy as memoryview objects, cast to a format and shape,
+   for numpy.asarray() or any other consumer of the buffer protocol. The
+   memory must outlive the objects referencing it. */
+
+#ifndef Py_INTERPRETERPOOL_H
+#define Py_INTERPRETERPOOL_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "Python.h"
+
+typedef struct PyInterpreterPool PyInterpreterPool;
+
+#ifndef Py_INTERPRETERPOOL_PRIVATE_H
+#define Py_INTERPRETERPOOL_PRIVATE_H
+
+/* Thread state of a thread for one of the interpreters */
+typedef struct {
+    unsigned long thread;
+    int index;
+    PyThreadState *tstate;
+} _PyInterpreterPool_Entry;
+
+struct PyInterpreterPool {
+    int size;
+    int own_gil;
+    PyThreadState **tstates;        /* thread states of the creating thread */
+    int *threads;                   /* number of threads sticking to each interpreter */
+    PyThread_type_lock lock;        /* protects the entries */
+    _PyInterpreterPool_Entry *entries;
+    Py_ssize_t num_entries, max_entries;
+};
+
+/* Ends the first n interpreters, with the GIL of the main interpreter held by main */
+static inline void
+_PyInterpreterPool_End(PyInterpreterPool *pool, int n, PyThreadState *main)
+{
+    for (int i = 0; i < n; i++) {
+        if (pool->own_gil) {
+            PyEval_SaveThread();
+            PyEval_RestoreThread(pool->tstates[i]);
+        }
+        else {
+            PyThreadState_Swap(pool->tstates[i]);
+        }
+        /* Py_EndInterpreter() wants the thread state of the caller to be the last one */
+        for (Py_ssize_t j = 0; j < pool->num_entries; j++) {
+            if (pool->entries[j].index == i) {
+                PyThreadState_Clear(pool->entries[j].tstate);
+                PyThreadState_Delete(pool->entries[j].tstate);
+            }
+        }
+        Py_EndInterpreter(pool->tstates[i]);
+        if (pool->own_gil) {
+            PyEval_RestoreThread(main);
+        }
+        else {
+            PyThreadState_Swap(main);
+        }
+    }
+}
+
+#endif /* Py_INTERPRETERPOOL_PRIVATE_H */
+
+/* Creates size interpreters, running warmup, if not NULL, in the __main__ module
+   of each, for example, "import json, numpy". Must be called with the GIL of the
+   main interpreter held, which is still held when it returns. Returns NULL on
+   failure, with the error printed. */
+static inline PyInterpreterPool *
+PyInterpreterPool_New(int size, int own_gil, const char *warmup)
+{
+    PyThreadState *main = PyThreadState_Get();
+    PyInterpreterPool *pool = (PyInterpreterPool *)PyMem_RawCalloc(1, sizeof(PyInterpreterPool));
+    if (pool == NULL) {
+        return NULL;
+    }
+#if PY_VERSION_HEX >= 0x030C0000
+    pool->own_gil = own_gil != 0;
+#else
+    (void)own_gil;
+    pool->own_gil = 0;
+#endif
+    pool->tstates = (PyThreadState **)PyMem_RawCalloc(size > 0 ? size : 1, sizeof(PyThreadState *));
+    pool->threads = (int *)PyMem_RawCalloc(size > 0 ? size : 1, sizeof(int));
+    pool->lock = PyThread_allocate_lock();
+    if (pool->tstates == NULL || pool->threads == NULL || pool->lock == NULL) {
+        goto error;
+    }
+
+    for (int i = 0; i < size; i++) {
+        PyThreadState *tstate = NULL;
+#if PY_VERSION_HEX >= 0x030C0000
+        if (pool->own_gil) {
+            /* the isolated configuration of _PyInterpreterConfig_INIT, also valid in C++ */
+            PyInterpreterConfig config;
+            memset(&config, 0, sizeof(config));
+            config.allow_threads = 1;
+            config.check_multi_interp_extensions = 1;
+            config.gil = PyInterpreterConfig_OWN_GIL;
+            PyStatus status = Py_NewInterpreterFromConfig(&tstate, &config);
+            if (PyStatus_Exception(status)) {
+                tstate = NULL;
+            }
+        }
+        else
+#endif
+        {
+            tstate = Py_NewInterpreter();
+        }
+        if (tstate == NULL) {
+            /* the thread state of the main interpreter is current again */
+            _PyInterpreterPool_End(pool, i, main);
+            goto error;
+        }
+        pool->tstates[i] = tstate;
+        pool->size = i + 1;
+
+        int failed = warmup != NULL && PyRun_SimpleString(warmup) != 0;
+        if (pool->own_gil) {
+            PyEval_SaveThread();
+            PyEval_RestoreThread(main);
+        }
+        else {
+            PyThreadState_Swap(main);
+        }
+        if (failed) {
+            _PyInterpreterPool_End(pool, i + 1, main);
+            goto error;
+        }
+    }
+    return pool;
+
+error:
+    if (pool->lock != NULL) {
+        PyThread_free_lock(pool->lock);
+    }
+    PyMem_RawFree(pool->tstates);
+    PyMem_RawFree(pool->threads);
+    PyMem_RawFree(pool);
+    return NULL;
+}
+
+/* Returns the number of interpreters */
+static inline int
+PyInterpreterPool_Size(PyInterpreterPool *pool)
+{
+    return pool->size;
+}
+
+/* Returns 1 if each interpreter has its own GIL, or 0 if they share the one of the main interpreter */
+static inline int
+PyInterpreterPool_HasOwnGIL(PyInterpreterPool *pool)
+{
+    return pool->own_gil;
+}
+
+/* Makes the calling thread, which must not hold any GIL, enter the interpreter
+   at index, or when negative, the one it entered last, or else the one with the
+   fewest threads, and acquires its GIL. Returns the index of the interpreter,
+   or -1 on failure. */
+static inline int
+PyInterpreterPool_Enter(PyInterpreterPool *pool, int index)
+{
+    unsigned long thread = PyThread_get_thread_ident();
+    PyThreadState *tstate = NULL;
+    if (index >= pool->size) {
+        return -1;
+    }
+    PyThread_acquire_lock(pool->lock, WAIT_LOCK);
+    Py_ssize_t last = -1;
+    for (Py_ssize_t i = 0; i < pool->num_entries; i++) {
+        if (pool->entries[i].thread == thread) {
+            if (index < 0 || pool->entries[i].index == index) {
+                last = i;
+            }
+        }
+    }
+    if (last >= 0) {
+        /* move to the end, so the last interpreter entered is found first next time */
+        _PyInterpreterPool_Entry entry = pool->entries[last];
+        memmove(&pool->entries[last], &pool->entries[last + 1], (pool->num_entries - last - 1) * sizeof(entry));
+        pool->entries[pool->num_entries - 1] = entry;
+        index = entry.index;
+        tstate = entry.tstate;
+    }
+    else {
+        if (index < 0) {
+            index = 0;
+            for (int i = 1; i < pool->size; i++) {
+                if (pool->threads[i] < pool->threads[index]) {
+                    index = i;
+                }
+            }
+        }
+        if (pool->num_entries == pool->max_entries) {
+            Py_ssize_t max_entries = pool->max_entries > 0 ? 2 * pool->max_entries : 16;
+            void *entries = PyMem_RawRealloc(pool->entries, max_entries * sizeof(_PyInterpreterPool_Entry));
+            if (entries == NULL) {
+                PyThread_release_lock(pool->lock);
+                return -1;
+            }
+            pool->entries = (_PyInterpreterPool_Entry *)entries;
+            pool->max_entries = max_entries;
+        }
+        tstate = PyThreadState_New(PyThreadState_GetInterpreter(pool->tstates[index]));
+        if (tstate == NULL) {
+            PyThread_release_lock(pool->lock);
+            return -1;
+        }
+        _PyInterpreterPool_Entry *entry = &pool->entries[pool->num_entries++];
+        entry->thread = thread;
+        entry->index = index;
+        entry->tstate = tstate;
+        pool->threads[index]++;
+    }
+    PyThread_release_lock(pool->lock);
+    PyEval_RestoreThread(tstate);
+    return index;
+}
+
+/* Releases the GIL of the interpreter the calling thread entered */
+static inline void
+PyInterpreterPool_Exit(PyInterpreterPool *pool)
+{
+    (void)pool;
+    PyEval_SaveThread();
+}
+
+/* Deletes the thread states of the calling thread, which must not hold any GIL,
+   for example, before it ends. Entering again creates new ones. */
+static inline void
+PyInterpreterPool_Release(PyInterpreterPool *pool)
+{
+    unsigned long thread = PyThread_get_thread_ident();
+    for (;;) {
+        /* never wait for a GIL with the lock held */
+        PyThreadState *tstate = NULL;
+        PyThread_acquire_lock(pool->lock, WAIT_LOCK);
+        for (Py_ssize_t i = 0; i < pool->num_entries; i++) {
+            if (pool->entries[i].thread == thread) {
+                tstate = pool->entries[i].tstate;
+                pool->threads[pool->entries[i].index]--;
+                memmove(&pool->entries[i], &pool->entries[i + 1], (pool->num_entries - i - 1) * sizeof(pool->entries[i]));
+                pool->num_entries--;
+                break;
+            }
+        }
+        PyThread_release_lock(pool->lock);
+        if (tstate == NULL) {
+            break;
+        }
+        PyEval_RestoreThread(tstate);
+        PyThreadState_Clear(tstate);
+        PyThreadState_DeleteCurrent();
+    }
+}
+
+/* Runs code in the __main__ module of the interpreter at index, or chosen as with
+   PyInterpreterPool_Enter(), from a thread that must not hold any GIL. Returns 0
+   on success, or -1 if an exception was raised, after printing it. */
+static inline int
+PyInterpreterPool_RunString(PyInterpreterPool *pool, int index, const char *code)
+{
+    if (PyInterpreterPool_Enter(pool, index) < 0) {
+        return -1;
+    }
+    int result = PyRun_SimpleString(code);
+    PyInterpreterPool_Exit(pool);
+    return result;
+}
+
+/* Returns a new memoryview of size bytes at data, cast to the format, for
+   example, "f" for float, and shape of ndim dimensions, unless ndim is 0, or
+   NULL with an exception set. Must be called with the GIL of an interpreter held. */
+static inline PyObject *
+PyInterpreterPool_WrapBuffer(void *data, Py_ssize_t size, const char *format,
+                             int ndim, const Py_ssize_t *shape, int readonly)
+{
+    PyObject *view = PyMemoryView_FromMemory((char *)data, size, readonly ? PyBUF_READ : PyBUF_WRITE);
+    if (view == NULL || ndim <= 0) {
+        return view;
+    }
+    PyObject *dims = PyTuple_New(ndim);
+    if (dims == NULL) {
+        Py_DECREF(view);
+        return NULL;
+    }
+    for (int i = 0; i < ndim; i++) {
+        PyObject *dim = PyLong_FromSsize_t(shape[i]);
+        if (dim == NULL) {
+            Py_DECREF(dims);
+            Py_DECREF(view);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(dims, i, dim);
+    }
+    PyObject *cast = PyObject_CallMethod(view, "cast", "sO", format != NULL ? format : "B", dims);
+    Py_DECREF(dims);
+    Py_DECREF(view);
+    return cast;
+}
+
+/* Sets the global name of the __main__ module, as with
+   PyInterpreterPool_SetBuffer(), runs code, unless NULL, and deletes the global
+   again if the code did not, all without releasing the GIL of the interpreter,
+   so that no other thread can see or replace the buffer. Returns 0 on success,
+   or -1 on failure, after printing the exception. */
+static inline int
+PyInterpreterPool_RunWithBuffer(PyInterpreterPool *pool, int index, const char *name,
+                                void *data, Py_ssize_t size, const char *format,
+                                int ndim, const Py_ssize_t *shape, int readonly,
+                                const char *code)
+{
+    if (PyInterpreterPool_Enter(pool, index) < 0) {
+        return -1;
+    }
+    int result = -1;
+    PyObject *module = PyImport_AddModule("__main__");
+    PyObject *view = module != NULL ? PyInterpreterPool_WrapBuffer(data, size, format, ndim, shape, readonly) : NULL;
+    if (view != NULL) {
+        result = PyObject_SetAttrString(module, name, view);
+        Py_DECREF(view);
+    }
+    if (result < 0) {
+        PyErr_Print();
+    }
+    else if (code != NULL) {
+        /* prints its own exceptions */
+        result = PyRun_SimpleString(code);
+        if (PyObject_HasAttrString(module, name) && PyObject_DelAttrString(module, name) < 0) {
+            PyErr_Print();
+            result = -1;
+        }
+    }
+    PyInterpreterPool_Exit(pool);
+    return result;
+}
+
+/* Sets the global name of the __main__ module of the interpreter at index, or
+   chosen as with PyInterpreterPool_Enter(), to a memoryview of the buffer, as
+   with PyInterpreterPool_WrapBuffer(), from a thread that must not hold any
+   GIL. Returns 0 on success, or -1 on failure, after printing the exception.
+   Other threads entering the same interpreter can replace the global before
+   the next call, so PyInterpreterPool_RunWithBuffer() should be used instead
+   to run code with it when there are more threads than interpreters. */
+static inline int
+PyInterpreterPool_SetBuffer(PyInterpreterPool *pool, int index, const char *name,
+                            void *data, Py_ssize_t size, const char *format,
+                            int ndim, const Py_ssize_t *shape, int readonly)
+{
+    return PyInterpreterPool_RunWithBuffer(pool, index, name, data, size, format,
+                                           ndim, shape, readonly, NULL);
+}
+
+/* Ends all the interpreters, which no thread may hold the GIL of anymore, from
+   the thread that created the pool, with the GIL of the main interpreter held */
+static inline void
+PyInterpreterPool_Destroy(PyInterpreterPool *pool)
+{
+    _PyInterpreterPool_End(pool, pool->size, PyThreadState_Get());
+    PyThread_free_lock(pool->lock);
+    PyMem_RawFree(pool->entries);
+    PyMem_RawFree(pool->tstates);
+    PyMem_RawFree(pool->threads);
+    PyMem_RawFree(pool);
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* !Py_INTERPRETERPOOL_H */
@@ -0,0 +1,64 @@
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.ffmpeg.avformat.*;
+import org.bytedeco.ffmpeg.avutil.*;
+import static org.bytedeco.ffmpeg.global.avutil.*;
+
+/**
+ * Decodes a video file to RGB frames with several DecodePipeline objects at
+ * the same time, and reports the total number of frames per second.
+ */
+public class DecodePipelineBenchmark {
+    public static void main(String[] args) throws Exception {
+        if (args.length < 1) {
+            System.out.println("Usage: DecodePipelineBenchmark <video file> [streams]");
+            System.exit(-1);
+        }
+        final String file = args[0];
+        final int streams = args.length > 1 ? Integer.parseInt(args[1]) : 4;
+        final long[] frames = new long[streams];
+        final long[] checksums = new long[streams];
+
+        long start = System.nanoTime();
+        List<Thread> threads = new ArrayList<Thread>();
+        for (int i = 0; i < streams; i++) {
+            final int index = i;
+            Thread thread = new Thread() {
+                @Override public void run() {
+                    DecodePipeline pipeline = new DecodePipeline();
+                    int ret = pipeline.open(file, 0, 0, AV_PIX_FMT_RGB24, 8, 1);
+                    if (ret < 0) {
+                        System.out.println("Cannot open " + file + ": error " + ret);
+                        pipeline.deallocate();
+                        return;
+                    }
+                    int size = pipeline.getFrameSize();
+                    AVFrame frame;
+                    while ((frame = pipeline.nextFrame()) != null) {
+                        // the pixels as a direct buffer, without copying
+                        ByteBuffer pixels = frame.data(0).capacity(size).asByteBuffer();
+                        checksums[index] += pixels.get(size / 2) & 0xFF;
+                        frames[index]++;
+                        pipeline.releaseFrame(frame);
+                    }
+                    if (pipeline.getError() != AVERROR_EOF) {
+                        System.out.println("Error " + pipeline.getError() + " while decoding " + file);
+                    }
+                    pipeline.stop();
+                    pipeline.deallocate();
+                }
+            };
+            thread.start();
+            threads.add(thread);
+        }
+        long total = 0;
+        for (int i = 0; i < streams; i++) {
+            threads.get(i).join();
+            total += frames[i];
+        }
+        double seconds = (System.nanoTime() - start) / 1e9;
+        System.out.printf("%d streams, %d frames in %.2f s, %.1f frames/s%n", streams, total, seconds, total / seconds);
+    }
+}
@@ -0,0 +1,93 @@
+// Targeted by JavaCPP version 1.5.9-SNAPSHOT: DO NOT EDIT THIS FILE
+
+package org.bytedeco.ffmpeg.avformat;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+import org.bytedeco.ffmpeg.avutil.*;
+import static org.bytedeco.ffmpeg.global.avutil.*;
+import org.bytedeco.ffmpeg.swresample.*;
+import static org.bytedeco.ffmpeg.global.swresample.*;
+import org.bytedeco.ffmpeg.avcodec.*;
+import static org.bytedeco.ffmpeg.global.avcodec.*;
+
+import static org.bytedeco.ffmpeg.global.avformat.*;
+
+
+/**
+ * Decodes the best video stream of a file and converts its frames to a given
+ * size and pixel format, with demuxing, decoding, and scaling each running on
+ * its own thread, connected by bounded queues. Output frames have their
+ * pixels in a single buffer, aligned on 1 byte, of getFrameSize() bytes
+ * taken from an AVBufferPool, and are recycled along with their AVFrame on
+ * releaseFrame(). To decode many streams at once, use one pipeline per stream.
+ */
+@NoOffset @Properties(inherit = org.bytedeco.ffmpeg.presets.avformat.class)
+public class DecodePipeline extends Pointer {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public DecodePipeline(Pointer p) { super(p); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public DecodePipeline(long size) { super((Pointer)null); allocateArray(size); }
+    private native void allocateArray(long size);
+    @Override public DecodePipeline position(long position) {
+        return (DecodePipeline)super.position(position);
+    }
+    @Override public DecodePipeline getPointer(long i) {
+        return new DecodePipeline((Pointer)this).offsetAddress(i);
+    }
+
+    public DecodePipeline() { super((Pointer)null); allocate(); }
+    private native void allocate();
+
+    /**
+     * Opens the file and starts the threads.
+     *
+     * @param url the file or URL to open with avformat_open_input()
+     * @param width the width of output frames, or 0 for the width of the stream
+     * @param height the height of output frames, or 0 for the height of the stream
+     * @param pixelFormat the AVPixelFormat of output frames, for example AV_PIX_FMT_RGB24
+     * @param queueSize the capacity of each queue, and so the number of frames decoded ahead
+     * @param decoderThreads the number of threads of the decoder, or 0 for automatic
+     * @return 0 on success, or a negative AVERROR code
+     */
+    public native int open(@Cast("const char*") BytePointer url, int width, int height, int pixelFormat, int queueSize, int decoderThreads);
+    public native int open(String url, int width, int height, int pixelFormat, int queueSize, int decoderThreads);
+
+    /**
+     * Waits for the next output frame, in presentation order as returned by the
+     * decoder, with its pts set to the best effort timestamp of the frame, in the
+     * time base of the stream. It must be passed back to releaseFrame().
+     *
+     * @return the frame, or NULL at the end of the stream or on error, see getError()
+     */
+    public native AVFrame nextFrame();
+
+    /** Returns a frame obtained from nextFrame() to the pool. */
+    public native void releaseFrame(AVFrame frame);
+
+    /**
+     * Stops the threads and frees everything. Frames not released yet stay valid, but
+     * must still be passed to releaseFrame() before the pipeline gets deallocated.
+     */
+    public native void stop();
+
+    /** Returns 0, AVERROR_EOF once the end of the stream has been reached, or a negative AVERROR code on failure. */
+    public native int getError();
+
+    /** Returns the index of the stream being decoded. */
+    public native int getStreamIndex();
+
+    /** Returns the AVFormatContext, for example to get metadata or the time base of the stream. */
+    public native AVFormatContext getFormatContext();
+
+    public native int getWidth();
+    public native int getHeight();
+    public native int getPixelFormat();
+
+    /** Returns the number of bytes of pixels in each output frame. */
+    public native int getFrameSize();
+}
@@ -2762,4 +2762,23 @@ public static final String LIBAVFORMAT_IDENT = LIBAVFORMAT_IDENT();
 // #endif /* AVFORMAT_VERSION_H */
 
 
+// Parsed from decode_pipeline.h
+
+/*
+ * Demuxing, decoding, and scaling of video frames on a pipeline of threads
+ */
+
+// #include <atomic>
+// #include <condition_variable>
+// #include <deque>
+// #include <mutex>
+// #include <thread>
+
+// #include <libavcodec/avcodec.h>
+// #include <libavformat/avformat.h>
+// #include <libavutil/imgutils.h>
+// #include <libswscale/swscale.h>
+// Targeting ../avformat/DecodePipeline.java
+
+
 }
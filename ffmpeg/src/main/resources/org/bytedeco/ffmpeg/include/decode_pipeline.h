@@ -0,0 +1,394 @@
+/*
+ * Demuxing, decoding, and scaling of video frames on a pipeline of threads
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/imgutils.h>
+#include <libswscale/swscale.h>
+}
+
+/**
+ * Decodes the best video stream of a file and converts its frames to a given
+ * size and pixel format, with demuxing, decoding, and scaling each running on
+ * its own thread, connected by bounded queues. Output frames have their
+ * pixels in a single buffer, aligned on 1 byte, of getFrameSize() bytes
+ * taken from an AVBufferPool, and are recycled along with their AVFrame on
+ * releaseFrame(). To decode many streams at once, use one pipeline per stream.
+ */
+class DecodePipeline {
+public:
+    DecodePipeline() : formatContext(NULL), codecContext(NULL), swsContext(NULL), bufferPool(NULL),
+            streamIndex(-1), width(0), height(0), pixelFormat(AV_PIX_FMT_NONE), frameSize(0),
+            error(0), stopped(false) { }
+    ~DecodePipeline() { stop(); }
+
+    /**
+     * Opens the file and starts the threads.
+     *
+     * @param url the file or URL to open with avformat_open_input()
+     * @param width the width of output frames, or 0 for the width of the stream
+     * @param height the height of output frames, or 0 for the height of the stream
+     * @param pixelFormat the AVPixelFormat of output frames, for example AV_PIX_FMT_RGB24
+     * @param queueSize the capacity of each queue, and so the number of frames decoded ahead
+     * @param decoderThreads the number of threads of the decoder, or 0 for automatic
+     * @return 0 on success, or a negative AVERROR code
+     */
+    int open(const char* url, int width, int height, int pixelFormat, int queueSize, int decoderThreads) {
+        stop();
+        error = 0;
+        stopped = false;
+        queueSize = queueSize > 0 ? queueSize : 1;
+        packets.reset(queueSize);
+        decoded.reset(queueSize);
+        scaled.reset(queueSize);
+        freeFrames.reset(0);
+
+        if ((formatContext = avformat_alloc_context()) == NULL) {
+            return AVERROR(ENOMEM);
+        }
+        formatContext->interrupt_callback.callback = interrupt;
+        formatContext->interrupt_callback.opaque = this;
+        int ret = avformat_open_input(&formatContext, url, NULL, NULL);
+        if (ret < 0 || (ret = avformat_find_stream_info(formatContext, NULL)) < 0) {
+            stop();
+            return ret;
+        }
+        const AVCodec* codec = NULL;
+        streamIndex = av_find_best_stream(formatContext, AVMEDIA_TYPE_VIDEO, -1, -1, &codec, 0);
+        if (streamIndex < 0) {
+            ret = streamIndex;
+            stop();
+            return ret;
+        }
+        AVStream* stream = formatContext->streams[streamIndex];
+        for (unsigned int i = 0; i < formatContext->nb_streams; i++) {
+            if ((int)i != streamIndex) {
+                formatContext->streams[i]->discard = AVDISCARD_ALL;
+            }
+        }
+        if ((codecContext = avcodec_alloc_context3(codec)) == NULL) {
+            stop();
+            return AVERROR(ENOMEM);
+        }
+        codecContext->thread_count = decoderThreads;
+        if ((ret = avcodec_parameters_to_context(codecContext, stream->codecpar)) < 0
+                || (ret = avcodec_open2(codecContext, codec, NULL)) < 0) {
+            stop();
+            return ret;
+        }
+        this->width = width > 0 ? width : codecContext->width;
+        this->height = height > 0 ? height : codecContext->height;
+        this->pixelFormat = (AVPixelFormat)pixelFormat;
+        frameSize = av_image_get_buffer_size(this->pixelFormat, this->width, this->height, 1);
+        if (frameSize < 0) {
+            ret = frameSize;
+            stop();
+            return ret;
+        }
+        if ((bufferPool = av_buffer_pool_init(frameSize, NULL)) == NULL) {
+            stop();
+            return AVERROR(ENOMEM);
+        }
+        demuxThread = std::thread(&DecodePipeline::demux, this);
+        decodeThread = std::thread(&DecodePipeline::decode, this);
+        scaleThread = std::thread(&DecodePipeline::scale, this);
+        return 0;
+    }
+
+    /**
+     * Waits for the next output frame, in presentation order as returned by the
+     * decoder, with its pts set to the best effort timestamp of the frame, in the
+     * time base of the stream. It must be passed back to releaseFrame().
+     *
+     * @return the frame, or NULL at the end of the stream or on error, see getError()
+     */
+    AVFrame* nextFrame() {
+        AVFrame* frame = NULL;
+        return scaled.pop(&frame) ? frame : NULL;
+    }
+
+    /** Returns a frame obtained from nextFrame() to the pool. */
+    void releaseFrame(AVFrame* frame) {
+        if (frame != NULL) {
+            av_frame_unref(frame);
+            if (!freeFrames.push(frame)) {
+                av_frame_free(&frame);
+            }
+        }
+    }
+
+    /**
+     * Stops the threads and frees everything. Frames not released yet stay valid, but
+     * must still be passed to releaseFrame() before the pipeline gets deallocated.
+     */
+    void stop() {
+        stopped = true;
+        packets.close();
+        decoded.close();
+        scaled.close();
+        freeFrames.close();
+        if (demuxThread.joinable()) {
+            demuxThread.join();
+        }
+        if (decodeThread.joinable()) {
+            decodeThread.join();
+        }
+        if (scaleThread.joinable()) {
+            scaleThread.join();
+        }
+        AVPacket* packet;
+        while (packets.pop(&packet)) {
+            av_packet_free(&packet);
+        }
+        AVFrame* frame;
+        while (decoded.pop(&frame)) {
+            av_frame_free(&frame);
+        }
+        while (scaled.pop(&frame)) {
+            av_frame_free(&frame);
+        }
+        while (freeFrames.pop(&frame)) {
+            av_frame_free(&frame);
+        }
+        sws_freeContext(swsContext);
+        swsContext = NULL;
+        av_buffer_pool_uninit(&bufferPool); /* frees the buffers once all frames are unreferenced */
+        avcodec_free_context(&codecContext);
+        avformat_close_input(&formatContext);
+        streamIndex = -1;
+    }
+
+    /** Returns 0, AVERROR_EOF once the end of the stream has been reached, or a negative AVERROR code on failure. */
+    int getError() { return error; }
+
+    /** Returns the index of the stream being decoded. */
+    int getStreamIndex() { return streamIndex; }
+
+    /** Returns the AVFormatContext, for example to get metadata or the time base of the stream. */
+    AVFormatContext* getFormatContext() { return formatContext; }
+
+    int getWidth() { return width; }
+    int getHeight() { return height; }
+    int getPixelFormat() { return pixelFormat; }
+
+    /** Returns the number of bytes of pixels in each output frame. */
+    int getFrameSize() { return frameSize; }
+
+private:
+    /* blocking queue of bounded capacity, or unbounded for 0, where pop() still returns remaining items after close() */
+    template<typename T> class Queue {
+    public:
+        Queue() : capacity(0), closed(false) { }
+        void reset(int capacity) {
+            std::lock_guard<std::mutex> lock(mutex);
+            this->capacity = capacity;
+            closed = false;
+        }
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!closed && capacity > 0 && (int)items.size() >= capacity) {
+                notFull.wait(lock);
+            }
+            if (closed) {
+                return false;
+            }
+            items.push_back(item);
+            notEmpty.notify_one();
+            return true;
+        }
+        bool pop(T* item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (!closed && items.empty()) {
+                notEmpty.wait(lock);
+            }
+            if (items.empty()) {
+                return false;
+            }
+            *item = items.front();
+            items.pop_front();
+            notFull.notify_one();
+            return true;
+        }
+        bool tryPop(T* item) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (items.empty()) {
+                return false;
+            }
+            *item = items.front();
+            items.pop_front();
+            notFull.notify_one();
+            return true;
+        }
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            notEmpty.notify_all();
+            notFull.notify_all();
+        }
+    private:
+        std::mutex mutex;
+        std::condition_variable notEmpty, notFull;
+        std::deque<T> items;
+        int capacity;
+        bool closed;
+    };
+
+    DecodePipeline(const DecodePipeline&);
+    DecodePipeline& operator=(const DecodePipeline&);
+
+    static int interrupt(void* opaque) {
+        return ((DecodePipeline*)opaque)->stopped;
+    }
+
+    void fail(int ret) {
+        int expected = 0;
+        error.compare_exchange_strong(expected, ret);
+        packets.close();
+        decoded.close();
+        scaled.close();
+    }
+
+    AVFrame* allocFrame() {
+        AVFrame* frame = NULL;
+        return freeFrames.tryPop(&frame) ? frame : av_frame_alloc();
+    }
+
+    void demux() {
+        for (;;) {
+            AVPacket* packet = av_packet_alloc();
+            if (packet == NULL) {
+                fail(AVERROR(ENOMEM));
+                return;
+            }
+            int ret;
+            do {
+                av_packet_unref(packet);
+                ret = av_read_frame(formatContext, packet);
+            } while (ret >= 0 && packet->stream_index != streamIndex && !stopped);
+            if (ret < 0 || stopped || !packets.push(packet)) {
+                av_packet_free(&packet);
+                if (ret != AVERROR_EOF && !stopped) {
+                    fail(ret);
+                }
+                packets.close(); /* lets the decoder drain */
+                return;
+            }
+        }
+    }
+
+    bool receiveFrames() {
+        for (;;) {
+            AVFrame* frame = allocFrame();
+            if (frame == NULL) {
+                fail(AVERROR(ENOMEM));
+                return false;
+            }
+            int ret = avcodec_receive_frame(codecContext, frame);
+            if (ret < 0) {
+                releaseFrame(frame);
+                if (ret == AVERROR(EAGAIN)) {
+                    return true;
+                } else if (ret != AVERROR_EOF) {
+                    fail(ret);
+                }
+                return false;
+            }
+            if (!decoded.push(frame)) {
+                av_frame_free(&frame);
+                return false;
+            }
+        }
+    }
+
+    void decode() {
+        AVPacket* packet;
+        while (packets.pop(&packet)) {
+            int ret;
+            while ((ret = avcodec_send_packet(codecContext, packet)) == AVERROR(EAGAIN)) {
+                if (!receiveFrames()) {
+                    av_packet_free(&packet);
+                    return;
+                }
+            }
+            av_packet_free(&packet);
+            if (ret < 0 && ret != AVERROR_INVALIDDATA) { /* skip corrupt packets like ffmpeg does */
+                fail(ret);
+                return;
+            }
+            if (!receiveFrames()) {
+                return;
+            }
+        }
+        if (!stopped && error == 0) {
+            avcodec_send_packet(codecContext, NULL);
+            receiveFrames();
+        }
+        decoded.close();
+    }
+
+    void scale() {
+        AVFrame* in;
+        while (decoded.pop(&in)) {
+            AVFrame* out = allocFrame();
+            int ret = out != NULL ? 0 : AVERROR(ENOMEM);
+            swsContext = ret < 0 ? swsContext : sws_getCachedContext(swsContext,
+                    in->width, in->height, (AVPixelFormat)in->format,
+                    width, height, pixelFormat, SWS_BILINEAR, NULL, NULL, NULL);
+            if (ret == 0 && swsContext == NULL) {
+                ret = AVERROR(EINVAL);
+            }
+            if (ret == 0 && (out->buf[0] = av_buffer_pool_get(bufferPool)) == NULL) {
+                ret = AVERROR(ENOMEM);
+            }
+            if (ret == 0) {
+                ret = av_image_fill_arrays(out->data, out->linesize, out->buf[0]->data, pixelFormat, width, height, 1);
+            }
+            if (ret >= 0) {
+                ret = sws_scale(swsContext, in->data, in->linesize, 0, in->height, out->data, out->linesize);
+            }
+            if (ret >= 0) {
+                out->width = width;
+                out->height = height;
+                out->format = pixelFormat;
+                out->pts = in->best_effort_timestamp;
+                out->pkt_dts = in->pkt_dts;
+                out->key_frame = in->key_frame;
+                out->pict_type = in->pict_type;
+            }
+            releaseFrame(in);
+            if (ret < 0) {
+                releaseFrame(out);
+                fail(ret);
+                return;
+            }
+            if (!scaled.push(out)) {
+                av_frame_free(&out);
+                return;
+            }
+        }
+        int expected = 0;
+        error.compare_exchange_strong(expected, AVERROR_EOF);
+        scaled.close();
+    }
+
+    AVFormatContext* formatContext;
+    AVCodecContext* codecContext;
+    SwsContext* swsContext;
+    AVBufferPool* bufferPool;
+    int streamIndex, width, height;
+    AVPixelFormat pixelFormat;
+    int frameSize;
+    std::atomic<int> error;
+    std::atomic<bool> stopped;
+    Queue<AVPacket*> packets;
+    Queue<AVFrame*> decoded, scaled, freeFrames;
+    std::thread demuxThread, decodeThread, scaleThread;
+};
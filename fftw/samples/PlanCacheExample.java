@@ -0,0 +1,53 @@
+import org.bytedeco.javacpp.*;
+import static org.bytedeco.fftw.global.fftw3.*;
+
+/**
+ * Transforms batches of signals of a few recurring sizes from several threads
+ * with a plan cache, reusing the wisdom saved in a file by previous runs.
+ */
+public class PlanCacheExample {
+    static final int[] SIZES = {64, 100, 128, 360, 1024};
+    static final int BATCH = 16;
+
+    public static void main(String args[]) throws Exception {
+        Loader.load(org.bytedeco.fftw.global.fftw3.class);
+        String wisdom = args.length > 0 ? args[0] : "fftw.wisdom";
+        int threads = args.length > 1 ? Integer.parseInt(args[1]) : 4;
+
+        final fftw_plan_cache cache = fftw_plan_cache_create(wisdom, (int)FFTW_MEASURE);
+
+        long start = System.nanoTime();
+        Thread[] workers = new Thread[threads];
+        for (int t = 0; t < threads; t++) {
+            workers[t] = new Thread() {
+                @Override public void run() {
+                    for (int i = 0; i < 100; i++) {
+                        int size = SIZES[i % SIZES.length];
+                        int[] n = {size};
+                        // memory from fftw_alloc_complex() is always aligned the same way
+                        DoublePointer signal = fftw_alloc_complex(size * BATCH).capacity(2 * size * BATCH);
+                        for (int j = 0; j < size * BATCH; j++) {
+                            signal.put(2 * j, Math.cos(2 * Math.PI * 5 * j / size));
+                            signal.put(2 * j + 1, 0);
+                        }
+                        if (fftw_plan_cache_execute_dft(cache, 1, n, BATCH, signal, signal, FFTW_FORWARD) < 0) {
+                            System.err.println("Could not transform signals of size " + size);
+                        }
+                        fftw_free(signal);
+                    }
+                }
+            };
+            workers[t].start();
+        }
+        for (Thread worker : workers) {
+            worker.join();
+        }
+        double seconds = (System.nanoTime() - start) / 1e9;
+
+        System.out.printf("%d plans, %d hits, %d misses in %.3f s%n", fftw_plan_cache_size(cache),
+                fftw_plan_cache_hits(cache), fftw_plan_cache_misses(cache), seconds);
+
+        // saves the wisdom for the next run
+        fftw_plan_cache_destroy(cache);
+    }
+}
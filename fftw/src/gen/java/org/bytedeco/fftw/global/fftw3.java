@@ -1748,4 +1748,132 @@ public static final int FFTW_ALLOW_PRUNING = (1 << 20);
 // #endif /* FFTW3_H */
 
 
+// Parsed from fftw3_plan_cache.h
+
+/*
+ * Thread-safe caches of FFTW plans for batches of complex DFTs.
+ *
+ * A plan cache creates plans with fftw_plan_many_dft() the first time a
+ * combination of rank, dimensions, batch size, direction, placement, and
+ * alignment of the arrays is requested, using scratch arrays so that planning
+ * with FFTW_MEASURE or FFTW_PATIENT never overwrites user data, and executes
+ * them afterwards on new arrays with fftw_execute_dft(), from any number of
+ * threads. The wisdom accumulated by the planner gets imported from a file
+ * when a cache is created, and exported back to it when it is destroyed, so
+ * that measured plans cost little to create across restarts.
+ *
+ * The same functions exist for single precision with the fftwf_ prefix.
+ */
+
+// #ifndef FFTW3_PLAN_CACHE_H
+// #define FFTW3_PLAN_CACHE_H
+
+// #include <fftw3.h>
+
+// #include <atomic>
+// #include <map>
+// #include <mutex>
+// #include <new>
+// #include <stdio.h>
+// #include <string.h>
+// #include <string>
+// #include <vector>
+
+@Name("fftw_plan_cache_s") @Opaque public static class fftw_plan_cache extends Pointer {
+    /** Empty constructor. Calls {@code super((Pointer)null)}. */
+    public fftw_plan_cache() { super((Pointer)null); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public fftw_plan_cache(Pointer p) { super(p); }
+}
+
+@Name("fftwf_plan_cache_s") @Opaque public static class fftwf_plan_cache extends Pointer {
+    /** Empty constructor. Calls {@code super((Pointer)null)}. */
+    public fftwf_plan_cache() { super((Pointer)null); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public fftwf_plan_cache(Pointer p) { super(p); }
+}
+
+
+/**
+ * Creates a plan cache, importing the wisdom found in wisdom_filename, if not NULL.
+ * The planner flags, for example FFTW_MEASURE, apply to all plans of the cache.
+ * Also makes the planner thread-safe with fftw_make_planner_thread_safe().
+ */
+public static native fftw_plan_cache fftw_plan_cache_create(@Cast("const char*") BytePointer wisdom_filename, @Cast("unsigned") int flags);
+public static native fftw_plan_cache fftw_plan_cache_create(String wisdom_filename, @Cast("unsigned") int flags);
+
+/**
+ * Exports the wisdom of the planner to the file of the cache.
+ * Returns 1 on success, and 0 on failure or if the cache has no file.
+ */
+public static native int fftw_plan_cache_save_wisdom(fftw_plan_cache cache);
+
+/**
+ * Saves the wisdom like fftw_plan_cache_save_wisdom(), and destroys the cache with all its plans.
+ */
+public static native void fftw_plan_cache_destroy(fftw_plan_cache cache);
+
+/**
+ * Returns the plan of the cache for howmany contiguous arrays of rank dimensions n,
+ * creating it if needed. It can be executed with fftw_execute_dft() on any arrays with
+ * the same placement and alignment as in and out, whose content is never modified here.
+ * Returns NULL on failure. The plan remains owned by the cache.
+ */
+public static native fftw_plan fftw_plan_cache_get_dft(fftw_plan_cache cache, int rank, @Const IntPointer n, int howmany,
+                                         @Cast("const fftw_complex*") DoublePointer in, @Cast("const fftw_complex*") DoublePointer out, int sign);
+public static native fftw_plan fftw_plan_cache_get_dft(fftw_plan_cache cache, int rank, @Const IntBuffer n, int howmany,
+                                         @Cast("const fftw_complex*") DoubleBuffer in, @Cast("const fftw_complex*") DoubleBuffer out, int sign);
+public static native fftw_plan fftw_plan_cache_get_dft(fftw_plan_cache cache, int rank, @Const int[] n, int howmany,
+                                         @Cast("const fftw_complex*") double[] in, @Cast("const fftw_complex*") double[] out, int sign);
+
+/**
+ * Executes the plan returned by fftw_plan_cache_get_dft() on the given arrays.
+ * Returns 0 on success, and -1 on failure.
+ */
+public static native int fftw_plan_cache_execute_dft(fftw_plan_cache cache, int rank, @Const IntPointer n, int howmany,
+                                       @Cast("fftw_complex*") DoublePointer in, @Cast("fftw_complex*") DoublePointer out, int sign);
+public static native int fftw_plan_cache_execute_dft(fftw_plan_cache cache, int rank, @Const IntBuffer n, int howmany,
+                                       @Cast("fftw_complex*") DoubleBuffer in, @Cast("fftw_complex*") DoubleBuffer out, int sign);
+public static native int fftw_plan_cache_execute_dft(fftw_plan_cache cache, int rank, @Const int[] n, int howmany,
+                                       @Cast("fftw_complex*") double[] in, @Cast("fftw_complex*") double[] out, int sign);
+
+/** Returns the number of plans in the cache. */
+public static native @Cast("size_t") long fftw_plan_cache_size(fftw_plan_cache cache);
+
+/** Returns the number of requests for plans found in the cache. */
+public static native @Cast("unsigned long long") long fftw_plan_cache_hits(fftw_plan_cache cache);
+
+/** Returns the number of requests for plans not found in the cache. */
+public static native @Cast("unsigned long long") long fftw_plan_cache_misses(fftw_plan_cache cache);
+
+public static native fftwf_plan_cache fftwf_plan_cache_create(@Cast("const char*") BytePointer wisdom_filename, @Cast("unsigned") int flags);
+public static native fftwf_plan_cache fftwf_plan_cache_create(String wisdom_filename, @Cast("unsigned") int flags);
+
+public static native int fftwf_plan_cache_save_wisdom(fftwf_plan_cache cache);
+
+public static native void fftwf_plan_cache_destroy(fftwf_plan_cache cache);
+
+public static native fftwf_plan fftwf_plan_cache_get_dft(fftwf_plan_cache cache, int rank, @Const IntPointer n, int howmany,
+                                         @Cast("const fftwf_complex*") FloatPointer in, @Cast("const fftwf_complex*") FloatPointer out, int sign);
+public static native fftwf_plan fftwf_plan_cache_get_dft(fftwf_plan_cache cache, int rank, @Const IntBuffer n, int howmany,
+                                         @Cast("const fftwf_complex*") FloatBuffer in, @Cast("const fftwf_complex*") FloatBuffer out, int sign);
+public static native fftwf_plan fftwf_plan_cache_get_dft(fftwf_plan_cache cache, int rank, @Const int[] n, int howmany,
+                                         @Cast("const fftwf_complex*") float[] in, @Cast("const fftwf_complex*") float[] out, int sign);
+
+public static native int fftwf_plan_cache_execute_dft(fftwf_plan_cache cache, int rank, @Const IntPointer n, int howmany,
+                                       @Cast("fftwf_complex*") FloatPointer in, @Cast("fftwf_complex*") FloatPointer out, int sign);
+public static native int fftwf_plan_cache_execute_dft(fftwf_plan_cache cache, int rank, @Const IntBuffer n, int howmany,
+                                       @Cast("fftwf_complex*") FloatBuffer in, @Cast("fftwf_complex*") FloatBuffer out, int sign);
+public static native int fftwf_plan_cache_execute_dft(fftwf_plan_cache cache, int rank, @Const int[] n, int howmany,
+                                       @Cast("fftwf_complex*") float[] in, @Cast("fftwf_complex*") float[] out, int sign);
+
+public static native @Cast("size_t") long fftwf_plan_cache_size(fftwf_plan_cache cache);
+
+public static native @Cast("unsigned long long") long fftwf_plan_cache_hits(fftwf_plan_cache cache);
+
+public static native @Cast("unsigned long long") long fftwf_plan_cache_misses(fftwf_plan_cache cache);
+
+// #endif /* FFTW3_PLAN_CACHE_H */
+
+
 }
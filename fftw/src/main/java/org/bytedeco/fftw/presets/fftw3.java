@@ -37,7 +37,7 @@ import org.bytedeco.javacpp.tools.InfoMapper;
  * @author Samuel Audet
  */
 @Properties(inherit = javacpp.class, global = "org.bytedeco.fftw.global.fftw3", value = {
-    @Platform(include = "<fftw3.h>", link = {"fftw3@.3", "fftw3f@.3"}),
+    @Platform(include = {"<fftw3.h>", "fftw3_plan_cache.h"}, compiler = "cpp11", link = {"fftw3@.3", "fftw3f@.3"}),
     @Platform(value = "android", link = {"fftw3", "fftw3f"}),
     @Platform(value = "windows", preload = {"libfftw3-3", "libfftw3f-3"}) })
 @NoException
@@ -51,6 +51,9 @@ public class fftw3 implements InfoMapper {
                .put(new Info("fftwf_plan_s").pointerTypes("fftwf_plan")).put(new Info("fftwf_plan").valueTypes("fftwf_plan"))
                .put(new Info("fftwl_plan_s").pointerTypes("fftwl_plan")).put(new Info("fftwl_plan").valueTypes("fftwl_plan"))
                .put(new Info("fftwq_plan_s").pointerTypes("fftwq_plan")).put(new Info("fftwq_plan").valueTypes("fftwq_plan"))
+               .put(new Info("fftw_plan_cache_s").pointerTypes("fftw_plan_cache")).put(new Info("fftw_plan_cache").valueTypes("fftw_plan_cache"))
+               .put(new Info("fftwf_plan_cache_s").pointerTypes("fftwf_plan_cache")).put(new Info("fftwf_plan_cache").valueTypes("fftwf_plan_cache"))
+               .put(new Info("fftw3_plan_cache.h").linePatterns("^#ifndef FFTW3_PLAN_CACHE_PRIVATE_H$", "^#endif /\\* FFTW3_PLAN_CACHE_PRIVATE_H \\*/$").skip())
                .put(new Info("fftw_iodim_do_not_use_me", "fftwf_iodim").pointerTypes("fftw_iodim"))
                .put(new Info("fftw_iodim64_do_not_use_me", "fftwf_iodim64").pointerTypes("fftw_iodim64"))
                .put(new Info("fftw_version").annotations("@Platform(not=\"windows\")").javaNames("fftw_version"))
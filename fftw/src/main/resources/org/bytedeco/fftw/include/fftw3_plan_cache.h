@@ -0,0 +1,312 @@
+/*
+ * Thread-safe caches of FFTW plans for batches of complex DFTs.
+ *
+ * A plan cache creates plans with fftw_plan_many_dft() the first time a
+ * combination of rank, dimensions, batch size, direction, placement, and
+ * alignment of the arrays is requested, using scratch arrays so that planning
+ * with FFTW_MEASURE or FFTW_PATIENT never overwrites user data, and executes
+ * them afterwards on new arrays with fftw_execute_dft(), from any number of
+ * threads. The wisdom accumulated by the planner gets imported from a file
+ * when a cache is created, and exported back to it when it is destroyed, so
+ * that measured plans cost little to create across restarts.
+ *
+ * The same functions exist for single precision with the fftwf_ prefix.
+ */
+
+#ifndef FFTW3_PLAN_CACHE_H
+#define FFTW3_PLAN_CACHE_H
+
+#include <fftw3.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <new>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+typedef struct fftw_plan_cache_s *fftw_plan_cache;
+typedef struct fftwf_plan_cache_s *fftwf_plan_cache;
+
+#ifndef FFTW3_PLAN_CACHE_PRIVATE_H
+#define FFTW3_PLAN_CACHE_PRIVATE_H
+
+template<class R> struct fftw_plan_cache_api;
+
+template<> struct fftw_plan_cache_api<double> {
+    typedef fftw_complex complex;
+    typedef fftw_plan plan;
+    static plan plan_many_dft(int rank, const int *n, int howmany, complex *in, complex *out, int sign, unsigned flags) {
+        int dist = 1;
+        for (int i = 0; i < rank; i++) {
+            dist *= n[i];
+        }
+        return fftw_plan_many_dft(rank, n, howmany, in, NULL, 1, dist, out, NULL, 1, dist, sign, flags);
+    }
+    static void execute_dft(const plan p, complex *in, complex *out) { fftw_execute_dft(p, in, out); }
+    static void destroy_plan(plan p) { fftw_destroy_plan(p); }
+    static void *malloc(size_t n) { return fftw_malloc(n); }
+    static void free(void *p) { fftw_free(p); }
+    static int alignment_of(const complex *p) { return fftw_alignment_of((double *)p); }
+    static int import_wisdom_from_filename(const char *f) { return fftw_import_wisdom_from_filename(f); }
+    static int export_wisdom_to_filename(const char *f) { return fftw_export_wisdom_to_filename(f); }
+    static void make_planner_thread_safe() { fftw_make_planner_thread_safe(); }
+};
+
+template<> struct fftw_plan_cache_api<float> {
+    typedef fftwf_complex complex;
+    typedef fftwf_plan plan;
+    static plan plan_many_dft(int rank, const int *n, int howmany, complex *in, complex *out, int sign, unsigned flags) {
+        int dist = 1;
+        for (int i = 0; i < rank; i++) {
+            dist *= n[i];
+        }
+        return fftwf_plan_many_dft(rank, n, howmany, in, NULL, 1, dist, out, NULL, 1, dist, sign, flags);
+    }
+    static void execute_dft(const plan p, complex *in, complex *out) { fftwf_execute_dft(p, in, out); }
+    static void destroy_plan(plan p) { fftwf_destroy_plan(p); }
+    static void *malloc(size_t n) { return fftwf_malloc(n); }
+    static void free(void *p) { fftwf_free(p); }
+    static int alignment_of(const complex *p) { return fftwf_alignment_of((float *)p); }
+    static int import_wisdom_from_filename(const char *f) { return fftwf_import_wisdom_from_filename(f); }
+    static int export_wisdom_to_filename(const char *f) { return fftwf_export_wisdom_to_filename(f); }
+    static void make_planner_thread_safe() { fftwf_make_planner_thread_safe(); }
+};
+
+template<class R> class fftw_plan_cache_impl {
+public:
+    typedef fftw_plan_cache_api<R> api;
+    typedef typename api::complex complex;
+    typedef typename api::plan plan;
+
+    fftw_plan_cache_impl(const char *wisdom_filename, unsigned flags)
+            : filename(wisdom_filename != NULL ? wisdom_filename : ""), flags(flags), hits(0), misses(0) {
+        std::lock_guard<std::mutex> lock(planner());
+        static bool thread_safe = (api::make_planner_thread_safe(), true);
+        (void)thread_safe;
+        if (!filename.empty()) {
+            api::import_wisdom_from_filename(filename.c_str());
+        }
+    }
+
+    ~fftw_plan_cache_impl() {
+        save();
+        std::lock_guard<std::mutex> lock(planner());
+        for (typename std::map<std::vector<int>, plan>::iterator it = plans.begin(); it != plans.end(); ++it) {
+            api::destroy_plan(it->second);
+        }
+    }
+
+    /* the planner of FFTW is global to each precision */
+    static std::mutex &planner() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+    int save() {
+        if (filename.empty()) {
+            return 0;
+        }
+        /* written to a temporary file first, so that readers never see partial wisdom */
+        std::string temp = filename + ".tmp";
+        std::lock_guard<std::mutex> lock(planner());
+        if (!api::export_wisdom_to_filename(temp.c_str())) {
+            remove(temp.c_str());
+            return 0;
+        }
+#ifdef _WIN32
+        remove(filename.c_str());
+#endif
+        if (rename(temp.c_str(), filename.c_str()) != 0) {
+            remove(temp.c_str());
+            return 0;
+        }
+        return 1;
+    }
+
+    plan get(int rank, const int *n, int howmany, const complex *in, const complex *out, int sign) {
+        if (rank <= 0 || n == NULL || howmany <= 0 || in == NULL || out == NULL) {
+            return NULL;
+        }
+        size_t count = (size_t)howmany;
+        std::vector<int> key;
+        key.reserve(rank + 6);
+        key.push_back(rank);
+        for (int i = 0; i < rank; i++) {
+            if (n[i] <= 0) {
+                return NULL;
+            }
+            key.push_back(n[i]);
+            count *= (size_t)n[i];
+        }
+        int in_alignment = api::alignment_of(in), out_alignment = api::alignment_of(out);
+        key.push_back(howmany);
+        key.push_back(sign);
+        key.push_back(in == out);
+        key.push_back(in_alignment);
+        key.push_back(out_alignment);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            typename std::map<std::vector<int>, plan>::iterator it = plans.find(key);
+            if (it != plans.end()) {
+                hits++;
+                return it->second;
+            }
+        }
+        misses++;
+
+        /* plan on scratch arrays with the same alignment, since measuring overwrites them */
+        size_t bytes = count * sizeof(complex);
+        char *scratch_in = (char *)api::malloc(bytes + 64);
+        char *scratch_out = in == out ? scratch_in : (char *)api::malloc(bytes + 64);
+        plan p = NULL;
+        if (scratch_in != NULL && scratch_out != NULL) {
+            std::lock_guard<std::mutex> lock(planner());
+            p = api::plan_many_dft(rank, n, howmany, (complex *)(scratch_in + in_alignment),
+                                   (complex *)(scratch_out + out_alignment), sign, flags);
+        }
+        if (scratch_out != scratch_in) {
+            api::free(scratch_out);
+        }
+        api::free(scratch_in);
+        if (p == NULL) {
+            return NULL;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::pair<typename std::map<std::vector<int>, plan>::iterator, bool> inserted = plans.insert(std::make_pair(key, p));
+        if (!inserted.second) {
+            /* another thread created the same plan meanwhile */
+            std::lock_guard<std::mutex> lock(planner());
+            api::destroy_plan(p);
+        }
+        return inserted.first->second;
+    }
+
+    int execute(int rank, const int *n, int howmany, complex *in, complex *out, int sign) {
+        plan p = get(rank, n, howmany, in, out, sign);
+        if (p == NULL) {
+            return -1;
+        }
+        api::execute_dft(p, in, out);
+        return 0;
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return plans.size();
+    }
+
+    std::string filename;
+    unsigned flags;
+    std::mutex mutex;
+    std::map<std::vector<int>, plan> plans;
+    std::atomic<unsigned long long> hits, misses;
+};
+
+struct fftw_plan_cache_s : fftw_plan_cache_impl<double> {
+    fftw_plan_cache_s(const char *f, unsigned flags) : fftw_plan_cache_impl<double>(f, flags) { }
+};
+
+struct fftwf_plan_cache_s : fftw_plan_cache_impl<float> {
+    fftwf_plan_cache_s(const char *f, unsigned flags) : fftw_plan_cache_impl<float>(f, flags) { }
+};
+
+#endif /* FFTW3_PLAN_CACHE_PRIVATE_H */
+
+/**
+ * Creates a plan cache, importing the wisdom found in wisdom_filename, if not NULL.
+ * The planner flags, for example FFTW_MEASURE, apply to all plans of the cache.
+ * Also makes the planner thread-safe with fftw_make_planner_thread_safe().
+ */
+inline fftw_plan_cache fftw_plan_cache_create(const char *wisdom_filename, unsigned flags) {
+    return new (std::nothrow) fftw_plan_cache_s(wisdom_filename, flags);
+}
+
+/**
+ * Exports the wisdom of the planner to the file of the cache.
+ * Returns 1 on success, and 0 on failure or if the cache has no file.
+ */
+inline int fftw_plan_cache_save_wisdom(fftw_plan_cache cache) {
+    return cache != NULL ? cache->save() : 0;
+}
+
+/**
+ * Saves the wisdom like fftw_plan_cache_save_wisdom(), and destroys the cache with all its plans.
+ */
+inline void fftw_plan_cache_destroy(fftw_plan_cache cache) {
+    delete cache;
+}
+
+/**
+ * Returns the plan of the cache for howmany contiguous arrays of rank dimensions n,
+ * creating it if needed. It can be executed with fftw_execute_dft() on any arrays with
+ * the same placement and alignment as in and out, whose content is never modified here.
+ * Returns NULL on failure. The plan remains owned by the cache.
+ */
+inline fftw_plan fftw_plan_cache_get_dft(fftw_plan_cache cache, int rank, const int *n, int howmany,
+                                         const fftw_complex *in, const fftw_complex *out, int sign) {
+    return cache != NULL ? cache->get(rank, n, howmany, in, out, sign) : NULL;
+}
+
+/**
+ * Executes the plan returned by fftw_plan_cache_get_dft() on the given arrays.
+ * Returns 0 on success, and -1 on failure.
+ */
+inline int fftw_plan_cache_execute_dft(fftw_plan_cache cache, int rank, const int *n, int howmany,
+                                       fftw_complex *in, fftw_complex *out, int sign) {
+    return cache != NULL ? cache->execute(rank, n, howmany, in, out, sign) : -1;
+}
+
+/** Returns the number of plans in the cache. */
+inline size_t fftw_plan_cache_size(fftw_plan_cache cache) {
+    return cache != NULL ? cache->size() : 0;
+}
+
+/** Returns the number of requests for plans found in the cache. */
+inline unsigned long long fftw_plan_cache_hits(fftw_plan_cache cache) {
+    return cache != NULL ? cache->hits.load() : 0;
+}
+
+/** Returns the number of requests for plans not found in the cache. */
+inline unsigned long long fftw_plan_cache_misses(fftw_plan_cache cache) {
+    return cache != NULL ? cache->misses.load() : 0;
+}
+
+inline fftwf_plan_cache fftwf_plan_cache_create(const char *wisdom_filename, unsigned flags) {
+    return new (std::nothrow) fftwf_plan_cache_s(wisdom_filename, flags);
+}
+
+inline int fftwf_plan_cache_save_wisdom(fftwf_plan_cache cache) {
+    return cache != NULL ? cache->save() : 0;
+}
+
+inline void fftwf_plan_cache_destroy(fftwf_plan_cache cache) {
+    delete cache;
+}
+
+inline fftwf_plan fftwf_plan_cache_get_dft(fftwf_plan_cache cache, int rank, const int *n, int howmany,
+                                           const fftwf_complex *in, const fftwf_complex *out, int sign) {
+    return cache != NULL ? cache->get(rank, n, howmany, in, out, sign) : NULL;
+}
+
+inline int fftwf_plan_cache_execute_dft(fftwf_plan_cache cache, int rank, const int *n, int howmany,
+                                        fftwf_complex *in, fftwf_complex *out, int sign) {
+    return cache != NULL ? cache->execute(rank, n, howmany, in, out, sign) : -1;
+}
+
+inline size_t fftwf_plan_cache_size(fftwf_plan_cache cache) {
+    return cache != NULL ? cache->size() : 0;
+}
+
+inline unsigned long long fftwf_plan_cache_hits(fftwf_plan_cache cache) {
+    return cache != NULL ? cache->hits.load() : 0;
+}
+
+inline unsigned long long fftwf_plan_cache_misses(fftwf_plan_cache cache) {
+    return cache != NULL ? cache->misses.load() : 0;
+}
+
+#endif /* FFTW3_PLAN_CACHE_H */
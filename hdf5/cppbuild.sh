@@ -17,6 +17,7 @@ cd $PLATFORM
 INSTALL_PATH=`pwd`
 echo "Decompressing archives..."
 tar --totals -xf ../hdf5-$HDF5_VERSION.tar.bz2
+tar --totals -xzf ../$ZLIB.tar.gz
 cd hdf5-$HDF5_VERSION
 
 #sedinplace '/cmake_minimum_required/d' $(find ./ -iname CMakeLists.txt)
@@ -42,9 +43,16 @@ case $PLATFORM in
     linux-armhf)
         MACHINE_TYPE=$( uname -m )
         if [[ "$MACHINE_TYPE" =~ arm ]]; then
-          ./configure --prefix=$INSTALL_PATH CC="gcc" CXX="g++" --enable-cxx
+          cd ../$ZLIB
+          CFLAGS="-fPIC" CC="gcc" ./configure --prefix=$INSTALL_PATH/zlib --static
+          make -j $MAKEJ
+          make install
+          cd ../hdf5-$HDF5_VERSION
+          ./configure --prefix=$INSTALL_PATH CC="gcc" CXX="g++" --enable-cxx --with-zlib=$INSTALL_PATH/zlib
           make -j $MAKEJ
           make install-strip
+          cp $INSTALL_PATH/zlib/include/*.h $INSTALL_PATH/include/
+          cp $INSTALL_PATH/zlib/lib/libz.a $INSTALL_PATH/lib/libzlibstatic.a
         else
           echo "Not native arm so assume cross compiling"
           patch -Np1 < ../../../hdf5-linux-armhf.patch || true
@@ -54,14 +62,23 @@ case $PLATFORM in
           done
           make -j $MAKEJ
           make install
+          cp bin/libz.a $INSTALL_PATH/lib/libzlibstatic.a
+          cp HDF5_ZLIB-prefix/src/HDF5_ZLIB/zlib.h HDF5_ZLIB-prefix/src/HDF5_ZLIB-build/zconf.h $INSTALL_PATH/include/
         fi
         ;;
     linux-arm64)
         MACHINE_TYPE=$( uname -m )
         if [[ "$MACHINE_TYPE" =~ arm ]]; then
-          ./configure --prefix=$INSTALL_PATH CC="gcc -m64" CXX="g++ -m64" --enable-cxx
+          cd ../$ZLIB
+          CFLAGS="-fPIC" CC="gcc -m64" ./configure --prefix=$INSTALL_PATH/zlib --static
+          make -j $MAKEJ
+          make install
+          cd ../hdf5-$HDF5_VERSION
+          ./configure --prefix=$INSTALL_PATH CC="gcc -m64" CXX="g++ -m64" --enable-cxx --with-zlib=$INSTALL_PATH/zlib
           make -j $MAKEJ
           make install-strip
+          cp $INSTALL_PATH/zlib/include/*.h $INSTALL_PATH/include/
+          cp $INSTALL_PATH/zlib/lib/libz.a $INSTALL_PATH/lib/libzlibstatic.a
         else
           echo "Not native arm so assume cross compiling"
           patch -Np1 < ../../../hdf5-linux-arm64.patch || true
@@ -71,24 +88,47 @@ case $PLATFORM in
           done
           make -j $MAKEJ
           make install
+          cp bin/libz.a $INSTALL_PATH/lib/libzlibstatic.a
+          cp HDF5_ZLIB-prefix/src/HDF5_ZLIB/zlib.h HDF5_ZLIB-prefix/src/HDF5_ZLIB-build/zconf.h $INSTALL_PATH/include/
         fi
         ;;
     linux-x86)
-        ./configure --prefix=$INSTALL_PATH CC="gcc -m32" CXX="g++ -m32" --enable-cxx
+        cd ../$ZLIB
+        CFLAGS="-fPIC" CC="gcc -m32" ./configure --prefix=$INSTALL_PATH/zlib --static
+        make -j $MAKEJ
+        make install
+        cd ../hdf5-$HDF5_VERSION
+        ./configure --prefix=$INSTALL_PATH CC="gcc -m32" CXX="g++ -m32" --enable-cxx --with-zlib=$INSTALL_PATH/zlib
         make -j $MAKEJ
         make install-strip
+        cp $INSTALL_PATH/zlib/include/*.h $INSTALL_PATH/include/
+        cp $INSTALL_PATH/zlib/lib/libz.a $INSTALL_PATH/lib/libzlibstatic.a
         ;;
     linux-x86_64)
-        ./configure --prefix=$INSTALL_PATH CC="gcc -m64" CXX="g++ -m64" --enable-cxx
+        cd ../$ZLIB
+        CFLAGS="-fPIC" CC="gcc -m64" ./configure --prefix=$INSTALL_PATH/zlib --static
+        make -j $MAKEJ
+        make install
+        cd ../hdf5-$HDF5_VERSION
+        ./configure --prefix=$INSTALL_PATH CC="gcc -m64" CXX="g++ -m64" --enable-cxx --with-zlib=$INSTALL_PATH/zlib
         make -j $MAKEJ
         make install-strip
+        cp $INSTALL_PATH/zlib/include/*.h $INSTALL_PATH/include/
+        cp $INSTALL_PATH/zlib/lib/libz.a $INSTALL_PATH/lib/libzlibstatic.a
         ;;
     linux-ppc64le)
         MACHINE_TYPE=$( uname -m )
         if [[ "$MACHINE_TYPE" =~ ppc64 ]]; then
-          ./configure --prefix=$INSTALL_PATH CC="gcc -m64" CXX="g++ -m64" --enable-cxx
+          cd ../$ZLIB
+          CFLAGS="-fPIC" CC="gcc -m64" ./configure --prefix=$INSTALL_PATH/zlib --static
+          make -j $MAKEJ
+          make install
+          cd ../hdf5-$HDF5_VERSION
+          ./configure --prefix=$INSTALL_PATH CC="gcc -m64" CXX="g++ -m64" --enable-cxx --with-zlib=$INSTALL_PATH/zlib
           make -j $MAKEJ
           make install-strip
+          cp $INSTALL_PATH/zlib/include/*.h $INSTALL_PATH/include/
+          cp $INSTALL_PATH/zlib/lib/libz.a $INSTALL_PATH/lib/libzlibstatic.a
         else
           echo "Not native ppc so assume cross compiling"
           patch -Np1 < ../../../hdf5-linux-ppc64le.patch || true
@@ -98,13 +138,22 @@ case $PLATFORM in
           done
           make -j $MAKEJ
           make install
+          cp bin/libz.a $INSTALL_PATH/lib/libzlibstatic.a
+          cp HDF5_ZLIB-prefix/src/HDF5_ZLIB/zlib.h HDF5_ZLIB-prefix/src/HDF5_ZLIB-build/zconf.h $INSTALL_PATH/include/
         fi
         ;;
     macosx-*)
         patch -Np1 < ../../../hdf5-macosx.patch
-        ./configure --prefix=$INSTALL_PATH --enable-cxx
+        cd ../$ZLIB
+        CFLAGS="-fPIC" ./configure --prefix=$INSTALL_PATH/zlib --static
+        make -j $MAKEJ
+        make install
+        cd ../hdf5-$HDF5_VERSION
+        ./configure --prefix=$INSTALL_PATH --enable-cxx --with-zlib=$INSTALL_PATH/zlib
         make -j $MAKEJ
         make install-strip
+        cp $INSTALL_PATH/zlib/include/*.h $INSTALL_PATH/include/
+        cp $INSTALL_PATH/zlib/lib/libz.a $INSTALL_PATH/lib/libzlibstatic.a
         ;;
     windows-x86)
         mkdir -p build
@@ -117,6 +166,7 @@ case $PLATFORM in
         ninja -j $MAKEJ
         ninja install
         cp bin/zlib* ../../lib/
+        cp HDF5_ZLIB-prefix/src/HDF5_ZLIB/zlib.h HDF5_ZLIB-prefix/src/HDF5_ZLIB-build/zconf.h $INSTALL_PATH/include/
         cd ..
         ;;
     windows-x86_64)
@@ -130,6 +180,7 @@ case $PLATFORM in
         ninja -j $MAKEJ
         ninja install
         cp bin/zlib* ../../lib/
+        cp HDF5_ZLIB-prefix/src/HDF5_ZLIB/zlib.h HDF5_ZLIB-prefix/src/HDF5_ZLIB-build/zconf.h $INSTALL_PATH/include/
         cd ..
         ;;
     *)
@@ -0,0 +1,76 @@
+/*
+ *  This example writes a dataset compressed with the shuffle and deflate
+ *  filters, and reads it back chunk by chunk with H5CSopen(), decoding the
+ *  chunks ahead on all cores.
+ */
+
+import java.nio.FloatBuffer;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.hdf5.*;
+import static org.bytedeco.hdf5.global.hdf5.*;
+
+public class H5ChunkStream {
+    static final String FILE_NAME = "h5_chunk_stream.h5";
+    static final String DATASET_NAME = "Samples";
+    static final int ROWS = 65536;
+    static final int COLUMNS = 256;
+
+    public static void main(String[] args) {
+        String fileName = args.length > 0 ? args[0] : FILE_NAME;
+        int threads = args.length > 1 ? Integer.parseInt(args[1]) : 0;
+
+        // Write the dataset in chunks of 256 rows, unless the file exists already
+        if (args.length == 0) {
+            long file = H5Fcreate(fileName, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+            long space = H5Screate_simple(2, new long[] {ROWS, COLUMNS}, (long[])null);
+            long dcpl = H5Pcreate(H5P_CLS_DATASET_CREATE_ID_g());
+            H5Pset_chunk(dcpl, 2, new long[] {256, COLUMNS});
+            H5Pset_shuffle(dcpl);
+            H5Pset_deflate(dcpl, 6);
+            long dset = H5Dcreate2(file, DATASET_NAME, H5T_NATIVE_FLOAT_g(), space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+            float[] data = new float[ROWS * COLUMNS];
+            for (int i = 0; i < data.length; i++) {
+                data[i] = (i / COLUMNS) * 0.001f + (i % COLUMNS);
+            }
+            H5Dwrite(dset, H5T_NATIVE_FLOAT_g(), H5S_ALL, H5S_ALL, H5P_DEFAULT, new FloatPointer(data));
+            H5Dclose(dset);
+            H5Pclose(dcpl);
+            H5Sclose(space);
+            H5Fclose(file);
+        }
+
+        long file = H5Fopen(fileName, H5F_ACC_RDONLY, H5P_DEFAULT);
+        long dset = H5Dopen2(file, DATASET_NAME, H5P_DEFAULT);
+        H5CS_stream_t stream = H5CSopen(dset, 0, threads);
+        if (stream == null) {
+            System.err.println("Could not stream " + DATASET_NAME + ", which must be chunked.");
+            System.exit(1);
+        }
+
+        long start = System.nanoTime();
+        H5CS_chunk_t chunk = new H5CS_chunk_t();
+        double sum = 0;
+        long bytes = 0;
+        int result;
+        while ((result = H5CSnext(stream, chunk)) > 0) {
+            // The decoded chunk as a direct buffer, valid until released
+            FloatBuffer values = chunk.buf().capacity(chunk.size()).asByteBuffer()
+                    .order(java.nio.ByteOrder.nativeOrder()).asFloatBuffer();
+            while (values.hasRemaining()) {
+                sum += values.get();
+            }
+            bytes += chunk.size();
+            H5CSrelease(stream, chunk);
+        }
+        double seconds = (System.nanoTime() - start) / 1e9;
+        if (result < 0) {
+            System.err.println("Error while reading chunk " + chunk.index());
+        }
+        System.out.printf("%d chunks, %.1f MB in %.3f s, %.1f MB/s, sum %.1f%n", H5CSget_num_chunks(stream),
+                bytes / 1e6, seconds, bytes / 1e6 / seconds, sum);
+
+        H5CSclose(stream);
+        H5Dclose(dset);
+        H5Fclose(file);
+    }
+}
@@ -0,0 +1,46 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.hdf5;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.hdf5.global.hdf5.*;
+
+
+/**
+ * A chunk handed out by H5CSnext(). The data is in the datatype of the dataset
+ * as stored in the file, without conversion, and covers the whole chunk, so
+ * chunks at the edges of the dataset may contain elements past its extent.
+ */
+@Properties(inherit = org.bytedeco.hdf5.presets.hdf5.class)
+public class H5CS_chunk_t extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public H5CS_chunk_t() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public H5CS_chunk_t(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public H5CS_chunk_t(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public H5CS_chunk_t position(long position) {
+        return (H5CS_chunk_t)super.position(position);
+    }
+    @Override public H5CS_chunk_t getPointer(long i) {
+        return new H5CS_chunk_t((Pointer)this).offsetAddress(i);
+    }
+
+    /** Decoded data, aligned on 64 bytes */
+    public native Pointer buf(); public native H5CS_chunk_t buf(Pointer setter);
+    /** Size of the data in bytes, the same for all chunks */
+    public native @Cast("size_t") long size(); public native H5CS_chunk_t size(long setter);
+    /** Index of the chunk in the order of storage */
+    public native @Cast("hsize_t") long index(); public native H5CS_chunk_t index(long setter);
+    /** Logical position of the first element of the chunk */
+    public native @Cast("hsize_t") long offset(int i); public native H5CS_chunk_t offset(int i, long setter);
+    @MemberGetter public native @Cast("hsize_t*") LongPointer offset();
+}
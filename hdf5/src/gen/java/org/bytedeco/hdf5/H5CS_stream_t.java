@@ -0,0 +1,21 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.hdf5;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.hdf5.global.hdf5.*;
+
+
+/** A stream of chunks, created with H5CSopen(). */
+@Opaque @Properties(inherit = org.bytedeco.hdf5.presets.hdf5.class)
+public class H5CS_stream_t extends Pointer {
+    /** Empty constructor. Calls {@code super((Pointer)null)}. */
+    public H5CS_stream_t() { super((Pointer)null); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public H5CS_stream_t(Pointer p) { super(p); }
+}
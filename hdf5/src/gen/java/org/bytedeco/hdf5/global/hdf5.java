@@ -29986,4 +29986,107 @@ September 2017:
 // #endif // H5Library_H
 
 
+// Parsed from H5CSpublic.h
+
+/*-------------------------------------------------------------------------
+ *
+ * "Chunk stream" routines.
+ *
+ * An H5CS_stream_t iterates over the allocated chunks of a chunked dataset
+ * in the order of storage. The raw chunks are read ahead with H5Dread_chunk()
+ * while a pool of threads decodes them, outside of the library, into a ring of
+ * aligned buffers that are handed out in order by H5CSnext() and given back
+ * with H5CSrelease(). The deflate and shuffle filters are decoded this way.
+ * Chunks of datasets with other filters, for example Fletcher32, N-Bit, or
+ * plugins such as LZ4, are read and decoded by the library with H5Dread()
+ * instead.
+ *
+ * When HDF5 was built thread-safe, the chunks are read by a background thread.
+ * Otherwise, H5CSnext() reads them into all the free buffers before waiting
+ * for the next chunk, so that only H5CSopen(), H5CSnext(), and H5CSclose()
+ * call the library, on the calling thread, and like other HDF5 functions,
+ * they must not run at the same time as other calls to the library.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+// #ifndef H5CSpublic_H
+// #define H5CSpublic_H
+
+// #include <algorithm>
+// #include <condition_variable>
+// #include <deque>
+// #include <mutex>
+// #include <new>
+// #include <stdlib.h>
+// #include <string.h>
+// #include <thread>
+// #include <vector>
+// #ifdef _WIN32
+// #include <malloc.h>
+// #endif
+
+// #include "hdf5.h"
+// #ifdef H5_HAVE_FILTER_DEFLATE
+// #include <zlib.h>
+public static final int H5CS_HAVE_ZLIB = 1;
+// #endif
+// Targeting ../H5CS_chunk_t.java
+
+
+// Targeting ../H5CS_stream_t.java
+
+
+
+/**
+ * \brief Opens a stream over the allocated chunks of a chunked dataset
+ *
+ * @param dset_id [in]   Dataset identifier, which gets referenced by the stream
+ * @param nbuffers [in]  Number of chunks decoded ahead, or 0 for twice the number of threads
+ * @param nthreads [in]  Number of decoding threads, or 0 for the number of hardware threads
+ *
+ * @return A new stream, or NULL if the dataset is not chunked or on failure
+ */
+public static native H5CS_stream_t H5CSopen(@Cast("hid_t") long dset_id, @Cast("unsigned") int nbuffers, @Cast("unsigned") int nthreads);
+
+/**
+ * \brief Returns the number of allocated chunks that a stream iterates over
+ */
+public static native @Cast("hsize_t") long H5CSget_num_chunks(@Const H5CS_stream_t stream);
+
+/**
+ * \brief Returns the size in bytes of the decoded chunks of a stream
+ */
+public static native @Cast("size_t") long H5CSget_chunk_size(@Const H5CS_stream_t stream);
+
+/**
+ * \brief Waits for the next chunk of a stream
+ *
+ * @param stream [in]  Stream opened with H5CSopen()
+ * @param chunk [out]   The chunk, to give back with H5CSrelease()
+ *
+ * @return A positive value when a chunk is returned, zero when there are no
+ *         more chunks, and a negative value on failure, or when all buffers
+ *         are held by chunks not yet released
+ */
+public static native @Cast("htri_t") int H5CSnext(H5CS_stream_t stream, H5CS_chunk_t chunk);
+
+/**
+ * \brief Gives back to a stream the buffer of a chunk returned by H5CSnext()
+ *
+ * @return \herr_t
+ */
+public static native @Cast("herr_t") int H5CSrelease(H5CS_stream_t stream, @Const H5CS_chunk_t chunk);
+
+/**
+ * \brief Stops the threads of a stream and frees it, along with the buffers of
+ *        all its chunks
+ *
+ * @return \herr_t
+ */
+public static native @Cast("herr_t") int H5CSclose(H5CS_stream_t stream);
+
+// #endif /* H5CSpublic_H */
+
+
 }
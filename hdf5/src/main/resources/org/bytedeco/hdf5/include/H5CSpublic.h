@@ -0,0 +1,556 @@
+/*-------------------------------------------------------------------------
+ *
+ * "Chunk stream" routines.
+ *
+ * An H5CS_stream_t iterates over the allocated chunks of a chunked dataset
+ * in the order of storage. The raw chunks are read ahead with H5Dread_chunk()
+ * while a pool of threads decodes them, outside of the library, into a ring of
+ * aligned buffers that are handed out in order by H5CSnext() and given back
+ * with H5CSrelease(). The deflate and shuffle filters are decoded this way.
+ * Chunks of datasets with other filters, for example Fletcher32, N-Bit, or
+ * plugins such as LZ4, are read and decoded by the library with H5Dread()
+ * instead.
+ *
+ * When HDF5 was built thread-safe, the chunks are read by a background thread.
+ * Otherwise, H5CSnext() reads them into all the free buffers before waiting
+ * for the next chunk, so that only H5CSopen(), H5CSnext(), and H5CSclose()
+ * call the library, on the calling thread, and like other HDF5 functions,
+ * they must not run at the same time as other calls to the library.
+ *
+ *-------------------------------------------------------------------------
+ */
+
+#ifndef H5CSpublic_H
+#define H5CSpublic_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "hdf5.h"
+#ifdef H5_HAVE_FILTER_DEFLATE
+#include <zlib.h>
+#define H5CS_HAVE_ZLIB 1
+#endif
+
+/**
+ * A chunk handed out by H5CSnext(). The data is in the datatype of the dataset
+ * as stored in the file, without conversion, and covers the whole chunk, so
+ * chunks at the edges of the dataset may contain elements past its extent.
+ */
+typedef struct H5CS_chunk_t {
+    void   *buf;                   /**< Decoded data, aligned on 64 bytes */
+    size_t  size;                  /**< Size of the data in bytes, the same for all chunks */
+    hsize_t index;                 /**< Index of the chunk in the order of storage */
+    hsize_t offset[H5S_MAX_RANK];  /**< Logical position of the first element of the chunk */
+} H5CS_chunk_t;
+
+/** A stream of chunks, created with H5CSopen(). */
+typedef struct H5CS_stream_t H5CS_stream_t;
+
+#ifndef H5CS_PRIVATE_H
+#define H5CS_PRIVATE_H
+
+enum { H5CS_FREE, H5CS_READING, H5CS_READ, H5CS_DECODING, H5CS_READY, H5CS_HELD, H5CS_ERROR };
+
+struct H5CS_slot {
+    int                        state;
+    hsize_t                    index;
+    hsize_t                    offset[H5S_MAX_RANK];
+    unsigned                   filter_mask;
+    std::vector<unsigned char> raw;
+    unsigned char             *buf;
+};
+
+struct H5CS_location {
+    haddr_t  addr;
+    hsize_t  grid;  /* linear index of the chunk in the grid of chunks */
+    hsize_t  size;
+    unsigned filter_mask;
+    bool operator<(const H5CS_location &other) const { return addr < other.addr; }
+};
+
+struct H5CS_filter {
+    H5Z_filter_t id;
+    size_t       element_size;
+};
+
+struct H5CS_stream_t {
+    hid_t                    dset;
+    hid_t                    type;
+    hid_t                    space;
+    int                      rank;
+    hsize_t                  dims[H5S_MAX_RANK];
+    hsize_t                  chunk_dims[H5S_MAX_RANK];
+    size_t                   chunk_size;
+    hsize_t                  nchunks;
+    std::vector<H5CS_location> chunks;
+    bool                     direct;
+    std::vector<H5CS_filter> filters;
+    std::vector<H5CS_slot>   slots;
+    hsize_t                  read;
+    hsize_t                  next;
+    bool                     failed;
+    bool                     stop;
+    std::deque<H5CS_slot *>  queue;
+    std::mutex               mutex;
+    std::condition_variable  cond;
+    std::thread              reader;
+    std::vector<std::thread> workers;
+};
+
+static void *
+H5CS_aligned_alloc(size_t size)
+{
+    size = size > 0 ? (size + 63) / 64 * 64 : 64;
+#ifdef _WIN32
+    return _aligned_malloc(size, 64);
+#else
+    void *p = NULL;
+    return posix_memalign(&p, 64, size) == 0 ? p : NULL;
+#endif
+}
+
+static void
+H5CS_aligned_free(void *p)
+{
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+/* reverses the shuffle filter, which stores the first byte of all elements, then the second, etc. */
+static void
+H5CS_unshuffle(const unsigned char *src, size_t size, unsigned char *dst, size_t element_size)
+{
+    size_t n = element_size > 1 ? size / element_size : 0;
+    if (n == 0) {
+        memcpy(dst, src, size);
+        return;
+    }
+    for (size_t b = 0; b < element_size; b++) {
+        const unsigned char *s = src + b * n;
+        unsigned char       *d = dst + b;
+        for (size_t i = 0; i < n; i++, d += element_size)
+            *d = s[i];
+    }
+    memcpy(dst + n * element_size, src + n * element_size, size - n * element_size);
+}
+
+/* applies the filters of the pipeline in reverse, without calling the library */
+static bool
+H5CS_decode(const H5CS_stream_t *stream, H5CS_slot *slot, std::vector<unsigned char> scratch[2])
+{
+    std::vector<const H5CS_filter *> filters;
+    for (size_t i = stream->filters.size(); i-- > 0;)
+        if (!(slot->filter_mask & (1u << i)))
+            filters.push_back(&stream->filters[i]);
+
+    const unsigned char *src  = slot->raw.data();
+    size_t               size = slot->raw.size();
+    if (filters.empty()) {
+        if (size != stream->chunk_size)
+            return false;
+        memcpy(slot->buf, src, size);
+        return true;
+    }
+    for (size_t k = 0; k < filters.size(); k++) {
+        unsigned char *dst;
+        if (k + 1 == filters.size())
+            dst = slot->buf;
+        else {
+            scratch[k % 2].resize(stream->chunk_size);
+            dst = scratch[k % 2].data();
+        }
+        if (filters[k]->id == H5Z_FILTER_SHUFFLE) {
+            if (size > stream->chunk_size)
+                return false;
+            H5CS_unshuffle(src, size, dst, filters[k]->element_size);
+        }
+#ifdef H5CS_HAVE_ZLIB
+        else if (filters[k]->id == H5Z_FILTER_DEFLATE) {
+            uLongf length = (uLongf)stream->chunk_size;
+            if (uncompress(dst, &length, src, (uLong)size) != Z_OK)
+                return false;
+            size = length;
+        }
+#endif
+        else
+            return false;
+        src = dst;
+    }
+    return size == stream->chunk_size;
+}
+
+/* reads a chunk with the library applying the filters, into the decoded buffer */
+static bool
+H5CS_read_filtered(H5CS_stream_t *stream, H5CS_slot *slot)
+{
+    hsize_t count[H5S_MAX_RANK], start[H5S_MAX_RANK];
+    bool    clipped = false;
+    for (int i = 0; i < stream->rank; i++) {
+        start[i] = 0;
+        count[i] = stream->chunk_dims[i];
+        if (slot->offset[i] + count[i] > stream->dims[i]) {
+            count[i] = stream->dims[i] - slot->offset[i];
+            clipped  = true;
+        }
+    }
+    if (clipped)
+        memset(slot->buf, 0, stream->chunk_size);
+    hid_t mspace = H5Screate_simple(stream->rank, stream->chunk_dims, NULL);
+    hid_t fspace = H5Scopy(stream->space);
+    bool  ok     = mspace >= 0 && fspace >= 0 &&
+              H5Sselect_hyperslab(mspace, H5S_SELECT_SET, start, NULL, count, NULL) >= 0 &&
+              H5Sselect_hyperslab(fspace, H5S_SELECT_SET, slot->offset, NULL, count, NULL) >= 0 &&
+              H5Dread(stream->dset, stream->type, mspace, fspace, H5P_DEFAULT, slot->buf) >= 0;
+    if (fspace >= 0)
+        H5Sclose(fspace);
+    if (mspace >= 0)
+        H5Sclose(mspace);
+    return ok;
+}
+
+/* returns the number of chunks along a dimension of the dataset */
+static hsize_t
+H5CS_grid_dim(const H5CS_stream_t *stream, int i)
+{
+    return (stream->dims[i] + stream->chunk_dims[i] - 1) / stream->chunk_dims[i];
+}
+
+/* computes the logical position of a chunk from its linear index in the grid of chunks */
+static void
+H5CS_grid_offset(const H5CS_stream_t *stream, hsize_t grid, hsize_t *offset)
+{
+    for (int i = stream->rank; i-- > 0;) {
+        hsize_t n = H5CS_grid_dim(stream, i);
+        offset[i] = grid % n * stream->chunk_dims[i];
+        grid /= n;
+    }
+}
+
+/* finds the allocated chunks in a single pass over the grid, sorted in the order of storage */
+static bool
+H5CS_locate(H5CS_stream_t *stream)
+{
+    hsize_t total = 1;
+    for (int i = 0; i < stream->rank; i++)
+        total *= H5CS_grid_dim(stream, i);
+    for (hsize_t g = 0; g < total; g++) {
+        hsize_t       offset[H5S_MAX_RANK];
+        H5CS_location location;
+        H5CS_grid_offset(stream, g, offset);
+        location.grid = g;
+        location.size = 0;
+        if (H5Dget_chunk_info_by_coord(stream->dset, offset, &location.filter_mask, &location.addr,
+                                       &location.size) < 0)
+            return false;
+        if (location.addr != HADDR_UNDEF && location.size > 0)
+            stream->chunks.push_back(location);
+    }
+    std::sort(stream->chunks.begin(), stream->chunks.end());
+    stream->nchunks = stream->chunks.size();
+    return true;
+}
+
+/* reads a chunk into a slot in the H5CS_READING state, and hands it to the decoding threads */
+static bool
+H5CS_read(H5CS_stream_t *stream, H5CS_slot *slot)
+{
+    const H5CS_location &location = stream->chunks[slot->index];
+    H5CS_grid_offset(stream, location.grid, slot->offset);
+    slot->filter_mask = location.filter_mask;
+    bool ok           = true;
+    bool ready        = false;
+    if (stream->direct) {
+        uint32_t filter_mask = 0;
+        slot->raw.resize((size_t)location.size);
+        ok = H5Dread_chunk(stream->dset, H5P_DEFAULT, slot->offset, &filter_mask, slot->raw.data()) >= 0;
+        slot->filter_mask = filter_mask;
+    }
+    else {
+        ok    = H5CS_read_filtered(stream, slot);
+        ready = true;
+    }
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    if (!ok)
+        slot->state = H5CS_ERROR;
+    else if (ready)
+        slot->state = H5CS_READY;
+    else {
+        slot->state = H5CS_READ;
+        stream->queue.push_back(slot);
+    }
+    stream->cond.notify_all();
+    return ok;
+}
+
+/* reads the chunks into the free slots in order, with the lock held except during the reads */
+static void
+H5CS_read_ahead(H5CS_stream_t *stream, std::unique_lock<std::mutex> &lock)
+{
+    size_t nslots = stream->slots.size();
+    while (!stream->stop && stream->read < stream->nchunks) {
+        H5CS_slot *slot = &stream->slots[stream->read % nslots];
+        if (slot->state != H5CS_FREE)
+            return;
+        slot->state = H5CS_READING;
+        slot->index = stream->read++;
+        lock.unlock();
+        bool ok = H5CS_read(stream, slot);
+        lock.lock();
+        if (!ok)
+            stream->read = stream->nchunks; /* stops at the failed chunk */
+    }
+}
+
+static void
+H5CS_read_loop(H5CS_stream_t *stream)
+{
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    while (!stream->stop && stream->read < stream->nchunks) {
+        H5CS_read_ahead(stream, lock);
+        if (stream->read < stream->nchunks)
+            stream->cond.wait(lock);
+    }
+}
+
+static void
+H5CS_decode_loop(H5CS_stream_t *stream)
+{
+    std::vector<unsigned char> scratch[2];
+    for (;;) {
+        H5CS_slot *slot;
+        {
+            std::unique_lock<std::mutex> lock(stream->mutex);
+            while (!stream->stop && stream->queue.empty())
+                stream->cond.wait(lock);
+            if (stream->stop)
+                return;
+            slot = stream->queue.front();
+            stream->queue.pop_front();
+            slot->state = H5CS_DECODING;
+        }
+        bool ok = H5CS_decode(stream, slot, scratch);
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        slot->state = ok ? H5CS_READY : H5CS_ERROR;
+        stream->cond.notify_all();
+    }
+}
+
+static void
+H5CS_free(H5CS_stream_t *stream)
+{
+    {
+        std::lock_guard<std::mutex> lock(stream->mutex);
+        stream->stop = true;
+    }
+    stream->cond.notify_all();
+    if (stream->reader.joinable())
+        stream->reader.join();
+    for (size_t i = 0; i < stream->workers.size(); i++)
+        stream->workers[i].join();
+    for (size_t i = 0; i < stream->slots.size(); i++)
+        H5CS_aligned_free(stream->slots[i].buf);
+    if (stream->space >= 0)
+        H5Sclose(stream->space);
+    if (stream->type >= 0)
+        H5Tclose(stream->type);
+    if (stream->dset >= 0)
+        H5Idec_ref(stream->dset);
+    delete stream;
+}
+
+#endif /* H5CS_PRIVATE_H */
+
+/**
+ * \brief Opens a stream over the allocated chunks of a chunked dataset
+ *
+ * \param[in] dset_id   Dataset identifier, which gets referenced by the stream
+ * \param[in] nbuffers  Number of chunks decoded ahead, or 0 for twice the number of threads
+ * \param[in] nthreads  Number of decoding threads, or 0 for the number of hardware threads
+ *
+ * \return A new stream, or NULL if the dataset is not chunked or on failure
+ */
+inline H5CS_stream_t *
+H5CSopen(hid_t dset_id, unsigned nbuffers, unsigned nthreads)
+{
+    if (nthreads == 0)
+        nthreads = std::thread::hardware_concurrency();
+    if (nthreads == 0)
+        nthreads = 1;
+    if (nbuffers == 0)
+        nbuffers = 2 * nthreads;
+
+    H5CS_stream_t *stream = new (std::nothrow) H5CS_stream_t();
+    if (stream == NULL)
+        return NULL;
+    stream->type = stream->space = stream->dset = H5I_INVALID_HID;
+    stream->read                                = 0;
+    stream->next                                = 0;
+    stream->failed = stream->stop = false;
+    stream->direct                = true;
+    if (H5Iinc_ref(dset_id) < 0) {
+        delete stream;
+        return NULL;
+    }
+    stream->dset = dset_id;
+
+    hid_t  dcpl      = H5Dget_create_plist(dset_id);
+    size_t type_size = 0;
+    bool   ok        = dcpl >= 0 && H5Pget_layout(dcpl) == H5D_CHUNKED &&
+              (stream->type = H5Dget_type(dset_id)) >= 0 && (type_size = H5Tget_size(stream->type)) > 0 &&
+              (stream->space = H5Dget_space(dset_id)) >= 0 &&
+              (stream->rank = H5Sget_simple_extent_ndims(stream->space)) > 0 &&
+              H5Sget_simple_extent_dims(stream->space, stream->dims, NULL) >= 0 &&
+              H5Pget_chunk(dcpl, stream->rank, stream->chunk_dims) == stream->rank && H5CS_locate(stream);
+    if (ok) {
+        stream->chunk_size = type_size;
+        for (int i = 0; i < stream->rank; i++)
+            stream->chunk_size *= (size_t)stream->chunk_dims[i];
+        int nfilters = H5Pget_nfilters(dcpl);
+        for (int i = 0; ok && i < nfilters; i++) {
+            unsigned     flags, cd_values[8];
+            size_t       cd_nelmts = 8;
+            H5CS_filter  filter;
+            filter.id           = H5Pget_filter2(dcpl, (unsigned)i, &flags, &cd_nelmts, cd_values, 0, NULL, NULL);
+            filter.element_size = filter.id == H5Z_FILTER_SHUFFLE && cd_nelmts > 0 ? cd_values[0] : type_size;
+            ok                  = filter.id >= 0;
+#ifdef H5CS_HAVE_ZLIB
+            if (filter.id != H5Z_FILTER_SHUFFLE && filter.id != H5Z_FILTER_DEFLATE)
+#else
+            if (filter.id != H5Z_FILTER_SHUFFLE)
+#endif
+                stream->direct = false;
+            stream->filters.push_back(filter);
+        }
+    }
+    if (dcpl >= 0)
+        H5Pclose(dcpl);
+
+    if (ok) {
+        stream->slots.resize(nbuffers);
+        for (size_t i = 0; ok && i < stream->slots.size(); i++) {
+            stream->slots[i].state = H5CS_FREE;
+            stream->slots[i].index = 0;
+            stream->slots[i].buf   = (unsigned char *)H5CS_aligned_alloc(stream->chunk_size);
+            ok                     = stream->slots[i].buf != NULL;
+        }
+    }
+    if (!ok) {
+        H5CS_free(stream);
+        return NULL;
+    }
+    hbool_t threadsafe = false;
+    if (H5is_library_threadsafe(&threadsafe) >= 0 && threadsafe)
+        stream->reader = std::thread(H5CS_read_loop, stream);
+    if (stream->direct)
+        for (unsigned i = 0; i < nthreads; i++)
+            stream->workers.push_back(std::thread(H5CS_decode_loop, stream));
+    return stream;
+}
+
+/**
+ * \brief Returns the number of allocated chunks that a stream iterates over
+ */
+inline hsize_t
+H5CSget_num_chunks(const H5CS_stream_t *stream)
+{
+    return stream != NULL ? stream->nchunks : 0;
+}
+
+/**
+ * \brief Returns the size in bytes of the decoded chunks of a stream
+ */
+inline size_t
+H5CSget_chunk_size(const H5CS_stream_t *stream)
+{
+    return stream != NULL ? stream->chunk_size : 0;
+}
+
+/**
+ * \brief Waits for the next chunk of a stream
+ *
+ * \param[in]  stream  Stream opened with H5CSopen()
+ * \param[out] chunk   The chunk, to give back with H5CSrelease()
+ *
+ * \return A positive value when a chunk is returned, zero when there are no
+ *         more chunks, and a negative value on failure, or when all buffers
+ *         are held by chunks not yet released
+ */
+inline htri_t
+H5CSnext(H5CS_stream_t *stream, H5CS_chunk_t *chunk)
+{
+    if (stream == NULL || chunk == NULL)
+        return -1;
+    std::unique_lock<std::mutex> lock(stream->mutex);
+    if (stream->failed)
+        return -1;
+    if (stream->next >= stream->nchunks)
+        return 0;
+    H5CS_slot *slot = &stream->slots[stream->next % stream->slots.size()];
+    if (slot->state == H5CS_HELD)
+        return -1;
+    if (!stream->reader.joinable())
+        H5CS_read_ahead(stream, lock);
+    while (slot->state != H5CS_ERROR && (slot->state != H5CS_READY || slot->index != stream->next))
+        stream->cond.wait(lock);
+    if (slot->state == H5CS_ERROR) {
+        stream->failed = true;
+        return -1;
+    }
+    slot->state  = H5CS_HELD;
+    chunk->buf   = slot->buf;
+    chunk->size  = stream->chunk_size;
+    chunk->index = slot->index;
+    memcpy(chunk->offset, slot->offset, sizeof(chunk->offset));
+    stream->next++;
+    return 1;
+}
+
+/**
+ * \brief Gives back to a stream the buffer of a chunk returned by H5CSnext()
+ *
+ * \return \herr_t
+ */
+inline herr_t
+H5CSrelease(H5CS_stream_t *stream, const H5CS_chunk_t *chunk)
+{
+    if (stream == NULL || chunk == NULL)
+        return -1;
+    std::lock_guard<std::mutex> lock(stream->mutex);
+    H5CS_slot *slot = &stream->slots[chunk->index % stream->slots.size()];
+    if (slot->state != H5CS_HELD || slot->index != chunk->index)
+        return -1;
+    slot->state = H5CS_FREE;
+    stream->cond.notify_all();
+    return 0;
+}
+
+/**
+ * \brief Stops the threads of a stream and frees it, along with the buffers of
+ *        all its chunks
+ *
+ * \return \herr_t
+ */
+inline herr_t
+H5CSclose(H5CS_stream_t *stream)
+{
+    if (stream == NULL)
+        return -1;
+    H5CS_free(stream);
+    return 0;
+}
+
+#endif /* H5CSpublic_H */
@@ -0,0 +1,56 @@
+import org.bytedeco.hyperscan.global.hyperscan;
+import org.bytedeco.hyperscan.hs_cache_t;
+import org.bytedeco.hyperscan.hs_compile_error_t;
+import org.bytedeco.hyperscan.hs_database_t;
+import org.bytedeco.javacpp.BytePointer;
+import org.bytedeco.javacpp.IntPointer;
+import org.bytedeco.javacpp.Loader;
+import org.bytedeco.javacpp.PointerPointer;
+
+import static org.bytedeco.hyperscan.global.hyperscan.HS_FLAG_CASELESS;
+import static org.bytedeco.hyperscan.global.hyperscan.HS_MODE_BLOCK;
+
+/**
+ * Compiles a set of patterns through a cache directory. The first run compiles
+ * and stores the database, and later runs load it without compiling.
+ */
+public class HyperscanCacheTest {
+
+    public static void main(String[] args) {
+        Loader.load(hyperscan.class);
+
+        String directory = args.length > 0 ? args[0] : System.getProperty("java.io.tmpdir") + "/hyperscan-cache";
+        String[] patterns = new String[10000];
+        int[] flags = new int[patterns.length], ids = new int[patterns.length];
+        for (int i = 0; i < patterns.length; i++) {
+            patterns[i] = "user" + i + "[-_]?(id|name)=\\w{3," + (4 + i % 16) + "}";
+            flags[i] = HS_FLAG_CASELESS;
+            ids[i] = i;
+        }
+
+        hs_cache_t cache = new hs_cache_t();
+        if (hyperscan.hs_cache_open(directory, null, null, cache) != 0) {
+            System.out.println("Cannot open cache in " + directory);
+            System.exit(1);
+        }
+        try (PointerPointer<hs_database_t> database_p = new PointerPointer<hs_database_t>(1);
+             PointerPointer<hs_compile_error_t> compile_error_p = new PointerPointer<hs_compile_error_t>(1);
+             PointerPointer expressions = new PointerPointer<BytePointer>(patterns);
+             IntPointer flagsPointer = new IntPointer(flags);
+             IntPointer idsPointer = new IntPointer(ids)) {
+            long start = System.nanoTime();
+            int result = hyperscan.hs_cache_compile_multi(cache, expressions, flagsPointer, idsPointer,
+                    patterns.length, HS_MODE_BLOCK, null, database_p, compile_error_p);
+            long end = System.nanoTime();
+            if (result != 0) {
+                System.out.println(new hs_compile_error_t(compile_error_p.get(0)).message().getString());
+                System.exit(1);
+            }
+            System.out.printf("%d patterns in %.1f ms, hits: %d, misses: %d%n", patterns.length, (end - start) / 1e6,
+                    hyperscan.hs_cache_hits(cache), hyperscan.hs_cache_misses(cache));
+            hyperscan.hs_free_database(new hs_database_t(database_p.get(0)));
+        } finally {
+            hyperscan.hs_cache_close(cache);
+        }
+    }
+}
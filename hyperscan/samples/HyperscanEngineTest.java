@@ -0,0 +1,100 @@
+import java.util.ArrayList;
+import java.util.List;
+import org.bytedeco.hyperscan.global.hyperscan;
+import org.bytedeco.hyperscan.hs_compile_error_t;
+import org.bytedeco.hyperscan.hs_database_t;
+import org.bytedeco.hyperscan.hs_engine_match_t;
+import org.bytedeco.hyperscan.hs_engine_t;
+import org.bytedeco.javacpp.BytePointer;
+import org.bytedeco.javacpp.IntPointer;
+import org.bytedeco.javacpp.Loader;
+import org.bytedeco.javacpp.LongPointer;
+import org.bytedeco.javacpp.PointerPointer;
+
+import static org.bytedeco.hyperscan.global.hyperscan.HS_FLAG_SOM_LEFTMOST;
+import static org.bytedeco.hyperscan.global.hyperscan.HS_MODE_BLOCK;
+
+/**
+ * Scans batches of packets from several threads with a single hs_engine_t,
+ * which hands a scratch space to each thread and collects the matches natively.
+ */
+public class HyperscanEngineTest {
+
+    static final int THREADS = 4, BATCHES = 1000, BATCH_SIZE = 64, MAX_MATCHES = 1024;
+
+    public static void main(String[] args) throws InterruptedException {
+        Loader.load(hyperscan.class);
+
+        String[] patterns = { "abc1", "asa", "dab" };
+        final hs_database_t database;
+        final hs_engine_t engine = new hs_engine_t();
+
+        try (PointerPointer<hs_database_t> database_p = new PointerPointer<hs_database_t>(1);
+             PointerPointer<hs_compile_error_t> compile_error_p = new PointerPointer<hs_compile_error_t>(1);
+             IntPointer compileFlags = new IntPointer(HS_FLAG_SOM_LEFTMOST, HS_FLAG_SOM_LEFTMOST, HS_FLAG_SOM_LEFTMOST);
+             IntPointer patternIds = new IntPointer(0, 1, 2);
+             PointerPointer expressions = new PointerPointer<BytePointer>(patterns)) {
+            int result = hyperscan.hs_compile_multi(expressions, compileFlags, patternIds, patterns.length,
+                    HS_MODE_BLOCK, null, database_p, compile_error_p);
+            if (result != 0) {
+                System.out.println(new hs_compile_error_t(compile_error_p.get(0)).message().getString());
+                System.exit(1);
+            }
+            database = new hs_database_t(database_p.get(0));
+        }
+        if (hyperscan.hs_engine_create(database, THREADS, engine) != 0) {
+            System.out.println("Error during engine creation");
+            System.exit(1);
+        }
+
+        // pack all the packets of a batch in a single buffer
+        StringBuilder packets = new StringBuilder();
+        final long[] offsets = new long[BATCH_SIZE + 1];
+        for (int i = 0; i < BATCH_SIZE; i++) {
+            packets.append(i % 2 == 0 ? "-21dasaaadabcaaa" : "abc1--------asa");
+            offsets[i + 1] = packets.length();
+        }
+        final String batch = packets.toString();
+
+        final long[] found = new long[THREADS];
+        List<Thread> threads = new ArrayList<Thread>();
+        for (int t = 0; t < THREADS; t++) {
+            final int index = t;
+            Thread thread = new Thread() {
+                @Override public void run() {
+                    try (BytePointer data = new BytePointer(batch);
+                         LongPointer offsetsPointer = new LongPointer(offsets);
+                         hs_engine_match_t matches = new hs_engine_match_t(MAX_MATCHES);
+                         IntPointer matchCounts = new IntPointer(BATCH_SIZE);
+                         LongPointer totalMatches = new LongPointer(1)) {
+                        for (int i = 0; i < BATCHES; i++) {
+                            int result = hyperscan.hs_engine_scan(engine, data, offsetsPointer, BATCH_SIZE,
+                                    matches, MAX_MATCHES, matchCounts, totalMatches);
+                            if (result != 0) {
+                                throw new IllegalStateException("Error " + result + " during scan");
+                            }
+                            found[index] += totalMatches.get();
+                        }
+                        if (index == 0) {
+                            for (int i = 0; i < matchCounts.get(0); i++) {
+                                hs_engine_match_t m = matches.getPointer(i);
+                                System.out.println(m.id() + " " + m.from() + "-" + m.to());
+                            }
+                        }
+                    }
+                }
+            };
+            thread.start();
+            threads.add(thread);
+        }
+        long total = 0;
+        for (int t = 0; t < THREADS; t++) {
+            threads.get(t).join();
+            total += found[t];
+        }
+        System.out.println(total + " matches with " + hyperscan.hs_engine_scratch_count(engine) + " scratch spaces");
+
+        hyperscan.hs_engine_destroy(engine);
+        hyperscan.hs_free_database(database);
+    }
+}
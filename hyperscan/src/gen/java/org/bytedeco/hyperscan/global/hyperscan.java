@@ -2396,4 +2396,314 @@ public static final int HS_PATCH =      0;
 // #endif /* HS_H_ */
 
 
+// Parsed from hs_engine.h
+
+/*
+ * Multithreaded block and stream scanning over a single compiled database.
+ *
+ * An hs_engine_t keeps a pool of scratch spaces cloned from a prototype with
+ * hs_clone_scratch(), so that any number of threads can scan at the same time
+ * without sharing a scratch or taking a lock. Each call scans a batch of
+ * buffers packed one after the other, and matches are collected natively into
+ * an array of hs_engine_match_t, instead of calling back into Java per match.
+ */
+
+// #ifndef HS_ENGINE_H_
+// #define HS_ENGINE_H_
+
+// #include <atomic>
+// #include <functional>
+// #include <limits.h>
+// #include <new>
+// #include <thread>
+// #include "hs/hs.h"
+// Targeting ../hs_engine.java
+
+
+// Targeting ../hs_engine_t.java
+
+
+// Targeting ../hs_engine_match_t.java
+
+
+
+/**
+ * Create a scanning engine for a compiled pattern database.
+ *
+ * @param db
+ *      A compiled pattern database, which must outlive the engine.
+ *
+ * @param maxScratches
+ *      The maximum number of scratch spaces to clone, which is the number of
+ *      calls that may scan at the same time, or 0 for the number of hardware
+ *      threads. Scratch spaces are cloned on demand, and further calls wait
+ *      for one to be released.
+ *
+ * @param engine
+ *      On success, a pointer to the new engine; NULL on failure.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure.
+ */
+public static native @Cast("hs_error_t") int hs_engine_create(@Const hs_database_t db, @Cast("unsigned int") int maxScratches, @Cast("hs_engine_t**") PointerPointer engine);
+public static native @Cast("hs_error_t") int hs_engine_create(@Const hs_database_t db, @Cast("unsigned int") int maxScratches, @ByPtrPtr hs_engine_t engine);
+
+/**
+ * Free an engine and all of its scratch spaces. It must not be in use.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure.
+ */
+public static native @Cast("hs_error_t") int hs_engine_destroy(hs_engine_t engine);
+
+/**
+ * Returns the number of scratch spaces cloned so far, which is at most the
+ * number of calls that have been scanning at the same time.
+ */
+public static native @Cast("unsigned int") int hs_engine_scratch_count(@Const hs_engine_t engine);
+
+/**
+ * Scan a batch of buffers in block mode. This function may be called from
+ * any number of threads at the same time.
+ *
+ * @param engine
+ *      An engine created for a database compiled with \ref HS_MODE_BLOCK.
+ *
+ * @param data
+ *      The buffers, packed one after the other.
+ *
+ * @param offsets
+ *      An array of count + 1 offsets, such that buffer i is the range
+ *      [offsets[i], offsets[i + 1]) of data.
+ *
+ * @param count
+ *      The number of buffers.
+ *
+ * @param matches
+ *      An array receiving up to maxMatches matches, grouped by buffer in order.
+ *
+ * @param maxMatches
+ *      The capacity of the matches array.
+ *
+ * @param matchCounts
+ *      An array of count elements receiving the number of matches stored for
+ *      each buffer, or NULL.
+ *
+ * @param totalMatches
+ *      Receives the number of matches found, which exceeds maxMatches when
+ *      some did not fit in the array, or NULL.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure, in which case
+ *      buffers after the failing one are not scanned.
+ */
+public static native @Cast("hs_error_t") int hs_engine_scan(hs_engine_t engine, @Cast("const char*") BytePointer data, @Cast("const unsigned long long*") LongPointer offsets,
+                                 @Cast("unsigned int") int count, hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                 @Cast("unsigned int*") IntPointer matchCounts, @Cast("unsigned long long*") LongPointer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan(hs_engine_t engine, String data, @Cast("const unsigned long long*") LongBuffer offsets,
+                                 @Cast("unsigned int") int count, hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                 @Cast("unsigned int*") IntBuffer matchCounts, @Cast("unsigned long long*") LongBuffer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan(hs_engine_t engine, @Cast("const char*") BytePointer data, @Cast("const unsigned long long*") long[] offsets,
+                                 @Cast("unsigned int") int count, hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                 @Cast("unsigned int*") int[] matchCounts, @Cast("unsigned long long*") long[] totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan(hs_engine_t engine, String data, @Cast("const unsigned long long*") LongPointer offsets,
+                                 @Cast("unsigned int") int count, hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                 @Cast("unsigned int*") IntPointer matchCounts, @Cast("unsigned long long*") LongPointer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan(hs_engine_t engine, @Cast("const char*") BytePointer data, @Cast("const unsigned long long*") LongBuffer offsets,
+                                 @Cast("unsigned int") int count, hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                 @Cast("unsigned int*") IntBuffer matchCounts, @Cast("unsigned long long*") LongBuffer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan(hs_engine_t engine, String data, @Cast("const unsigned long long*") long[] offsets,
+                                 @Cast("unsigned int") int count, hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                 @Cast("unsigned int*") int[] matchCounts, @Cast("unsigned long long*") long[] totalMatches);
+
+/**
+ * Write a batch of buffers to streams opened with \ref hs_open_stream() on the
+ * database of the engine. This function may be called from any number of
+ * threads at the same time, as long as each stream is used by only one of them.
+ *
+ * @param streams
+ *      An array of count distinct streams, where buffer i is written to stream i.
+ *
+ * The other parameters and the return value are as for \ref hs_engine_scan(),
+ * with match offsets relative to the start of each stream.
+ */
+public static native @Cast("hs_error_t") int hs_engine_scan_streams(hs_engine_t engine, @Cast("hs_stream_t**") PointerPointer streams, @Cast("const char*") BytePointer data,
+                                         @Cast("const unsigned long long*") LongPointer offsets, @Cast("unsigned int") int count,
+                                         hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                         @Cast("unsigned int*") IntPointer matchCounts, @Cast("unsigned long long*") LongPointer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, @Cast("const char*") BytePointer data,
+                                         @Cast("const unsigned long long*") LongPointer offsets, @Cast("unsigned int") int count,
+                                         hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                         @Cast("unsigned int*") IntPointer matchCounts, @Cast("unsigned long long*") LongPointer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, String data,
+                                         @Cast("const unsigned long long*") LongBuffer offsets, @Cast("unsigned int") int count,
+                                         hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                         @Cast("unsigned int*") IntBuffer matchCounts, @Cast("unsigned long long*") LongBuffer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, @Cast("const char*") BytePointer data,
+                                         @Cast("const unsigned long long*") long[] offsets, @Cast("unsigned int") int count,
+                                         hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                         @Cast("unsigned int*") int[] matchCounts, @Cast("unsigned long long*") long[] totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, String data,
+                                         @Cast("const unsigned long long*") LongPointer offsets, @Cast("unsigned int") int count,
+                                         hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                         @Cast("unsigned int*") IntPointer matchCounts, @Cast("unsigned long long*") LongPointer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, @Cast("const char*") BytePointer data,
+                                         @Cast("const unsigned long long*") LongBuffer offsets, @Cast("unsigned int") int count,
+                                         hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                         @Cast("unsigned int*") IntBuffer matchCounts, @Cast("unsigned long long*") LongBuffer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_scan_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, String data,
+                                         @Cast("const unsigned long long*") long[] offsets, @Cast("unsigned int") int count,
+                                         hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                         @Cast("unsigned int*") int[] matchCounts, @Cast("unsigned long long*") long[] totalMatches);
+
+/**
+ * Close a batch of streams, collecting the matches raised at end of data, and
+ * free them. Elements of streams that are NULL are skipped.
+ *
+ * The other parameters and the return value are as for \ref hs_engine_scan().
+ */
+public static native @Cast("hs_error_t") int hs_engine_close_streams(hs_engine_t engine, @Cast("hs_stream_t**") PointerPointer streams, @Cast("unsigned int") int count,
+                                          hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                          @Cast("unsigned int*") IntPointer matchCounts, @Cast("unsigned long long*") LongPointer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_close_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, @Cast("unsigned int") int count,
+                                          hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                          @Cast("unsigned int*") IntPointer matchCounts, @Cast("unsigned long long*") LongPointer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_close_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, @Cast("unsigned int") int count,
+                                          hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                          @Cast("unsigned int*") IntBuffer matchCounts, @Cast("unsigned long long*") LongBuffer totalMatches);
+public static native @Cast("hs_error_t") int hs_engine_close_streams(hs_engine_t engine, @ByPtrPtr hs_stream_t streams, @Cast("unsigned int") int count,
+                                          hs_engine_match_t matches, @Cast("unsigned int") int maxMatches,
+                                          @Cast("unsigned int*") int[] matchCounts, @Cast("unsigned long long*") long[] totalMatches);
+
+// #endif /* HS_ENGINE_H_ */
+
+
+// Parsed from hs_cache.h
+
+/*
+ * On-disk cache of compiled pattern databases.
+ *
+ * An hs_cache_t compiles sets of patterns with hs_compile_multi() the first
+ * time they are seen, serializes the databases with hs_serialize_database()
+ * in a directory, and on later calls, even from other processes, maps the
+ * files in memory and deserializes them with hs_deserialize_database_at()
+ * instead of compiling again. Files are named after a hash of the patterns,
+ * their flags and ids, the mode, the target platform, and the version of
+ * Hyperscan, so that a database is never loaded on a platform it was not
+ * compiled for. On Windows, where mmap() is not available, files are read
+ * in a buffer instead.
+ */
+
+// #ifndef HS_CACHE_H_
+// #define HS_CACHE_H_
+
+// #include <atomic>
+// #include <errno.h>
+// #include <fcntl.h>
+// #include <new>
+// #include <stdio.h>
+// #include <stdlib.h>
+// #include <string.h>
+// #include <string>
+// #include <sys/stat.h>
+// #include <sys/types.h>
+// #ifdef _WIN32
+// #include <direct.h>
+// #include <io.h>
+// #include <process.h>
+// #else
+// #include <sys/mman.h>
+// #include <unistd.h>
+// #endif
+// #include "hs/hs.h"
+// Targeting ../hs_cache.java
+
+
+// Targeting ../hs_cache_t.java
+
+
+
+/**
+ * Open a cache of compiled databases in a directory, which gets created if it
+ * does not exist.
+ *
+ * @param directory
+ *      The directory where serialized databases are stored.
+ *
+ * @param alloc_func
+ *      The function used to allocate databases read from the cache, or NULL
+ *      for malloc(). It must match the one passed to \ref
+ *      hs_set_database_allocator(), if any, so that all databases returned can
+ *      be released with \ref hs_free_database().
+ *
+ * @param free_func
+ *      The matching function to free memory, or NULL for free().
+ *
+ * @param cache
+ *      On success, a pointer to the new cache; NULL on failure.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure.
+ */
+public static native @Cast("hs_error_t") int hs_cache_open(@Cast("const char*") BytePointer directory, hs_alloc_t alloc_func, hs_free_t free_func,
+                                @Cast("hs_cache_t**") PointerPointer cache);
+public static native @Cast("hs_error_t") int hs_cache_open(@Cast("const char*") BytePointer directory, hs_alloc_t alloc_func, hs_free_t free_func,
+                                @ByPtrPtr hs_cache_t cache);
+public static native @Cast("hs_error_t") int hs_cache_open(String directory, hs_alloc_t alloc_func, hs_free_t free_func,
+                                @ByPtrPtr hs_cache_t cache);
+
+/**
+ * Free a cache. The files and the databases obtained from it are left untouched.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure.
+ */
+public static native @Cast("hs_error_t") int hs_cache_close(hs_cache_t cache);
+
+/**
+ * Returns the number of databases loaded from the cache.
+ */
+public static native @Cast("unsigned long long") long hs_cache_hits(@Const hs_cache_t cache);
+
+/**
+ * Returns the number of databases that had to be compiled.
+ */
+public static native @Cast("unsigned long long") long hs_cache_misses(@Const hs_cache_t cache);
+
+/**
+ * Get a database for the given patterns from the cache, or compile it with
+ * \ref hs_compile_multi() and add it to the cache. The parameters and the
+ * return value are the same as for \ref hs_compile_multi(), and the database
+ * returned must be freed with \ref hs_free_database() in both cases. Files
+ * that cannot be read or deserialized are compiled and written again, and
+ * failures to write are ignored. This function may be called from any number
+ * of threads and processes at the same time.
+ *
+ * @param cache
+ *      A cache opened with \ref hs_cache_open().
+ */
+public static native @Cast("hs_error_t") int hs_cache_compile_multi(hs_cache_t cache, @Cast("const char*const*") PointerPointer expressions,
+                                         @Cast("const unsigned int*") IntPointer flags, @Cast("const unsigned int*") IntPointer ids,
+                                         @Cast("unsigned int") int elements, @Cast("unsigned int") int mode,
+                                         @Const hs_platform_info_t platform,
+                                         @Cast("hs_database_t**") PointerPointer db, @Cast("hs_compile_error_t**") PointerPointer error);
+public static native @Cast("hs_error_t") int hs_cache_compile_multi(hs_cache_t cache, @Cast("const char*const*") @ByPtrPtr BytePointer expressions,
+                                         @Cast("const unsigned int*") IntPointer flags, @Cast("const unsigned int*") IntPointer ids,
+                                         @Cast("unsigned int") int elements, @Cast("unsigned int") int mode,
+                                         @Const hs_platform_info_t platform,
+                                         @ByPtrPtr hs_database_t db, @ByPtrPtr hs_compile_error_t error);
+public static native @Cast("hs_error_t") int hs_cache_compile_multi(hs_cache_t cache, @Cast("const char*const*") @ByPtrPtr ByteBuffer expressions,
+                                         @Cast("const unsigned int*") IntBuffer flags, @Cast("const unsigned int*") IntBuffer ids,
+                                         @Cast("unsigned int") int elements, @Cast("unsigned int") int mode,
+                                         @Const hs_platform_info_t platform,
+                                         @ByPtrPtr hs_database_t db, @ByPtrPtr hs_compile_error_t error);
+public static native @Cast("hs_error_t") int hs_cache_compile_multi(hs_cache_t cache, @Cast("const char*const*") @ByPtrPtr byte[] expressions,
+                                         @Cast("const unsigned int*") int[] flags, @Cast("const unsigned int*") int[] ids,
+                                         @Cast("unsigned int") int elements, @Cast("unsigned int") int mode,
+                                         @Const hs_platform_info_t platform,
+                                         @ByPtrPtr hs_database_t db, @ByPtrPtr hs_compile_error_t error);
+
+// #endif /* HS_CACHE_H_ */
+
+
 }
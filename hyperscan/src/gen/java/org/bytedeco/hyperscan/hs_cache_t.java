@@ -0,0 +1,23 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.hyperscan;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.hyperscan.global.hyperscan.*;
+
+
+/**
+ * A cache of compiled databases, created with \ref hs_cache_open().
+ */
+@Opaque @Properties(inherit = org.bytedeco.hyperscan.presets.hyperscan.class)
+public class hs_cache_t extends Pointer {
+    /** Empty constructor. Calls {@code super((Pointer)null)}. */
+    public hs_cache_t() { super((Pointer)null); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public hs_cache_t(Pointer p) { super(p); }
+}
@@ -0,0 +1,43 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.hyperscan;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.hyperscan.global.hyperscan.*;
+
+
+/**
+ * A match collected by the engine, in the order reported by Hyperscan.
+ */
+@Properties(inherit = org.bytedeco.hyperscan.presets.hyperscan.class)
+public class hs_engine_match_t extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public hs_engine_match_t() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public hs_engine_match_t(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public hs_engine_match_t(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public hs_engine_match_t position(long position) {
+        return (hs_engine_match_t)super.position(position);
+    }
+    @Override public hs_engine_match_t getPointer(long i) {
+        return new hs_engine_match_t((Pointer)this).offsetAddress(i);
+    }
+
+    /** The ID of the pattern that matched. */
+    public native @Cast("unsigned int") int id(); public native hs_engine_match_t id(int setter);
+
+    /** The offset of the start of the match, if HS_FLAG_SOM_LEFTMOST was used, or 0. */
+    public native @Cast("unsigned long long") long from(); public native hs_engine_match_t from(long setter);
+
+    /** The offset of the end of the match. */
+    public native @Cast("unsigned long long") long to(); public native hs_engine_match_t to(long setter);
+}
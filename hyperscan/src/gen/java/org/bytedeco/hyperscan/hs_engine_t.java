@@ -0,0 +1,23 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.hyperscan;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.hyperscan.global.hyperscan.*;
+
+
+/**
+ * A scanning engine, created with \ref hs_engine_create().
+ */
+@Opaque @Properties(inherit = org.bytedeco.hyperscan.presets.hyperscan.class)
+public class hs_engine_t extends Pointer {
+    /** Empty constructor. Calls {@code super((Pointer)null)}. */
+    public hs_engine_t() { super((Pointer)null); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public hs_engine_t(Pointer p) { super(p); }
+}
@@ -36,7 +36,7 @@ import org.bytedeco.javacpp.tools.InfoMapper;
         @Platform(
             value = {"linux-x86_64", "macosx-x86_64", "windows-x86_64"},
             compiler = "cpp11",
-            include = {"hs/hs_common.h", "hs/hs_compile.h", "hs/hs_runtime.h", "hs/hs.h"},
+            include = {"hs/hs_common.h", "hs/hs_compile.h", "hs/hs_runtime.h", "hs/hs.h", "hs_engine.h", "hs_cache.h"},
             link = {"hs@.5", "hs_runtime@.5"}
         )
     },
@@ -47,6 +47,8 @@ public class hyperscan implements InfoMapper {
     static { Loader.checkVersion("org.bytedeco", "hyperscan"); }
 
     public void map(InfoMap infoMap) {
-        infoMap.put(new Info("HS_CDECL").cppTypes().annotations());
+        infoMap.put(new Info("HS_CDECL").cppTypes().annotations())
+               .put(new Info("hs_engine.h").linePatterns("^#ifndef HS_ENGINE_PRIVATE_H$", "^#endif /\\* HS_ENGINE_PRIVATE_H \\*/$").skip())
+               .put(new Info("hs_cache.h").linePatterns("^#ifndef HS_CACHE_PRIVATE_H$", "^#endif /\\* HS_CACHE_PRIVATE_H \\*/$").skip());
     }
 }
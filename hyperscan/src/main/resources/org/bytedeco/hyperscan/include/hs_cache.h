@@ -0,0 +1,320 @@
+/*
+ * On-disk cache of compiled pattern databases.
+ *
+ * An hs_cache_t compiles sets of patterns with hs_compile_multi() the first
+ * time they are seen, serializes the databases with hs_serialize_database()
+ * in a directory, and on later calls, even from other processes, maps the
+ * files in memory and deserializes them with hs_deserialize_database_at()
+ * instead of compiling again. Files are named after a hash of the patterns,
+ * their flags and ids, the mode, the target platform, and the version of
+ * Hyperscan, so that a database is never loaded on a platform it was not
+ * compiled for. On Windows, where mmap() is not available, files are read
+ * in a buffer instead.
+ */
+
+#ifndef HS_CACHE_H_
+#define HS_CACHE_H_
+
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifdef _WIN32
+#include <direct.h>
+#include <io.h>
+#include <process.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include "hs/hs.h"
+
+/**
+ * A cache of compiled databases, created with \ref hs_cache_open().
+ */
+typedef struct hs_cache hs_cache_t;
+
+#ifndef HS_CACHE_PRIVATE_H
+#define HS_CACHE_PRIVATE_H
+
+struct hs_cache {
+    std::string directory;
+    hs_alloc_t allocFunc;
+    hs_free_t freeFunc;
+    std::atomic<unsigned long long> hits, misses, temporaries;
+};
+
+/* two independent 64-bit hashes, FNV-1a and a multiply-rotate one, for a 128-bit key */
+struct hs_cache_hash {
+    unsigned long long h1, h2;
+
+    void update(const void* data, size_t length) {
+        const unsigned char* p = (const unsigned char*)data;
+        for (size_t i = 0; i < length; i++) {
+            h1 = (h1 ^ p[i]) * 0x100000001b3ULL;
+            h2 = h2 ^ p[i];
+            h2 = ((h2 << 23) | (h2 >> 41)) * 0x9e3779b97f4a7c15ULL;
+        }
+    }
+
+    void update(unsigned long long value) {
+        unsigned char bytes[8];
+        for (int i = 0; i < 8; i++) {
+            bytes[i] = (unsigned char)(value >> (8 * i));
+        }
+        update(bytes, sizeof(bytes));
+    }
+};
+
+static std::string hs_cache_path(const hs_cache_t* cache, const char* const* expressions,
+        const unsigned int* flags, const unsigned int* ids, unsigned int elements,
+        unsigned int mode, const hs_platform_info_t* platform) {
+    hs_cache_hash h = { 0xcbf29ce484222325ULL, 0x2545f4914f6cdd1dULL };
+    const char* version = hs_version();
+    h.update(version, strlen(version) + 1);
+    h.update(platform->tune);
+    h.update(platform->cpu_features);
+    h.update(mode);
+    h.update(elements);
+    for (unsigned int i = 0; i < elements; i++) {
+        h.update(expressions[i], strlen(expressions[i]) + 1);
+        h.update(flags != NULL ? flags[i] : 0);
+        h.update(ids != NULL ? ids[i] : 0);
+    }
+    char name[40];
+    snprintf(name, sizeof(name), "%016llx%016llx.hsdb", h.h1, h.h2);
+    return cache->directory + "/" + name;
+}
+
+/* returns HS_SUCCESS with a database read from the file, or another value if it is missing or unusable */
+static hs_error_t hs_cache_load(hs_cache_t* cache, const std::string& path, hs_database_t** db) {
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+#endif
+    if (fd < 0) {
+        return HS_INVALID;
+    }
+    hs_error_t err = HS_INVALID;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        size_t length = (size_t)st.st_size;
+#ifdef _WIN32
+        char* bytes = (char*)malloc(length);
+        if (bytes != NULL && _read(fd, bytes, (unsigned int)length) != (int)length) {
+            free(bytes);
+            bytes = NULL;
+        }
+#else
+        char* bytes = (char*)mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (bytes == MAP_FAILED) {
+            bytes = NULL;
+        }
+#endif
+        size_t size = 0;
+        if (bytes != NULL && (err = hs_serialized_database_size(bytes, length, &size)) == HS_SUCCESS) {
+            void* p = cache->allocFunc(size);
+            err = p != NULL ? hs_deserialize_database_at(bytes, length, (hs_database_t*)p) : HS_NOMEM;
+            if (err == HS_SUCCESS) {
+                *db = (hs_database_t*)p;
+            } else if (p != NULL) {
+                cache->freeFunc(p);
+            }
+        }
+#ifdef _WIN32
+        free(bytes);
+#else
+        if (bytes != NULL) {
+            munmap(bytes, length);
+        }
+#endif
+    }
+#ifdef _WIN32
+    _close(fd);
+#else
+    close(fd);
+#endif
+    return err;
+}
+
+/* writes the database to a temporary file renamed into place, so that readers never see partial files */
+static void hs_cache_store(hs_cache_t* cache, const std::string& path, const hs_database_t* db) {
+    char* bytes = NULL;
+    size_t length = 0;
+    if (hs_serialize_database(db, &bytes, &length) != HS_SUCCESS) {
+        return;
+    }
+    char suffix[64];
+#ifdef _WIN32
+    snprintf(suffix, sizeof(suffix), ".%d.%llu.tmp", _getpid(), cache->temporaries++);
+    std::string temp = path + suffix;
+    int fd = _open(temp.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    snprintf(suffix, sizeof(suffix), ".%d.%llu.tmp", (int)getpid(), cache->temporaries++);
+    std::string temp = path + suffix;
+    int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+#endif
+    if (fd >= 0) {
+        size_t written = 0;
+        while (written < length) {
+#ifdef _WIN32
+            int n = _write(fd, bytes + written, (unsigned int)(length - written));
+#else
+            ssize_t n = write(fd, bytes + written, length - written);
+#endif
+            if (n <= 0) {
+                break;
+            }
+            written += (size_t)n;
+        }
+#ifdef _WIN32
+        _close(fd);
+        if (written == length) {
+            remove(path.c_str());
+        }
+#else
+        close(fd);
+#endif
+        if (written != length || rename(temp.c_str(), path.c_str()) != 0) {
+            remove(temp.c_str());
+        }
+    }
+    free(bytes); /* allocated with the default misc allocator */
+}
+
+#endif /* HS_CACHE_PRIVATE_H */
+
+/**
+ * Open a cache of compiled databases in a directory, which gets created if it
+ * does not exist.
+ *
+ * @param directory
+ *      The directory where serialized databases are stored.
+ *
+ * @param alloc_func
+ *      The function used to allocate databases read from the cache, or NULL
+ *      for malloc(). It must match the one passed to \ref
+ *      hs_set_database_allocator(), if any, so that all databases returned can
+ *      be released with \ref hs_free_database().
+ *
+ * @param free_func
+ *      The matching function to free memory, or NULL for free().
+ *
+ * @param cache
+ *      On success, a pointer to the new cache; NULL on failure.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure.
+ */
+inline hs_error_t hs_cache_open(const char* directory, hs_alloc_t alloc_func, hs_free_t free_func,
+                                hs_cache_t** cache) {
+    if (directory == NULL || cache == NULL || (alloc_func == NULL) != (free_func == NULL)) {
+        return HS_INVALID;
+    }
+    *cache = NULL;
+#ifdef _WIN32
+    _mkdir(directory);
+#else
+    mkdir(directory, 0777);
+#endif
+    struct stat st;
+    if (stat(directory, &st) != 0 || (st.st_mode & S_IFMT) != S_IFDIR) {
+        return HS_INVALID;
+    }
+    hs_cache_t* c = new (std::nothrow) hs_cache_t();
+    if (c == NULL) {
+        return HS_NOMEM;
+    }
+    c->directory = directory;
+    c->allocFunc = alloc_func != NULL ? alloc_func : malloc;
+    c->freeFunc = free_func != NULL ? free_func : free;
+    c->hits = 0;
+    c->misses = 0;
+    c->temporaries = 0;
+    *cache = c;
+    return HS_SUCCESS;
+}
+
+/**
+ * Free a cache. The files and the databases obtained from it are left untouched.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure.
+ */
+inline hs_error_t hs_cache_close(hs_cache_t* cache) {
+    delete cache;
+    return HS_SUCCESS;
+}
+
+/**
+ * Returns the number of databases loaded from the cache.
+ */
+inline unsigned long long hs_cache_hits(const hs_cache_t* cache) {
+    return cache != NULL ? cache->hits.load() : 0;
+}
+
+/**
+ * Returns the number of databases that had to be compiled.
+ */
+inline unsigned long long hs_cache_misses(const hs_cache_t* cache) {
+    return cache != NULL ? cache->misses.load() : 0;
+}
+
+/**
+ * Get a database for the given patterns from the cache, or compile it with
+ * \ref hs_compile_multi() and add it to the cache. The parameters and the
+ * return value are the same as for \ref hs_compile_multi(), and the database
+ * returned must be freed with \ref hs_free_database() in both cases. Files
+ * that cannot be read or deserialized are compiled and written again, and
+ * failures to write are ignored. This function may be called from any number
+ * of threads and processes at the same time.
+ *
+ * @param cache
+ *      A cache opened with \ref hs_cache_open().
+ */
+inline hs_error_t hs_cache_compile_multi(hs_cache_t* cache, const char* const* expressions,
+                                         const unsigned int* flags, const unsigned int* ids,
+                                         unsigned int elements, unsigned int mode,
+                                         const hs_platform_info_t* platform,
+                                         hs_database_t** db, hs_compile_error_t** error) {
+    if (cache == NULL || db == NULL || (elements > 0 && expressions == NULL)) {
+        return HS_INVALID;
+    }
+    for (unsigned int i = 0; i < elements; i++) {
+        if (expressions[i] == NULL) {
+            /* let hs_compile_multi() report the error */
+            return hs_compile_multi(expressions, flags, ids, elements, mode, platform, db, error);
+        }
+    }
+    hs_platform_info_t host;
+    if (platform == NULL) {
+        hs_error_t err = hs_populate_platform(&host);
+        if (err != HS_SUCCESS) {
+            return err;
+        }
+        platform = &host;
+    }
+    std::string path = hs_cache_path(cache, expressions, flags, ids, elements, mode, platform);
+    if (hs_cache_load(cache, path, db) == HS_SUCCESS) {
+        if (error != NULL) {
+            *error = NULL;
+        }
+        cache->hits++;
+        return HS_SUCCESS;
+    }
+    cache->misses++;
+    hs_error_t err = hs_compile_multi(expressions, flags, ids, elements, mode, platform, db, error);
+    if (err == HS_SUCCESS) {
+        hs_cache_store(cache, path, *db);
+    }
+    return err;
+}
+
+#endif /* HS_CACHE_H_ */
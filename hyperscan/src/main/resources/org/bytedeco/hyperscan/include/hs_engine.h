@@ -0,0 +1,337 @@
+/*
+ * Multithreaded block and stream scanning over a single compiled database.
+ *
+ * An hs_engine_t keeps a pool of scratch spaces cloned from a prototype with
+ * hs_clone_scratch(), so that any number of threads can scan at the same time
+ * without sharing a scratch or taking a lock. Each call scans a batch of
+ * buffers packed one after the other, and matches are collected natively into
+ * an array of hs_engine_match_t, instead of calling back into Java per match.
+ */
+
+#ifndef HS_ENGINE_H_
+#define HS_ENGINE_H_
+
+#include <atomic>
+#include <functional>
+#include <limits.h>
+#include <stdint.h>
+#include <new>
+#include <thread>
+#include "hs/hs.h"
+
+/**
+ * A scanning engine, created with \ref hs_engine_create().
+ */
+typedef struct hs_engine hs_engine_t;
+
+/**
+ * A match collected by the engine, in the order reported by Hyperscan.
+ */
+typedef struct hs_engine_match {
+    /** The ID of the pattern that matched. */
+    unsigned int id;
+
+    /** The offset of the start of the match, if HS_FLAG_SOM_LEFTMOST was used, or 0. */
+    unsigned long long from;
+
+    /** The offset of the end of the match. */
+    unsigned long long to;
+} hs_engine_match_t;
+
+#ifndef HS_ENGINE_PRIVATE_H
+#define HS_ENGINE_PRIVATE_H
+
+struct alignas(64) hs_engine_slot { /* one cache line per slot */
+    enum { EMPTY, FREE, BUSY };
+    std::atomic<int> state;
+    hs_scratch_t* scratch;
+};
+
+struct hs_engine {
+    const hs_database_t* db;
+    hs_scratch_t* prototype;
+    unsigned int size;
+    hs_engine_slot* slots;
+    void* memory; /* of the slots, since operator new[] ignores alignas() before C++17 */
+
+    /* takes a free scratch, starting from the slot last used by this thread,
+     * clones a new one in an empty slot if all are busy, or else waits */
+    hs_error_t acquire(unsigned int* index) {
+        static thread_local unsigned int hint = (unsigned int)std::hash<std::thread::id>()(std::this_thread::get_id());
+        for (;;) {
+            for (unsigned int i = 0; i < size; i++) {
+                unsigned int j = (hint + i) % size;
+                int expected = hs_engine_slot::FREE;
+                if (slots[j].state.load(std::memory_order_relaxed) == expected
+                        && slots[j].state.compare_exchange_strong(expected, hs_engine_slot::BUSY, std::memory_order_acquire)) {
+                    *index = hint = j;
+                    return HS_SUCCESS;
+                }
+            }
+            for (unsigned int i = 0; i < size; i++) {
+                unsigned int j = (hint + i) % size;
+                int expected = hs_engine_slot::EMPTY;
+                if (slots[j].state.load(std::memory_order_relaxed) == expected
+                        && slots[j].state.compare_exchange_strong(expected, hs_engine_slot::BUSY, std::memory_order_acquire)) {
+                    /* the prototype is never used for scanning, so it may be cloned concurrently */
+                    hs_error_t err = hs_clone_scratch(prototype, &slots[j].scratch);
+                    if (err != HS_SUCCESS) {
+                        slots[j].state.store(hs_engine_slot::EMPTY, std::memory_order_release);
+                        return err;
+                    }
+                    *index = hint = j;
+                    return HS_SUCCESS;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    void release(unsigned int index) {
+        slots[index].state.store(hs_engine_slot::FREE, std::memory_order_release);
+    }
+};
+
+struct hs_engine_collector {
+    hs_engine_match_t* matches;
+    unsigned int maxMatches;
+    unsigned long long count;
+};
+
+static int HS_CDECL hs_engine_collect(unsigned int id, unsigned long long from,
+                                      unsigned long long to, unsigned int flags, void* context) {
+    hs_engine_collector* c = (hs_engine_collector*)context;
+    if (c->count < c->maxMatches) {
+        hs_engine_match_t& m = c->matches[c->count];
+        m.id = id;
+        m.from = from;
+        m.to = to;
+    }
+    c->count++;
+    return 0; /* keep counting even when the array is full */
+}
+
+/* calls scan(i, scratch, collector) for each of the count buffers with a scratch from the pool */
+template<typename F> static hs_error_t hs_engine_run(hs_engine_t* engine, unsigned int count,
+        hs_engine_match_t* matches, unsigned int maxMatches, unsigned int* matchCounts,
+        unsigned long long* totalMatches, F scan) {
+    if (engine == NULL || (matches == NULL && maxMatches > 0)) {
+        return HS_INVALID;
+    }
+    unsigned int index;
+    hs_error_t err = engine->acquire(&index);
+    if (err != HS_SUCCESS) {
+        return err;
+    }
+    hs_scratch_t* scratch = engine->slots[index].scratch;
+    hs_engine_collector c = { matches, maxMatches, 0 };
+    for (unsigned int i = 0; i < count && err == HS_SUCCESS; i++) {
+        unsigned long long stored = c.count < maxMatches ? c.count : maxMatches;
+        err = scan(i, scratch, &c);
+        if (matchCounts != NULL) {
+            matchCounts[i] = (unsigned int)((c.count < maxMatches ? c.count : maxMatches) - stored);
+        }
+    }
+    engine->release(index);
+    if (totalMatches != NULL) {
+        *totalMatches = c.count;
+    }
+    return err;
+}
+
+#endif /* HS_ENGINE_PRIVATE_H */
+
+/**
+ * Create a scanning engine for a compiled pattern database.
+ *
+ * @param db
+ *      A compiled pattern database, which must outlive the engine.
+ *
+ * @param maxScratches
+ *      The maximum number of scratch spaces to clone, which is the number of
+ *      calls that may scan at the same time, or 0 for the number of hardware
+ *      threads. Scratch spaces are cloned on demand, and further calls wait
+ *      for one to be released.
+ *
+ * @param engine
+ *      On success, a pointer to the new engine; NULL on failure.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure.
+ */
+inline hs_error_t hs_engine_create(const hs_database_t* db, unsigned int maxScratches, hs_engine_t** engine) {
+    if (db == NULL || engine == NULL) {
+        return HS_INVALID;
+    }
+    *engine = NULL;
+    if (maxScratches == 0) {
+        maxScratches = std::thread::hardware_concurrency();
+    }
+    if (maxScratches == 0) {
+        maxScratches = 1;
+    }
+    hs_engine_t* e = new (std::nothrow) hs_engine_t();
+    if (e == NULL) {
+        return HS_NOMEM;
+    }
+    e->db = db;
+    e->prototype = NULL;
+    e->size = maxScratches;
+    e->memory = ::operator new(maxScratches * sizeof(hs_engine_slot) + alignof(hs_engine_slot) - 1, std::nothrow);
+    if (e->memory == NULL) {
+        delete e;
+        return HS_NOMEM;
+    }
+    e->slots = (hs_engine_slot*)(((uintptr_t)e->memory + alignof(hs_engine_slot) - 1) & ~(uintptr_t)(alignof(hs_engine_slot) - 1));
+    for (unsigned int i = 0; i < maxScratches; i++) {
+        new (&e->slots[i]) hs_engine_slot();
+        e->slots[i].state = hs_engine_slot::EMPTY;
+        e->slots[i].scratch = NULL;
+    }
+    hs_error_t err = hs_alloc_scratch(db, &e->prototype);
+    if (err != HS_SUCCESS) {
+        ::operator delete(e->memory);
+        delete e;
+        return err;
+    }
+    *engine = e;
+    return HS_SUCCESS;
+}
+
+/**
+ * Free an engine and all of its scratch spaces. It must not be in use.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure.
+ */
+inline hs_error_t hs_engine_destroy(hs_engine_t* engine) {
+    if (engine == NULL) {
+        return HS_SUCCESS;
+    }
+    hs_error_t err = hs_free_scratch(engine->prototype);
+    for (unsigned int i = 0; i < engine->size; i++) {
+        hs_error_t err2 = hs_free_scratch(engine->slots[i].scratch);
+        if (err == HS_SUCCESS) {
+            err = err2;
+        }
+    }
+    ::operator delete(engine->memory);
+    delete engine;
+    return err;
+}
+
+/**
+ * Returns the number of scratch spaces cloned so far, which is at most the
+ * number of calls that have been scanning at the same time.
+ */
+inline unsigned int hs_engine_scratch_count(const hs_engine_t* engine) {
+    unsigned int n = 0;
+    for (unsigned int i = 0; engine != NULL && i < engine->size; i++) {
+        n += engine->slots[i].state.load(std::memory_order_relaxed) != hs_engine_slot::EMPTY;
+    }
+    return n;
+}
+
+/**
+ * Scan a batch of buffers in block mode. This function may be called from
+ * any number of threads at the same time.
+ *
+ * @param engine
+ *      An engine created for a database compiled with \ref HS_MODE_BLOCK.
+ *
+ * @param data
+ *      The buffers, packed one after the other.
+ *
+ * @param offsets
+ *      An array of count + 1 offsets, such that buffer i is the range
+ *      [offsets[i], offsets[i + 1]) of data.
+ *
+ * @param count
+ *      The number of buffers.
+ *
+ * @param matches
+ *      An array receiving up to maxMatches matches, grouped by buffer in order.
+ *
+ * @param maxMatches
+ *      The capacity of the matches array.
+ *
+ * @param matchCounts
+ *      An array of count elements receiving the number of matches stored for
+ *      each buffer, or NULL.
+ *
+ * @param totalMatches
+ *      Receives the number of matches found, which exceeds maxMatches when
+ *      some did not fit in the array, or NULL.
+ *
+ * @return
+ *      \ref HS_SUCCESS on success, other values on failure, in which case
+ *      buffers after the failing one are not scanned.
+ */
+inline hs_error_t hs_engine_scan(hs_engine_t* engine, const char* data, const unsigned long long* offsets,
+                                 unsigned int count, hs_engine_match_t* matches, unsigned int maxMatches,
+                                 unsigned int* matchCounts, unsigned long long* totalMatches) {
+    if (count > 0 && (data == NULL || offsets == NULL)) {
+        return HS_INVALID;
+    }
+    return hs_engine_run(engine, count, matches, maxMatches, matchCounts, totalMatches,
+            [&](unsigned int i, hs_scratch_t* scratch, hs_engine_collector* c) -> hs_error_t {
+                if (offsets[i + 1] < offsets[i] || offsets[i + 1] - offsets[i] > UINT_MAX) {
+                    return HS_INVALID;
+                }
+                return hs_scan(engine->db, data + offsets[i], (unsigned int)(offsets[i + 1] - offsets[i]),
+                               0, scratch, hs_engine_collect, c);
+            });
+}
+
+/**
+ * Write a batch of buffers to streams opened with \ref hs_open_stream() on the
+ * database of the engine. This function may be called from any number of
+ * threads at the same time, as long as each stream is used by only one of them.
+ *
+ * @param streams
+ *      An array of count distinct streams, where buffer i is written to stream i.
+ *
+ * The other parameters and the return value are as for \ref hs_engine_scan(),
+ * with match offsets relative to the start of each stream.
+ */
+inline hs_error_t hs_engine_scan_streams(hs_engine_t* engine, hs_stream_t** streams, const char* data,
+                                         const unsigned long long* offsets, unsigned int count,
+                                         hs_engine_match_t* matches, unsigned int maxMatches,
+                                         unsigned int* matchCounts, unsigned long long* totalMatches) {
+    if (count > 0 && (streams == NULL || data == NULL || offsets == NULL)) {
+        return HS_INVALID;
+    }
+    return hs_engine_run(engine, count, matches, maxMatches, matchCounts, totalMatches,
+            [&](unsigned int i, hs_scratch_t* scratch, hs_engine_collector* c) -> hs_error_t {
+                if (offsets[i + 1] < offsets[i] || offsets[i + 1] - offsets[i] > UINT_MAX) {
+                    return HS_INVALID;
+                }
+                return hs_scan_stream(streams[i], data + offsets[i], (unsigned int)(offsets[i + 1] - offsets[i]),
+                                      0, scratch, hs_engine_collect, c);
+            });
+}
+
+/**
+ * Close a batch of streams, collecting the matches raised at end of data, and
+ * free them. Elements of streams that are NULL are skipped.
+ *
+ * The other parameters and the return value are as for \ref hs_engine_scan().
+ */
+inline hs_error_t hs_engine_close_streams(hs_engine_t* engine, hs_stream_t** streams, unsigned int count,
+                                          hs_engine_match_t* matches, unsigned int maxMatches,
+                                          unsigned int* matchCounts, unsigned long long* totalMatches) {
+    if (count > 0 && streams == NULL) {
+        return HS_INVALID;
+    }
+    return hs_engine_run(engine, count, matches, maxMatches, matchCounts, totalMatches,
+            [&](unsigned int i, hs_scratch_t* scratch, hs_engine_collector* c) -> hs_error_t {
+                if (streams[i] == NULL) {
+                    return HS_SUCCESS;
+                }
+                hs_error_t err = hs_close_stream(streams[i], scratch, hs_engine_collect, c);
+                streams[i] = NULL;
+                return err;
+            });
+}
+
+#endif /* HS_ENGINE_H_ */
@@ -0,0 +1,132 @@
+/*
+ * A pool of threads that all run the same job at once, for batch processing.
+ *
+ * This header is shared by the batch helpers of several presets, which find it
+ * in the include directory at the root of the repository, on the include path
+ * of all the presets. The owner of a pool documents its own reentrancy
+ * contract, since BatchPool::run() is not reentrant: it must not be called from
+ * two threads at once on the same pool, nor from within a job.
+ */
+
+#ifndef BYTEDECO_BATCH_POOL_H
+#define BYTEDECO_BATCH_POOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bytedeco {
+
+class BatchPool {
+public:
+    /* starts size - 1 threads, the thread calling run() being the other one,
+     * or throws std::system_error if they cannot all be started */
+    explicit BatchPool(int size) : generation_(0), running_(0), stop_(false), job_(NULL) {
+        try {
+            for (int i = 1; i < size; i++) {
+                threads_.push_back(std::thread(&BatchPool::loop, this, i));
+            }
+        } catch (...) {
+            shutdown();
+            throw;
+        }
+    }
+
+    ~BatchPool() { shutdown(); }
+
+    /* returns the number of threads, including the one calling run() */
+    int size() const { return (int)threads_.size() + 1; }
+
+    /* calls job(index) on every thread, with index 0 on the calling thread and
+     * from 1 to size() - 1 on the others, usually to take the items of a batch
+     * from a shared counter until none are left, and returns once all calls
+     * have returned, rethrowing the first exception that any of them threw */
+    void run(const std::function<void(int)> &job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &job;
+            error_ = std::exception_ptr();
+            running_ = (int)threads_.size();
+            generation_++;
+        }
+        wake_.notify_all();
+        call(job, 0);
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (running_ > 0) {
+                done_.wait(lock);
+            }
+            job_ = NULL;
+            error = error_;
+            error_ = std::exception_ptr();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    BatchPool(const BatchPool &);
+    BatchPool &operator=(const BatchPool &);
+
+    void call(const std::function<void(int)> &job, int index) {
+        try {
+            job(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+    }
+
+    void loop(int index) {
+        unsigned long seen = 0;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            while (!stop_ && seen == generation_) {
+                wake_.wait(lock);
+            }
+            if (stop_) {
+                return;
+            }
+            seen = generation_;
+            const std::function<void(int)> *job = job_;
+            lock.unlock();
+            call(*job, index);
+            lock.lock();
+            if (--running_ == 0) {
+                done_.notify_all();
+            }
+        }
+    }
+
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (size_t i = 0; i < threads_.size(); i++) {
+            threads_[i].join();
+        }
+        threads_.clear();
+    }
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_, done_;
+    unsigned long generation_;
+    int running_;
+    bool stop_;
+    const std::function<void(int)> *job_;
+    std::exception_ptr error_;
+};
+
+} // namespace bytedeco
+
+#endif /* BYTEDECO_BATCH_POOL_H */
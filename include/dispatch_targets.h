@@ -0,0 +1,38 @@
+/*
+ * Targets of kernels compiled for several instruction sets, for runtime dispatch.
+ *
+ * This header is shared by the presets that compile kernels for AVX2 and
+ * AVX-512 in addition to the baseline of the compiler flags, such as
+ * cpu_features_dispatch.h and cvkernels.h, which find it in the include
+ * directory at the root of the repository, on the include path of all the
+ * presets. Code between BYTEDECO_DISPATCH_BEGIN_<TARGET> and
+ * BYTEDECO_DISPATCH_END gets compiled for the target, which is only available
+ * when BYTEDECO_DISPATCH_HAVE_<TARGET> is defined, that is with GCC and Clang
+ * on x86, as MSVC cannot change the target of a function. Selecting the
+ * variant supported by the host is left to the kernels.
+ */
+
+#ifndef BYTEDECO_DISPATCH_TARGETS_H
+#define BYTEDECO_DISPATCH_TARGETS_H
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__clang__)
+#if defined(__has_extension) && __has_extension(pragma_clang_attribute)
+#define BYTEDECO_DISPATCH_HAVE_AVX2 1
+#define BYTEDECO_DISPATCH_HAVE_AVX512 1
+#define BYTEDECO_DISPATCH_BEGIN_AVX2 \
+    _Pragma("clang attribute push(__attribute__((target(\"avx,avx2,fma\"))), apply_to = function)")
+#define BYTEDECO_DISPATCH_BEGIN_AVX512 \
+    _Pragma("clang attribute push(__attribute__((target(\"avx,avx2,fma,avx512f,avx512cd,avx512bw,avx512dq,avx512vl\"))), apply_to = function)")
+#define BYTEDECO_DISPATCH_END _Pragma("clang attribute pop")
+#endif
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && __GNUC__ >= 5
+#define BYTEDECO_DISPATCH_HAVE_AVX2 1
+#define BYTEDECO_DISPATCH_HAVE_AVX512 1
+#define BYTEDECO_DISPATCH_BEGIN_AVX2 \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avx,avx2,fma\")")
+#define BYTEDECO_DISPATCH_BEGIN_AVX512 \
+    _Pragma("GCC push_options") _Pragma("GCC target(\"avx,avx2,fma,avx512f,avx512cd,avx512bw,avx512dq,avx512vl\")")
+#define BYTEDECO_DISPATCH_END _Pragma("GCC pop_options")
+#endif
+
+#endif /* BYTEDECO_DISPATCH_TARGETS_H */
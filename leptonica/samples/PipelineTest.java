@@ -0,0 +1,64 @@
+import java.io.File;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.leptonica.*;
+import static org.bytedeco.leptonica.global.leptonica.*;
+
+/**
+ * Preprocesses a batch of document images for OCR with a single native call per
+ * batch, on all the cores, and with the intermediate images recycled by the
+ * threads of the pipeline from one batch to the next.
+ *
+ * Usage: PipelineTest outdir image1 [image2 ...]
+ */
+public class PipelineTest {
+    static final String OPERATIONS = "gray; add_border 16 255; background_norm; unsharp 1 0.3; sauvola 16 0.34; deskew; remove_border 16";
+
+    public static void main(String[] args) {
+        if (args.length < 2) {
+            System.err.println("Usage: PipelineTest outdir image1 [image2 ...]");
+            System.exit(1);
+        }
+        File outdir = new File(args[0]);
+        outdir.mkdirs();
+        int n = args.length - 1;
+
+        SARRAY files = sarrayCreate(n);
+        for (int i = 0; i < n; i++) {
+            sarrayAddString(files, args[i + 1], L_COPY);
+        }
+        L_PIPELINE pipeline = pipelineCreate(OPERATIONS, 0);
+        if (pipeline == null) {
+            System.exit(1);
+        }
+        System.out.println("Running \"" + OPERATIONS + "\" on " + pipelineGetThreadCount(pipeline) + " threads");
+
+        PointerPointer<PIX> pixs = new PointerPointer<PIX>(n);
+        for (int round = 1; round <= 5; round++) {
+            long start = System.nanoTime();
+            int done = pipelineRunFiles(pipeline, files, pixs);
+            double seconds = (System.nanoTime() - start) / 1e9;
+
+            long[] cached = {0}, hits = {0}, misses = {0};
+            pipelineGetPoolStats(pipeline, cached, hits, misses);
+            System.out.printf("Round %d: %d/%d images in %.3f s, pool: %d hits, %d misses, %d MB cached%n",
+                    round, done, n, seconds, hits[0], misses[0], cached[0] >> 20);
+
+            for (int i = 0; i < n; i++) {
+                PIX pix = pixs.get(PIX.class, i);
+                if (pix == null) {
+                    System.err.println("Failed to process " + args[i + 1]);
+                    continue;
+                }
+                if (round == 5) {
+                    String name = new File(args[i + 1]).getName().replaceFirst("\\.[^.]*$", "") + ".png";
+                    pixWrite(new File(outdir, name).getPath(), pix, IFF_PNG);
+                }
+                pixDestroy(pix);
+            }
+        }
+
+        // also destroys the spare images kept by the threads
+        pipelineDestroy(pipeline);
+        sarrayDestroy(files);
+    }
+}
@@ -0,0 +1,19 @@
+// Targeted by JavaCPP version 1.5.9-SNAPSHOT: DO NOT EDIT THIS FILE
+
+package org.bytedeco.leptonica;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.leptonica.global.leptonica.*;
+
+@Name("L_Pipeline") @Opaque @Properties(inherit = org.bytedeco.leptonica.presets.leptonica.class)
+public class L_PIPELINE extends Pointer {
+    /** Empty constructor. Calls {@code super((Pointer)null)}. */
+    public L_PIPELINE() { super((Pointer)null); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public L_PIPELINE(Pointer p) { super(p); }
+}
@@ -9162,4 +9162,223 @@ public static native @Cast("l_uint8*") byte[] zlibUncompress( @Cast("const l_uin
 
 
 
+// Parsed from pixpipeline.h
+
+/*
+ *  pixpipeline.h
+ *
+ *  Batched preprocessing of images on a pool of threads
+ *
+ *  An L_PIPELINE holds a list of operations, such as conversion to gray,
+ *  scaling, binarization and deskewing, given for example as the text
+ *      "gray; scale 0.5; sauvola 8 0.34; deskew"
+ *  and applies them to batches of images, or of files read with pixRead(),
+ *  with each thread of the pipeline, including the calling one, taking the
+ *  next image until none are left. The pipelineRun*() functions return once
+ *  the whole batch is done, and must not be called concurrently from two
+ *  threads on the same pipeline, which can however run batches one after
+ *  the other from any thread.
+ *
+ *  Each thread of a pipeline keeps the intermediate images it no longer
+ *  needs, up to pipelineSetMaxBytes(), and reuses them as destinations of
+ *  the operations that can write into an existing image of the right size
+ *  and depth, namely invert, rotate by 2 quads, add_border and remove_border,
+ *  while the other operations allocate their results as usual. The images
+ *  read from files or created by the pipeline get inverted in place. The
+ *  memory manager of Leptonica is left alone, so images outside of the
+ *  pipeline, including its results, are allocated and freed as usual, and
+ *  the spare images get freed by pipelineClearPool() or pipelineDestroy().
+ *
+ *  Operations, with their parameters and defaults:
+ *      gray                           pixConvertTo8()
+ *      scale  scalex [scaley]         pixScale(), with scaley = scalex when 0
+ *      scale_to_size  wd hd           pixScaleToSize()
+ *      background_norm                pixBackgroundNormSimple()
+ *      unsharp  [halfwidth fract]     pixUnsharpMasking(), 1 and 0.3
+ *      threshold  [thresh]            pixConvertTo1(), 128
+ *      otsu  [sx sy]                  pixOtsuAdaptiveThreshold(), whole image
+ *      sauvola  [whsize factor]       pixSauvolaBinarizeTiled(), 8 and 0.35
+ *      deskew  [redsearch]            pixDeskew(), 0 for the default
+ *      rotate  quads                  pixRotateOrth()
+ *      invert                         pixInvert()
+ *      add_border  npix [val]         pixAddBorder(), 0
+ *      remove_border  npix            pixRemoveBorder()
+ */
+
+// #ifndef LEPTONICA_PIXPIPELINE_H
+// #define LEPTONICA_PIXPIPELINE_H
+
+// #include "leptonica/allheaders.h"
+// #include "batch_pool.h"
+
+// #include <atomic>
+// #include <stdlib.h>
+// #include <string.h>
+// #include <thread>
+// #include <vector>
+
+/** Pipeline operations */
+/** enum  */
+public static final int
+    /** pixConvertTo8()                */
+    L_PIPELINE_GRAY = 1,
+    /** pixScale()                     */
+    L_PIPELINE_SCALE = 2,
+    /** pixScaleToSize()               */
+    L_PIPELINE_SCALE_TO_SIZE = 3,
+    /** pixBackgroundNormSimple()      */
+    L_PIPELINE_BACKGROUND_NORM = 4,
+    /** pixUnsharpMasking()            */
+    L_PIPELINE_UNSHARP = 5,
+    /** pixConvertTo1()                */
+    L_PIPELINE_THRESHOLD = 6,
+    /** pixOtsuAdaptiveThreshold()     */
+    L_PIPELINE_OTSU = 7,
+    /** pixSauvolaBinarizeTiled()      */
+    L_PIPELINE_SAUVOLA = 8,
+    /** pixDeskew()                    */
+    L_PIPELINE_DESKEW = 9,
+    /** pixRotateOrth()                */
+    L_PIPELINE_ROTATE = 10,
+    /** pixInvert()                    */
+    L_PIPELINE_INVERT = 11,
+    /** pixAddBorder()                 */
+    L_PIPELINE_ADD_BORDER = 12,
+    /** pixRemoveBorder()              */
+    L_PIPELINE_REMOVE_BORDER = 13;
+// Targeting ../L_PIPELINE.java
+
+
+
+/**
+ * \brief   pipelineSetMaxBytes()
+ *
+ * @param pl [in]
+ * @param maxbytes [in]    of spare images kept by each thread; default 64 MB
+ * @return  0 if OK, 1 on error
+ */
+public static native @Cast("l_ok") int pipelineSetMaxBytes(L_PIPELINE pl,
+                    @Cast("size_t") long maxbytes);
+
+/**
+ * \brief   pipelineGetPoolStats()
+ *
+ * @param pl [in]
+ * @param pcached [out]   [optional] bytes of spare images kept
+ * @param phits [out]       [optional] destinations taken from the spares
+ * @param pmisses [out]     [optional] destinations that needed a new image
+ * @return  0 if OK, 1 on error
+ */
+public static native @Cast("l_ok") int pipelineGetPoolStats(L_PIPELINE pl,
+                     @Cast("l_int64*") LongPointer pcached,
+                     @Cast("l_int64*") LongPointer phits,
+                     @Cast("l_int64*") LongPointer pmisses);
+public static native @Cast("l_ok") int pipelineGetPoolStats(L_PIPELINE pl,
+                     @Cast("l_int64*") LongBuffer pcached,
+                     @Cast("l_int64*") LongBuffer phits,
+                     @Cast("l_int64*") LongBuffer pmisses);
+public static native @Cast("l_ok") int pipelineGetPoolStats(L_PIPELINE pl,
+                     @Cast("l_int64*") long[] pcached,
+                     @Cast("l_int64*") long[] phits,
+                     @Cast("l_int64*") long[] pmisses);
+
+/**
+ * \brief   pipelineClearPool()
+ *
+ * @param pl [in]
+ *
+ *  Destroys all the spare images kept by the threads of the pipeline.
+ */
+public static native void pipelineClearPool(L_PIPELINE pl);
+
+/**
+ * \brief   pipelineAddOperation()
+ *
+ * @param pl [in]
+ * @param type [in]        L_PIPELINE_GRAY, ...
+ * @param param1 [in]      as listed at the top, or 0
+ * @param param2 [in]      as listed at the top, or 0
+ * @return  0 if OK, 1 on error
+ */
+public static native @Cast("l_ok") int pipelineAddOperation(L_PIPELINE pl,
+                     @Cast("l_int32") int type,
+                     @Cast("l_float32") float param1,
+                     @Cast("l_float32") float param2);
+
+/**
+ * \brief   pipelineDestroy()
+ *
+ * @param ppl [in,out]    will be set to null before returning
+ */
+public static native void pipelineDestroy(@Cast("L_PIPELINE**") PointerPointer ppl);
+public static native void pipelineDestroy(@ByPtrPtr L_PIPELINE ppl);
+
+/**
+ * \brief   pipelineCreate()
+ *
+ * @param ops [in]         [optional] operations separated by ';' or
+ *                           newlines, as listed at the top; can be null
+ * @param nthreads [in]    including the calling one; 0 for the number
+ *                           of hardware threads
+ * @return  pl, or NULL on error
+ */
+public static native L_PIPELINE pipelineCreate(@Cast("const char*") BytePointer ops,
+               @Cast("l_int32") int nthreads);
+public static native L_PIPELINE pipelineCreate(String ops,
+               @Cast("l_int32") int nthreads);
+
+/**
+ * \brief   pipelineGetThreadCount()
+ *
+ * @param pl [in]
+ * @return  number of threads, including the calling one
+ */
+public static native @Cast("l_int32") int pipelineGetThreadCount(L_PIPELINE pl);
+
+/**
+ * \brief   pipelineRun()
+ *
+ * @param pl [in]
+ * @param pixas [in]       array of n input images, left unchanged
+ * @param pixad [out]       array of n output images, null for the failed ones
+ * @param n [in]
+ * @return  number of images processed successfully
+ */
+public static native @Cast("l_int32") int pipelineRun(L_PIPELINE pl,
+            @Cast("PIX**") PointerPointer pixas,
+            @Cast("PIX**") PointerPointer pixad,
+            @Cast("l_int32") int n);
+public static native @Cast("l_int32") int pipelineRun(L_PIPELINE pl,
+            @ByPtrPtr PIX pixas,
+            @ByPtrPtr PIX pixad,
+            @Cast("l_int32") int n);
+
+/**
+ * \brief   pipelineRunFiles()
+ *
+ * @param pl [in]
+ * @param sa [in]          of n file names, read with pixRead()
+ * @param pixad [out]       array of n output images, null for the failed ones
+ * @return  number of images processed successfully
+ */
+public static native @Cast("l_int32") int pipelineRunFiles(L_PIPELINE pl,
+                 SARRAY sa,
+                 @Cast("PIX**") PointerPointer pixad);
+public static native @Cast("l_int32") int pipelineRunFiles(L_PIPELINE pl,
+                 SARRAY sa,
+                 @ByPtrPtr PIX pixad);
+
+/**
+ * \brief   pipelineRunPixa()
+ *
+ * @param pl [in]
+ * @param pixas [in]
+ * @return  pixad, or NULL if any image failed
+ */
+public static native PIXA pipelineRunPixa(L_PIPELINE pl,
+                PIXA pixas);
+
+// #endif /* LEPTONICA_PIXPIPELINE_H */
+
+
 }
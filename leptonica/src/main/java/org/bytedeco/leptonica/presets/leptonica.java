@@ -39,8 +39,8 @@ import org.bytedeco.javacpp.tools.InfoMapper;
     @Platform(include = {"leptonica/alltypes.h", "leptonica/environ.h", "leptonica/array.h", "leptonica/array_internal.h", "leptonica/bbuffer.h", "leptonica/hashmap.h", "leptonica/heap.h", "leptonica/list.h",
         "leptonica/ptra.h", "leptonica/queue.h", "leptonica/rbtree.h", "leptonica/stack.h", "leptonica/arrayaccess.h", "leptonica/bmf.h", "leptonica/ccbord.h", "leptonica/ccbord_internal.h",
         "leptonica/colorfill.h", "leptonica/dewarp.h", "leptonica/gplot.h", "leptonica/imageio.h", "leptonica/jbclass.h", "leptonica/morph.h", "leptonica/pix.h", "leptonica/pix_internal.h",
-        "leptonica/recog.h", "leptonica/regutils.h", "leptonica/stringcode.h", "leptonica/sudoku.h", "leptonica/watershed.h", "leptonica/allheaders.h"},
-        link = "leptonica@.6", resource = {"include", "lib"}),
+        "leptonica/recog.h", "leptonica/regutils.h", "leptonica/stringcode.h", "leptonica/sudoku.h", "leptonica/watershed.h", "leptonica/allheaders.h", "pixpipeline.h"},
+        compiler = "cpp11", link = "leptonica@.6", resource = {"include", "lib"}),
     @Platform(value = "linux",        preloadpath = {"/usr/lib/", "/usr/lib32/", "/usr/lib64/"}, preload = "gomp@.1"),
     @Platform(value = "linux-armhf",  preloadpath = {"/usr/arm-linux-gnueabihf/lib/", "/usr/lib/arm-linux-gnueabihf/"}),
     @Platform(value = "linux-arm64",  preloadpath = {"/usr/aarch64-linux-gnu/lib/", "/usr/lib/aarch64-linux-gnu/"}),
@@ -123,6 +123,8 @@ public class leptonica implements InfoMapper {
                .put(new Info("L_StrCode").pointerTypes("L_STRCODE"))
                .put(new Info("L_Sudoku").pointerTypes("L_SUDOKU"))
                .put(new Info("L_WShed").pointerTypes("L_WSHED"))
+               .put(new Info("L_Pipeline").pointerTypes("L_PIPELINE"))
+               .put(new Info("pixpipeline.h").linePatterns("#ifndef LEPTONICA_PIXPIPELINE_PRIVATE_H", "#endif /\\* LEPTONICA_PIXPIPELINE_PRIVATE_H \\*/").skip())
                .put(new Info("gplotfileoutputs", "gplotstylenames").skip());
     }
 }
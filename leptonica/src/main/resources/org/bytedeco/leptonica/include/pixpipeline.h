@@ -0,0 +1,553 @@
+/*
+ *  pixpipeline.h
+ *
+ *  Batched preprocessing of images on a pool of threads
+ *
+ *  An L_PIPELINE holds a list of operations, such as conversion to gray,
+ *  scaling, binarization and deskewing, given for example as the text
+ *      "gray; scale 0.5; sauvola 8 0.34; deskew"
+ *  and applies them to batches of images, or of files read with pixRead(),
+ *  with each thread of the pipeline, including the calling one, taking the
+ *  next image until none are left. The pipelineRun*() functions return once
+ *  the whole batch is done, and must not be called concurrently from two
+ *  threads on the same pipeline, which can however run batches one after
+ *  the other from any thread.
+ *
+ *  Each thread of a pipeline keeps the intermediate images it no longer
+ *  needs, up to pipelineSetMaxBytes(), and reuses them as destinations of
+ *  the operations that can write into an existing image of the right size
+ *  and depth, namely invert, rotate by 2 quads, add_border and remove_border,
+ *  while the other operations allocate their results as usual. The images
+ *  read from files or created by the pipeline get inverted in place. The
+ *  memory manager of Leptonica is left alone, so images outside of the
+ *  pipeline, including its results, are allocated and freed as usual, and
+ *  the spare images get freed by pipelineClearPool() or pipelineDestroy().
+ *
+ *  Operations, with their parameters and defaults:
+ *      gray                           pixConvertTo8()
+ *      scale  scalex [scaley]         pixScale(), with scaley = scalex when 0
+ *      scale_to_size  wd hd           pixScaleToSize()
+ *      background_norm                pixBackgroundNormSimple()
+ *      unsharp  [halfwidth fract]     pixUnsharpMasking(), 1 and 0.3
+ *      threshold  [thresh]            pixConvertTo1(), 128
+ *      otsu  [sx sy]                  pixOtsuAdaptiveThreshold(), whole image
+ *      sauvola  [whsize factor]       pixSauvolaBinarizeTiled(), 8 and 0.35
+ *      deskew  [redsearch]            pixDeskew(), 0 for the default
+ *      rotate  quads                  pixRotateOrth()
+ *      invert                         pixInvert()
+ *      add_border  npix [val]         pixAddBorder(), 0
+ *      remove_border  npix            pixRemoveBorder()
+ */
+
+#ifndef LEPTONICA_PIXPIPELINE_H
+#define LEPTONICA_PIXPIPELINE_H
+
+#include "leptonica/allheaders.h"
+#include "batch_pool.h"
+
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+/*! Pipeline operations */
+enum {
+    L_PIPELINE_GRAY = 1,            /*!< pixConvertTo8()                */
+    L_PIPELINE_SCALE = 2,           /*!< pixScale()                     */
+    L_PIPELINE_SCALE_TO_SIZE = 3,   /*!< pixScaleToSize()               */
+    L_PIPELINE_BACKGROUND_NORM = 4, /*!< pixBackgroundNormSimple()      */
+    L_PIPELINE_UNSHARP = 5,         /*!< pixUnsharpMasking()            */
+    L_PIPELINE_THRESHOLD = 6,       /*!< pixConvertTo1()                */
+    L_PIPELINE_OTSU = 7,            /*!< pixOtsuAdaptiveThreshold()     */
+    L_PIPELINE_SAUVOLA = 8,         /*!< pixSauvolaBinarizeTiled()      */
+    L_PIPELINE_DESKEW = 9,          /*!< pixDeskew()                    */
+    L_PIPELINE_ROTATE = 10,         /*!< pixRotateOrth()                */
+    L_PIPELINE_INVERT = 11,         /*!< pixInvert()                    */
+    L_PIPELINE_ADD_BORDER = 12,     /*!< pixAddBorder()                 */
+    L_PIPELINE_REMOVE_BORDER = 13   /*!< pixRemoveBorder()              */
+};
+
+typedef struct L_Pipeline L_PIPELINE;
+
+#ifndef LEPTONICA_PIXPIPELINE_PRIVATE_H
+#define LEPTONICA_PIXPIPELINE_PRIVATE_H
+
+struct L_PipelineOp
+{
+    l_int32    type;
+    l_float32  param1;
+    l_float32  param2;
+};
+
+    /* Intermediate images kept by a thread of a pipeline */
+struct L_PipelineSpares
+{
+    std::vector<PIX *>  pixs;
+    size_t              bytes = 0;
+};
+
+struct L_Pipeline
+{
+    std::vector<L_PipelineOp>      ops;
+    bytedeco::BatchPool           *pool = NULL;
+    std::vector<L_PipelineSpares>  spares;    /* one per thread */
+    size_t                         maxbytes = (size_t)64 << 20;
+    std::atomic<l_int64>           hits;
+    std::atomic<l_int64>           misses;
+
+        /* State of the batch being processed */
+    std::atomic<l_int32>           next;
+    l_int32                        count = 0;
+    PIX                          **pixas = NULL;
+    SARRAY                        *files = NULL;
+    PIX                          **pixad = NULL;
+    std::atomic<l_int32>           produced;
+};
+
+static inline size_t
+pipelineBytes_(PIX *pix)
+{
+    return (size_t)4 * pixGetWpl(pix) * pixGetHeight(pix);
+}
+
+    /* Returns a spare image of the given size and depth, or a new one */
+static inline PIX *
+pipelineTake_(L_PIPELINE        *pl,
+              L_PipelineSpares  *spares,
+              l_int32            w,
+              l_int32            h,
+              l_int32            d)
+{
+    for (size_t i = spares->pixs.size(); i-- > 0; ) {
+        PIX *pix = spares->pixs[i];
+        if (pixGetWidth(pix) == w && pixGetHeight(pix) == h && pixGetDepth(pix) == d) {
+            spares->pixs.erase(spares->pixs.begin() + i);
+            spares->bytes -= pipelineBytes_(pix);
+            pl->hits++;
+            return pix;
+        }
+    }
+    pl->misses++;
+    return pixCreateNoInit(w, h, d);
+}
+
+    /* Keeps an intermediate image owned by the pipeline, destroying the
+     * oldest ones beyond one per operation or maxbytes, as images of sizes
+     * no operation asks for would otherwise accumulate */
+static inline void
+pipelineGive_(L_PIPELINE        *pl,
+              L_PipelineSpares  *spares,
+              PIX               *pix)
+{
+    pixDestroyColormap(pix);
+    pixSetText(pix, NULL);
+    spares->pixs.push_back(pix);
+    spares->bytes += pipelineBytes_(pix);
+    while (!spares->pixs.empty() &&
+           (spares->pixs.size() > pl->ops.size() || spares->bytes > pl->maxbytes)) {
+        spares->bytes -= pipelineBytes_(spares->pixs[0]);
+        pixDestroy(&spares->pixs[0]);
+        spares->pixs.erase(spares->pixs.begin());
+    }
+}
+
+    /* Sets up pixd, taken from the spares, to receive pixels of pixs */
+static inline void
+pipelineCopyHeader_(PIX  *pixd,
+                    PIX  *pixs)
+{
+    pixCopySpp(pixd, pixs);
+    pixCopyResolution(pixd, pixs);
+    pixCopyInputFormat(pixd, pixs);
+    pixCopyText(pixd, pixs);
+}
+
+static inline PIX *
+pipelineApply_(L_PIPELINE          *pl,
+               L_PipelineSpares    *spares,
+               const L_PipelineOp  *op,
+               PIX                 *pixs,
+               l_int32              owned)
+{
+    PIX *pixd = NULL;
+    l_int32 w = pixGetWidth(pixs), h = pixGetHeight(pixs), d = pixGetDepth(pixs);
+    l_int32 npix = (l_int32)op->param1;
+    switch (op->type) {
+    case L_PIPELINE_GRAY:
+        return pixConvertTo8(pixs, 0);
+    case L_PIPELINE_SCALE:
+        return pixScale(pixs, op->param1, op->param2 > 0 ? op->param2 : op->param1);
+    case L_PIPELINE_SCALE_TO_SIZE:
+        return pixScaleToSize(pixs, (l_int32)op->param1, (l_int32)op->param2);
+    case L_PIPELINE_BACKGROUND_NORM:
+        return pixBackgroundNormSimple(pixs, NULL, NULL);
+    case L_PIPELINE_UNSHARP:
+        return pixUnsharpMasking(pixs, (l_int32)op->param1, op->param2);
+    case L_PIPELINE_THRESHOLD:
+        return pixConvertTo1(pixs, (l_int32)op->param1);
+    case L_PIPELINE_OTSU:
+        pixOtsuAdaptiveThreshold(pixs,
+                                 op->param1 > 0 ? (l_int32)op->param1 : pixGetWidth(pixs),
+                                 op->param2 > 0 ? (l_int32)op->param2 : pixGetHeight(pixs),
+                                 0, 0, 0.1f, NULL, &pixd);
+        return pixd;
+    case L_PIPELINE_SAUVOLA:
+        pixSauvolaBinarizeTiled(pixs, (l_int32)op->param1, op->param2, 1, 1, NULL, &pixd);
+        return pixd;
+    case L_PIPELINE_DESKEW:
+        return pixDeskew(pixs, (l_int32)op->param1);
+    case L_PIPELINE_ROTATE:
+        if (((l_int32)op->param1 & 3) != 2)
+            return pixRotateOrth(pixs, (l_int32)op->param1);
+        return pixRotate180(pipelineTake_(pl, spares, w, h, d), pixs);
+    case L_PIPELINE_INVERT:
+        if (owned) {
+            pixInvert(pixs, pixs);
+            return pixClone(pixs);
+        }
+        return pixInvert(pipelineTake_(pl, spares, w, h, d), pixs);
+    case L_PIPELINE_ADD_BORDER:
+        if (npix <= 0 || pixGetColormap(pixs))
+            return pixAddBorder(pixs, npix, (l_uint32)op->param2);
+        if ((pixd = pipelineTake_(pl, spares, w + 2 * npix, h + 2 * npix, d)) == NULL)
+            return NULL;
+        pipelineCopyHeader_(pixd, pixs);
+        pixSetAllArbitrary(pixd, (l_uint32)op->param2);
+        pixRasterop(pixd, npix, npix, w, h, PIX_SRC, pixs, 0, 0);
+        return pixd;
+    case L_PIPELINE_REMOVE_BORDER:
+        if (npix <= 0 || 2 * npix >= w || 2 * npix >= h)
+            return pixRemoveBorder(pixs, npix);
+        if ((pixd = pipelineTake_(pl, spares, w - 2 * npix, h - 2 * npix, d)) == NULL)
+            return NULL;
+        pipelineCopyHeader_(pixd, pixs);
+        pixCopyColormap(pixd, pixs);
+        pixRasterop(pixd, 0, 0, w - 2 * npix, h - 2 * npix, PIX_SRC, pixs, npix, npix);
+        return pixd;
+    default:
+        return NULL;
+    }
+}
+
+    /* Intermediate images are owned when not clones of the inputs, and the
+     * operations return a clone of their source when they leave it as is */
+static inline void
+pipelineWork_(L_PIPELINE  *pl,
+              l_int32      index)
+{
+    L_PipelineSpares *spares = &pl->spares[index];
+    for (l_int32 i = pl->next++; i < pl->count; i = pl->next++) {
+        PIX *pix = pl->files ? pixRead(sarrayGetString(pl->files, i, L_NOCOPY))
+                             : pixClone(pl->pixas[i]);
+        l_int32 owned = pl->files != NULL;
+        for (size_t j = 0; j < pl->ops.size() && pix; j++) {
+            PIX *pixt = pipelineApply_(pl, spares, &pl->ops[j], pix, owned);
+            l_int32 same = pixt == pix;
+            if (pixt && !same && owned)
+                pipelineGive_(pl, spares, pix);
+            else
+                pixDestroy(&pix);
+            pix = pixt;
+            if (!same) owned = 1;
+        }
+        pl->pixad[i] = pix;
+        if (pix) pl->produced++;
+    }
+}
+
+static inline l_int32
+pipelineRun_(L_PIPELINE  *pl,
+             PIX        **pixas,
+             SARRAY      *files,
+             PIX        **pixad,
+             l_int32      n)
+{
+    pl->pixas = pixas;
+    pl->files = files;
+    pl->pixad = pixad;
+    pl->count = n;
+    pl->next = 0;
+    pl->produced = 0;
+    pl->pool->run([pl](int index) { pipelineWork_(pl, index); });
+    return pl->produced;
+}
+
+#endif /* LEPTONICA_PIXPIPELINE_PRIVATE_H */
+
+/*!
+ * \brief   pipelineSetMaxBytes()
+ *
+ * \param[in]    pl
+ * \param[in]    maxbytes    of spare images kept by each thread; default 64 MB
+ * \return  0 if OK, 1 on error
+ */
+static inline l_ok
+pipelineSetMaxBytes(L_PIPELINE  *pl,
+                    size_t       maxbytes)
+{
+    if (!pl)
+        return ERROR_INT("pl not defined", __func__, 1);
+    pl->maxbytes = maxbytes;
+    return 0;
+}
+
+/*!
+ * \brief   pipelineGetPoolStats()
+ *
+ * \param[in]    pl
+ * \param[out]   pcached     [optional] bytes of spare images kept
+ * \param[out]   phits       [optional] destinations taken from the spares
+ * \param[out]   pmisses     [optional] destinations that needed a new image
+ * \return  0 if OK, 1 on error
+ */
+static inline l_ok
+pipelineGetPoolStats(L_PIPELINE  *pl,
+                     l_int64     *pcached,
+                     l_int64     *phits,
+                     l_int64     *pmisses)
+{
+    if (!pl)
+        return ERROR_INT("pl not defined", __func__, 1);
+    size_t cached = 0;
+    for (size_t i = 0; i < pl->spares.size(); i++)
+        cached += pl->spares[i].bytes;
+    if (pcached) *pcached = (l_int64)cached;
+    if (phits) *phits = pl->hits;
+    if (pmisses) *pmisses = pl->misses;
+    return 0;
+}
+
+/*!
+ * \brief   pipelineClearPool()
+ *
+ * \param[in]    pl
+ *
+ *  Destroys all the spare images kept by the threads of the pipeline.
+ */
+static inline void
+pipelineClearPool(L_PIPELINE  *pl)
+{
+    if (!pl)
+        return;
+    for (size_t i = 0; i < pl->spares.size(); i++) {
+        for (size_t j = 0; j < pl->spares[i].pixs.size(); j++)
+            pixDestroy(&pl->spares[i].pixs[j]);
+        pl->spares[i].pixs.clear();
+        pl->spares[i].bytes = 0;
+    }
+}
+
+/*!
+ * \brief   pipelineAddOperation()
+ *
+ * \param[in]    pl
+ * \param[in]    type        L_PIPELINE_GRAY, ...
+ * \param[in]    param1      as listed at the top, or 0
+ * \param[in]    param2      as listed at the top, or 0
+ * \return  0 if OK, 1 on error
+ */
+static inline l_ok
+pipelineAddOperation(L_PIPELINE  *pl,
+                     l_int32      type,
+                     l_float32    param1,
+                     l_float32    param2)
+{
+    if (!pl)
+        return ERROR_INT("pl not defined", __func__, 1);
+    if (type < L_PIPELINE_GRAY || type > L_PIPELINE_REMOVE_BORDER)
+        return ERROR_INT("invalid type", __func__, 1);
+    L_PipelineOp op = {type, param1, param2};
+    pl->ops.push_back(op);
+    return 0;
+}
+
+/*!
+ * \brief   pipelineDestroy()
+ *
+ * \param[in,out]   ppl    will be set to null before returning
+ */
+static inline void
+pipelineDestroy(L_PIPELINE  **ppl)
+{
+    L_PIPELINE *pl;
+
+    if (!ppl || (pl = *ppl) == NULL)
+        return;
+    delete pl->pool;
+    pipelineClearPool(pl);
+    delete pl;
+    *ppl = NULL;
+}
+
+/*!
+ * \brief   pipelineCreate()
+ *
+ * \param[in]    ops         [optional] operations separated by ';' or
+ *                           newlines, as listed at the top; can be null
+ * \param[in]    nthreads    including the calling one; 0 for the number
+ *                           of hardware threads
+ * \return  pl, or NULL on error
+ */
+static inline L_PIPELINE *
+pipelineCreate(const char  *ops,
+               l_int32      nthreads)
+{
+    static const struct {
+        const char  *name;
+        l_int32      type;
+        l_float32    param1, param2;
+    } names[] = {
+        {"gray", L_PIPELINE_GRAY, 0, 0},
+        {"scale", L_PIPELINE_SCALE, 1, 0},
+        {"scale_to_size", L_PIPELINE_SCALE_TO_SIZE, 0, 0},
+        {"background_norm", L_PIPELINE_BACKGROUND_NORM, 0, 0},
+        {"unsharp", L_PIPELINE_UNSHARP, 1, 0.3f},
+        {"threshold", L_PIPELINE_THRESHOLD, 128, 0},
+        {"otsu", L_PIPELINE_OTSU, 0, 0},
+        {"sauvola", L_PIPELINE_SAUVOLA, 8, 0.35f},
+        {"deskew", L_PIPELINE_DESKEW, 0, 0},
+        {"rotate", L_PIPELINE_ROTATE, 0, 0},
+        {"invert", L_PIPELINE_INVERT, 0, 0},
+        {"add_border", L_PIPELINE_ADD_BORDER, 0, 0},
+        {"remove_border", L_PIPELINE_REMOVE_BORDER, 0, 0}};
+    L_PIPELINE *pl = new L_PIPELINE();
+    pl->hits = 0;
+    pl->misses = 0;
+
+    while (ops && *ops) {
+        size_t len = strcspn(ops, ";\n");
+        const char *end = ops + len;
+        char name[32];
+        size_t n = 0;
+        while (ops < end && (*ops == ' ' || *ops == '\t' || *ops == '\r'))
+            ops++;
+        while (ops < end && *ops != ' ' && *ops != '\t' && *ops != '\r' && n < sizeof(name) - 1)
+            name[n++] = *ops++;
+        name[n] = '\0';
+        if (n > 0) {
+            size_t i;
+            for (i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+                if (strcmp(name, names[i].name) == 0) break;
+            }
+            if (i == sizeof(names) / sizeof(names[0])) {
+                L_ERROR("unknown operation %s\n", __func__, name);
+                pipelineDestroy(&pl);
+                return NULL;
+            }
+            l_float32 params[2] = {names[i].param1, names[i].param2};
+            for (int j = 0; j < 2; j++) {
+                char *next;
+                double value = strtod(ops, &next);
+                if (next == ops || next > end) break;
+                params[j] = (l_float32)value;
+                ops = next;
+            }
+            while (ops < end && (*ops == ' ' || *ops == '\t' || *ops == '\r'))
+                ops++;
+            if (ops != end) {
+                L_ERROR("invalid parameters for %s\n", __func__, name);
+                pipelineDestroy(&pl);
+                return NULL;
+            }
+            pipelineAddOperation(pl, names[i].type, params[0], params[1]);
+        }
+        ops = *end ? end + 1 : end;
+    }
+
+    if (nthreads <= 0)
+        nthreads = (l_int32)std::thread::hardware_concurrency();
+    try {
+        pl->pool = new bytedeco::BatchPool(nthreads);
+        pl->spares.resize(pl->pool->size());
+    } catch (...) {
+        pipelineDestroy(&pl);
+        return (L_PIPELINE *)ERROR_PTR("could not start threads", __func__, NULL);
+    }
+    return pl;
+}
+
+/*!
+ * \brief   pipelineGetThreadCount()
+ *
+ * \param[in]    pl
+ * \return  number of threads, including the calling one
+ */
+static inline l_int32
+pipelineGetThreadCount(L_PIPELINE  *pl)
+{
+    if (!pl)
+        return ERROR_INT("pl not defined", __func__, 0);
+    return pl->pool->size();
+}
+
+/*!
+ * \brief   pipelineRun()
+ *
+ * \param[in]    pl
+ * \param[in]    pixas       array of n input images, left unchanged
+ * \param[out]   pixad       array of n output images, null for the failed ones
+ * \param[in]    n
+ * \return  number of images processed successfully
+ */
+static inline l_int32
+pipelineRun(L_PIPELINE  *pl,
+            PIX        **pixas,
+            PIX        **pixad,
+            l_int32      n)
+{
+    if (!pl || !pixas || !pixad)
+        return ERROR_INT("pl, pixas or pixad not defined", __func__, 0);
+    return pipelineRun_(pl, pixas, NULL, pixad, n);
+}
+
+/*!
+ * \brief   pipelineRunFiles()
+ *
+ * \param[in]    pl
+ * \param[in]    sa          of n file names, read with pixRead()
+ * \param[out]   pixad       array of n output images, null for the failed ones
+ * \return  number of images processed successfully
+ */
+static inline l_int32
+pipelineRunFiles(L_PIPELINE  *pl,
+                 SARRAY      *sa,
+                 PIX        **pixad)
+{
+    if (!pl || !sa || !pixad)
+        return ERROR_INT("pl, sa or pixad not defined", __func__, 0);
+    return pipelineRun_(pl, NULL, sa, pixad, sarrayGetCount(sa));
+}
+
+/*!
+ * \brief   pipelineRunPixa()
+ *
+ * \param[in]    pl
+ * \param[in]    pixas
+ * \return  pixad, or NULL if any image failed
+ */
+static inline PIXA *
+pipelineRunPixa(L_PIPELINE  *pl,
+                PIXA        *pixas)
+{
+    if (!pl || !pixas)
+        return (PIXA *)ERROR_PTR("pl or pixas not defined", __func__, NULL);
+    l_int32 n = pixaGetCount(pixas);
+    std::vector<PIX *> pixs(n), pixd(n);
+    for (l_int32 i = 0; i < n; i++)
+        pixs[i] = pixaGetPix(pixas, i, L_CLONE);
+    l_int32 produced = n > 0 ? pipelineRun_(pl, &pixs[0], NULL, &pixd[0], n) : 0;
+    PIXA *pixa = produced == n ? pixaCreate(n) : NULL;
+    for (l_int32 i = 0; i < n; i++) {
+        pixDestroy(&pixs[i]);
+        if (pixa)
+            pixaAddPix(pixa, pixd[i], L_INSERT);
+        else
+            pixDestroy(&pixd[i]);
+    }
+    if (!pixa)
+        return (PIXA *)ERROR_PTR("some images failed", __func__, NULL);
+    return pixa;
+}
+
+#endif /* LEPTONICA_PIXPIPELINE_H */
@@ -0,0 +1,89 @@
+import java.nio.charset.StandardCharsets;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.libpostal.*;
+import static org.bytedeco.libpostal.global.postal.*;
+
+public class BatchExample {
+    static String string(BytePointer arena, libpostal_batch_string_t s) throws Exception {
+        return new BytePointer(arena).position(s.offset()).getString("UTF-8");
+    }
+
+    public static void main(String[] args) throws Exception {
+        String dataDir = args.length >= 1 ? new String(args[0]) : "data/";
+        String libpostal_data = Loader.load(org.bytedeco.libpostal.libpostal_data.class);
+        ProcessBuilder pb = new ProcessBuilder("bash", libpostal_data, "download", "all", dataDir);
+        pb.inheritIO().start().waitFor();
+
+        boolean setup1 = libpostal_setup_datadir(dataDir);
+        boolean setup2 = libpostal_setup_parser_datadir(dataDir);
+        boolean setup3 = libpostal_setup_language_classifier_datadir(dataDir);
+        if (!setup1 || !setup2 || !setup3) {
+            System.out.println("Cannot setup libpostal, check if the training data is available at the specified path!");
+            System.exit(-1);
+        }
+
+        String[] addresses = {
+            "781 Franklin Ave Crown Heights Brooklyn NYC NY 11216 USA",
+            "Quatre vingt douze Ave des Champs-Élysées",
+            "The Book Club 100-106 Leonard St Shoreditch London EC2A 4RH, United Kingdom",
+            "Av. Paulista, 1578 - Bela Vista, São Paulo - SP, 01310-200, Brasil"
+        };
+
+        // pack all the addresses in one buffer of UTF-8, with their offsets
+        int n = 100000;
+        byte[][] bytes = new byte[addresses.length][];
+        long total = 0;
+        for (int i = 0; i < addresses.length; i++) {
+            bytes[i] = addresses[i].getBytes(StandardCharsets.UTF_8);
+        }
+        for (int i = 0; i < n; i++) {
+            total += bytes[i % addresses.length].length;
+        }
+        BytePointer input = new BytePointer(total);
+        SizeTPointer offsets = new SizeTPointer(n + 1);
+        long offset = 0;
+        for (int i = 0; i < n; i++) {
+            byte[] b = bytes[i % addresses.length];
+            offsets.put(i, offset);
+            input.position(offset).put(b, 0, b.length);
+            offset += b.length;
+        }
+        offsets.put(n, offset);
+        input.position(0);
+
+        libpostal_batch_t batch = libpostal_batch_new(0);
+        long start = System.nanoTime();
+        boolean ok = libpostal_batch_process(batch, input, offsets, n, LIBPOSTAL_BATCH_PARSE | LIBPOSTAL_BATCH_EXPAND,
+                libpostal_get_address_parser_default_options(), libpostal_get_default_options());
+        long time = System.nanoTime() - start;
+        if (!ok) {
+            System.out.println("Out of memory!");
+            System.exit(-1);
+        }
+        System.out.printf("Parsed and expanded %d addresses in %.3f s%n", n, time / 1e9);
+
+        SizeTPointer size = new SizeTPointer(1);
+        libpostal_batch_result_t results = libpostal_batch_results(batch, size);
+        libpostal_batch_string_t strings = libpostal_batch_strings(batch, size);
+        BytePointer arena = libpostal_batch_arena(batch, size);
+        for (int i = 0; i < addresses.length; i++) {
+            libpostal_batch_result_t result = results.getPointer(i);
+            System.out.println(addresses[i] + (result.error() ? " (error)" : ""));
+            long s = result.first_string();
+            for (long j = 0; j < result.num_components(); j++, s += 2) {
+                String label = string(arena, strings.getPointer(s));
+                String component = string(arena, strings.getPointer(s + 1));
+                System.out.println("    " + label + " " + component);
+            }
+            for (long j = 0; j < result.num_expansions(); j++, s++) {
+                System.out.println("    -> " + string(arena, strings.getPointer(s)));
+            }
+        }
+
+        libpostal_batch_destroy(batch);
+        libpostal_teardown();
+        libpostal_teardown_parser();
+        libpostal_teardown_language_classifier();
+        System.exit(0);
+    }
+}
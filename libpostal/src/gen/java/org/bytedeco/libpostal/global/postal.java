@@ -317,4 +317,87 @@ public static final int LIBPOSTAL_NORMALIZE_DEFAULT_TOKEN_OPTIONS_NUMERIC = (LIB
 // #endif
 
 
+// Parsed from libpostal_batch.h
+
+/*
+Bulk address parsing and expansion
+
+A libpostal_batch_t owns a pool of threads that parse and/or expand many
+addresses at once. The addresses are given as one packed buffer of UTF-8 with
+an array of offsets, and the labels, components and expansions all end up in
+one packed output arena owned by the batch, with one result per address that
+indexes into it. This avoids the per-address calls, responses, and strings
+that would otherwise need to cross the language boundary.
+
+The threads share the models loaded with libpostal_setup(),
+libpostal_setup_parser() and libpostal_setup_language_classifier(), which are
+read-only once loaded, so these must be called before processing a batch, and
+libpostal_teardown*() must not be called while a batch is being processed.
+
+libpostal_batch_process() runs on all the threads of the batch and returns once
+it is done, so it must not be called from several threads at once with the same
+batch, and the output of a batch must not be read while it processes another.
+*/
+
+// #ifndef LIBPOSTAL_BATCH_H
+// #define LIBPOSTAL_BATCH_H
+
+// #include <atomic>
+// #include <new>
+// #include <stdlib.h>
+// #include <string.h>
+// #include <thread>
+// #include <vector>
+
+// #include <libpostal/libpostal.h>
+// #include "batch_pool.h"
+
+public static final int LIBPOSTAL_BATCH_PARSE =  (1 << 0);
+public static final int LIBPOSTAL_BATCH_EXPAND = (1 << 1);
+// Targeting ../libpostal_batch_string_t.java
+
+
+// Targeting ../libpostal_batch_result_t.java
+
+
+// Targeting ../libpostal_batch_t.java
+
+
+
+/*
+Creates a batch with the given number of threads, or as many as hardware threads
+when 0, including the calling thread, or returns NULL on failure
+*/
+
+public static native libpostal_batch_t libpostal_batch_new(@Cast("size_t") long num_threads);
+
+/*
+Parses and/or expands, according to options, a combination of LIBPOSTAL_BATCH_PARSE
+and LIBPOSTAL_BATCH_EXPAND, the addresses at input[offsets[i]] to input[offsets[i + 1]]
+for i from 0 to num_addresses - 1, replacing the output of any previous batch.
+Returns false if memory ran out, in which case the output is empty.
+*/
+
+public static native @Cast("bool") boolean libpostal_batch_process(libpostal_batch_t batch, @Cast("const char*") BytePointer input, @Cast("const size_t*") SizeTPointer offsets, @Cast("size_t") long num_addresses,
+                                    int options, @ByVal libpostal_address_parser_options_t parser_options,
+                                    @ByVal libpostal_normalize_options_t normalize_options);
+public static native @Cast("bool") boolean libpostal_batch_process(libpostal_batch_t batch, String input, @Cast("const size_t*") SizeTPointer offsets, @Cast("size_t") long num_addresses,
+                                    int options, @ByVal libpostal_address_parser_options_t parser_options,
+                                    @ByVal libpostal_normalize_options_t normalize_options);
+
+/*
+Accessors for the output of the last batch, valid until the next one or libpostal_batch_destroy()
+*/
+
+public static native @Const libpostal_batch_result_t libpostal_batch_results(@Const libpostal_batch_t batch, @Cast("size_t*") SizeTPointer n);
+
+public static native @Const libpostal_batch_string_t libpostal_batch_strings(@Const libpostal_batch_t batch, @Cast("size_t*") SizeTPointer n);
+
+public static native @Cast("const char*") BytePointer libpostal_batch_arena(@Const libpostal_batch_t batch, @Cast("size_t*") SizeTPointer size);
+
+public static native void libpostal_batch_destroy(libpostal_batch_t batch);
+
+// #endif
+
+
 }
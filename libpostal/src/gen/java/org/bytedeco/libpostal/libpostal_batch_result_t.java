@@ -0,0 +1,40 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.libpostal;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.libpostal.global.postal.*;
+
+
+/*
+The result for one address, whose strings are strings[first_string] onwards:
+num_components pairs of label and component, followed by num_expansions expansions
+*/
+@Properties(inherit = org.bytedeco.libpostal.presets.postal.class)
+public class libpostal_batch_result_t extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public libpostal_batch_result_t() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public libpostal_batch_result_t(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public libpostal_batch_result_t(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public libpostal_batch_result_t position(long position) {
+        return (libpostal_batch_result_t)super.position(position);
+    }
+    @Override public libpostal_batch_result_t getPointer(long i) {
+        return new libpostal_batch_result_t((Pointer)this).offsetAddress(i);
+    }
+
+    public native @Cast("size_t") long first_string(); public native libpostal_batch_result_t first_string(long setter);
+    public native @Cast("size_t") long num_components(); public native libpostal_batch_result_t num_components(long setter);
+    public native @Cast("size_t") long num_expansions(); public native libpostal_batch_result_t num_expansions(long setter);
+    public native @Cast("bool") boolean error(); public native libpostal_batch_result_t error(boolean setter);                     // libpostal failed to parse or expand the address
+}
@@ -0,0 +1,37 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.libpostal;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.libpostal.global.postal.*;
+
+
+/*
+A NUL-terminated string in the output arena
+*/
+@Properties(inherit = org.bytedeco.libpostal.presets.postal.class)
+public class libpostal_batch_string_t extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public libpostal_batch_string_t() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public libpostal_batch_string_t(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public libpostal_batch_string_t(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public libpostal_batch_string_t position(long position) {
+        return (libpostal_batch_string_t)super.position(position);
+    }
+    @Override public libpostal_batch_string_t getPointer(long i) {
+        return new libpostal_batch_string_t((Pointer)this).offsetAddress(i);
+    }
+
+    public native @Cast("size_t") long offset(); public native libpostal_batch_string_t offset(long setter);                  // Offset of the first byte in the arena
+    public native @Cast("size_t") long length(); public native libpostal_batch_string_t length(long setter);                  // Length in bytes, without the terminating NUL
+}
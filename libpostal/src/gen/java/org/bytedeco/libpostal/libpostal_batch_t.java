@@ -0,0 +1,20 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.libpostal;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.libpostal.global.postal.*;
+
+
+@Opaque @Properties(inherit = org.bytedeco.libpostal.presets.postal.class)
+public class libpostal_batch_t extends Pointer {
+    /** Empty constructor. Calls {@code super((Pointer)null)}. */
+    public libpostal_batch_t() { super((Pointer)null); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public libpostal_batch_t(Pointer p) { super(p); }
+}
@@ -39,6 +39,8 @@ import org.bytedeco.javacpp.tools.InfoMapper;
         @Platform(
             value = {"linux-arm64", "linux-x86_64", "macosx-arm64", "macosx-x86_64", "windows-x86_64"},
             cinclude = "libpostal/libpostal.h",
+            include = "libpostal_batch.h",
+            compiler = "cpp11",
             link = "postal@.1",
             preload = "libpostal-1"
         )
@@ -52,6 +54,7 @@ public class postal implements InfoMapper {
     public void map(InfoMap infoMap) {
         infoMap.put(new Info("LIBPOSTAL_EXPORT").cppTypes().annotations())
                .put(new Info("libpostal_normalized_tokens").skip())
+               .put(new Info("libpostal_batch.h").linePatterns("^#ifndef LIBPOSTAL_BATCH_PRIVATE_H$", "^#endif /\\* LIBPOSTAL_BATCH_PRIVATE_H \\*/$").skip())
                .put(new Info("char").cast().valueTypes("byte").pointerTypes("BytePointer", "String"));
     }
 }
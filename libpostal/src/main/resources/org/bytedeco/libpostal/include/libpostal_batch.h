@@ -0,0 +1,300 @@
+/*
+Bulk address parsing and expansion
+
+A libpostal_batch_t owns a pool of threads that parse and/or expand many
+addresses at once. The addresses are given as one packed buffer of UTF-8 with
+an array of offsets, and the labels, components and expansions all end up in
+one packed output arena owned by the batch, with one result per address that
+indexes into it. This avoids the per-address calls, responses, and strings
+that would otherwise need to cross the language boundary.
+
+The threads share the models loaded with libpostal_setup(),
+libpostal_setup_parser() and libpostal_setup_language_classifier(), which are
+read-only once loaded, so these must be called before processing a batch, and
+libpostal_teardown*() must not be called while a batch is being processed.
+
+libpostal_batch_process() runs on all the threads of the batch and returns once
+it is done, so it must not be called from several threads at once with the same
+batch, and the output of a batch must not be read while it processes another.
+*/
+
+#ifndef LIBPOSTAL_BATCH_H
+#define LIBPOSTAL_BATCH_H
+
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include <libpostal/libpostal.h>
+#include "batch_pool.h"
+
+#define LIBPOSTAL_BATCH_PARSE  (1 << 0)
+#define LIBPOSTAL_BATCH_EXPAND (1 << 1)
+
+/*
+A NUL-terminated string in the output arena
+*/
+
+typedef struct libpostal_batch_string {
+    size_t offset;                  // Offset of the first byte in the arena
+    size_t length;                  // Length in bytes, without the terminating NUL
+} libpostal_batch_string_t;
+
+/*
+The result for one address, whose strings are strings[first_string] onwards:
+num_components pairs of label and component, followed by num_expansions expansions
+*/
+
+typedef struct libpostal_batch_result {
+    size_t first_string;
+    size_t num_components;
+    size_t num_expansions;
+    bool error;                     // libpostal failed to parse or expand the address
+} libpostal_batch_result_t;
+
+typedef struct libpostal_batch libpostal_batch_t;
+
+#ifndef LIBPOSTAL_BATCH_PRIVATE_H
+#define LIBPOSTAL_BATCH_PRIVATE_H
+
+// Output of a chunk of consecutive addresses, with offsets relative to the chunk
+struct libpostal_batch_chunk {
+    std::vector<char> arena;
+    std::vector<libpostal_batch_string_t> strings;
+    size_t arena_base;
+    size_t string_base;
+};
+
+struct libpostal_batch {
+    static const size_t chunk_size = 64;
+
+    bytedeco::BatchPool *pool;
+    std::vector<std::vector<char> > addresses;  // Buffer of each thread for the address being processed
+
+    // State of the batch being processed
+    int phase;
+    std::atomic<size_t> next_chunk;
+    std::atomic<bool> failed;
+    size_t num_chunks;
+    const char *input;
+    const size_t *offsets;
+    size_t num_addresses;
+    int options;
+    libpostal_address_parser_options_t parser_options;
+    libpostal_normalize_options_t normalize_options;
+
+    std::vector<libpostal_batch_chunk> chunks;
+    std::vector<libpostal_batch_result_t> results;
+    std::vector<libpostal_batch_string_t> strings;
+    std::vector<char> arena;
+
+    libpostal_batch() : pool(NULL), phase(0), next_chunk(0), failed(false), num_chunks(0),
+                        input(NULL), offsets(NULL), num_addresses(0), options(0) { }
+
+    ~libpostal_batch() {
+        delete pool;
+    }
+
+    static void append(libpostal_batch_chunk &chunk, const char *s) {
+        libpostal_batch_string_t string;
+        string.offset = chunk.arena.size();
+        string.length = strlen(s);
+        chunk.arena.insert(chunk.arena.end(), s, s + string.length + 1);
+        chunk.strings.push_back(string);
+    }
+
+    // Parses and expands the addresses of a chunk into its own arena
+    void process_chunk(size_t c, std::vector<char> &address) {
+        libpostal_batch_chunk &chunk = chunks[c];
+        chunk.arena.clear();
+        chunk.strings.clear();
+        size_t end = (c + 1) * chunk_size < num_addresses ? (c + 1) * chunk_size : num_addresses;
+        for (size_t i = c * chunk_size; i < end; i++) {
+            libpostal_batch_result_t &result = results[i];
+            result.first_string = chunk.strings.size();
+            result.num_components = 0;
+            result.num_expansions = 0;
+            result.error = false;
+
+            size_t length = offsets[i + 1] - offsets[i];
+            address.resize(length + 1);
+            memcpy(address.data(), input + offsets[i], length);
+            address[length] = '\0';
+
+            if (options & LIBPOSTAL_BATCH_PARSE) {
+                libpostal_address_parser_response_t *response = libpostal_parse_address(address.data(), parser_options);
+                if (response != NULL) {
+                    try {
+                        for (size_t j = 0; j < response->num_components; j++) {
+                            append(chunk, response->labels[j]);
+                            append(chunk, response->components[j]);
+                        }
+                    } catch (...) {
+                        libpostal_address_parser_response_destroy(response);
+                        throw;
+                    }
+                    result.num_components = response->num_components;
+                    libpostal_address_parser_response_destroy(response);
+                } else {
+                    result.error = true;
+                }
+            }
+            if (options & LIBPOSTAL_BATCH_EXPAND) {
+                size_t n = 0;
+                char **expansions = libpostal_expand_address(address.data(), normalize_options, &n);
+                if (expansions != NULL) {
+                    try {
+                        for (size_t j = 0; j < n; j++) {
+                            append(chunk, expansions[j]);
+                        }
+                    } catch (...) {
+                        libpostal_expansion_array_destroy(expansions, n);
+                        throw;
+                    }
+                    result.num_expansions = n;
+                    libpostal_expansion_array_destroy(expansions, n);
+                } else {
+                    result.error = true;
+                }
+            }
+        }
+    }
+
+    // Moves the output of a chunk to its place in the arena of the batch
+    void pack_chunk(size_t c) {
+        const libpostal_batch_chunk &chunk = chunks[c];
+        if (!chunk.arena.empty()) {
+            memcpy(arena.data() + chunk.arena_base, chunk.arena.data(), chunk.arena.size());
+        }
+        for (size_t i = 0; i < chunk.strings.size(); i++) {
+            libpostal_batch_string_t &string = strings[chunk.string_base + i];
+            string.offset = chunk.strings[i].offset + chunk.arena_base;
+            string.length = chunk.strings[i].length;
+        }
+        size_t end = (c + 1) * chunk_size < num_addresses ? (c + 1) * chunk_size : num_addresses;
+        for (size_t i = c * chunk_size; i < end; i++) {
+            results[i].first_string += chunk.string_base;
+        }
+    }
+
+    void work(std::vector<char> &address) {
+        for (size_t c = next_chunk++; c < num_chunks; c = next_chunk++) {
+            try {
+                if (phase == 0) {
+                    process_chunk(c, address);
+                } else {
+                    pack_chunk(c);
+                }
+            } catch (...) {
+                failed = true;
+            }
+        }
+    }
+
+    // Runs a phase over all chunks on the threads of the pool
+    void run_phase(int p) {
+        phase = p;
+        next_chunk = 0;
+        pool->run([this](int index) { work(addresses[index]); });
+    }
+};
+
+#endif /* LIBPOSTAL_BATCH_PRIVATE_H */
+
+/*
+Creates a batch with the given number of threads, or as many as hardware threads
+when 0, including the calling thread, or returns NULL on failure
+*/
+
+inline libpostal_batch_t *libpostal_batch_new(size_t num_threads) {
+    if (num_threads == 0) {
+        num_threads = std::thread::hardware_concurrency();
+    }
+    libpostal_batch_t *batch = new (std::nothrow) libpostal_batch_t();
+    if (batch == NULL) {
+        return NULL;
+    }
+    try {
+        batch->pool = new bytedeco::BatchPool((int)num_threads);
+        batch->addresses.resize(batch->pool->size());
+    } catch (...) {
+        delete batch;
+        return NULL;
+    }
+    return batch;
+}
+
+/*
+Parses and/or expands, according to options, a combination of LIBPOSTAL_BATCH_PARSE
+and LIBPOSTAL_BATCH_EXPAND, the addresses at input[offsets[i]] to input[offsets[i + 1]]
+for i from 0 to num_addresses - 1, replacing the output of any previous batch.
+Returns false if memory ran out, in which case the output is empty.
+*/
+
+inline bool libpostal_batch_process(libpostal_batch_t *batch, const char *input, const size_t *offsets, size_t num_addresses,
+                                    int options, libpostal_address_parser_options_t parser_options,
+                                    libpostal_normalize_options_t normalize_options) {
+    try {
+        batch->input = input;
+        batch->offsets = offsets;
+        batch->num_addresses = num_addresses;
+        batch->options = options;
+        batch->parser_options = parser_options;
+        batch->normalize_options = normalize_options;
+        batch->num_chunks = (num_addresses + libpostal_batch::chunk_size - 1) / libpostal_batch::chunk_size;
+        if (batch->chunks.size() < batch->num_chunks) {
+            batch->chunks.resize(batch->num_chunks);
+        }
+        batch->results.resize(num_addresses);
+        batch->failed = false;
+        batch->run_phase(0);
+        if (batch->failed) {
+            throw std::bad_alloc();
+        }
+
+        size_t arena_size = 0, num_strings = 0;
+        for (size_t c = 0; c < batch->num_chunks; c++) {
+            batch->chunks[c].arena_base = arena_size;
+            batch->chunks[c].string_base = num_strings;
+            arena_size += batch->chunks[c].arena.size();
+            num_strings += batch->chunks[c].strings.size();
+        }
+        batch->arena.resize(arena_size);
+        batch->strings.resize(num_strings);
+        batch->run_phase(1);
+    } catch (...) {
+        batch->results.clear();
+        batch->strings.clear();
+        batch->arena.clear();
+        return false;
+    }
+    return true;
+}
+
+/*
+Accessors for the output of the last batch, valid until the next one or libpostal_batch_destroy()
+*/
+
+inline const libpostal_batch_result_t *libpostal_batch_results(const libpostal_batch_t *batch, size_t *n) {
+    *n = batch->results.size();
+    return batch->results.data();
+}
+
+inline const libpostal_batch_string_t *libpostal_batch_strings(const libpostal_batch_t *batch, size_t *n) {
+    *n = batch->strings.size();
+    return batch->strings.data();
+}
+
+inline const char *libpostal_batch_arena(const libpostal_batch_t *batch, size_t *size) {
+    *size = batch->arena.size();
+    return batch->arena.data();
+}
+
+inline void libpostal_batch_destroy(libpostal_batch_t *batch) {
+    delete batch;
+}
+
+#endif
@@ -0,0 +1,84 @@
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.util.ArrayList;
+import java.util.List;
+
+import org.bytedeco.javacpp.BytePointer;
+import org.bytedeco.javacpp.IntPointer;
+import org.bytedeco.javacpp.PointerPointer;
+import org.bytedeco.libraw.LibRaw;
+import org.bytedeco.libraw.LibRaw_batch_processor;
+import org.bytedeco.libraw.libraw_processed_image_t;
+
+import static org.bytedeco.libraw.global.LibRaw.*;
+
+/**
+ * Writes a preview of every RAW file of a directory, the embedded thumbnail when
+ * there is one, or else the half-size image, processing up to 64 files at once.
+ */
+public class LibRawBatchDemo {
+    static final int BATCH_SIZE = 64;
+
+    static void write(libraw_processed_image_t image, String name) throws IOException {
+        byte[] data = new byte[image.data_size()];
+        image.data().get(data);
+        boolean jpeg = image.type().value == LibRaw_image_formats.LIBRAW_IMAGE_JPEG.value;
+        try (OutputStream out = new FileOutputStream(name + (jpeg ? ".jpg" : ".ppm"))) {
+            if (!jpeg) {
+                // dcraw_make_mem_image() returns 8-bit RGB unless params.output_bps is 16
+                String header = (image.colors() == 1 ? "P5" : "P6") + "\n" + (image.width() & 0xFFFF) + " "
+                        + (image.height() & 0xFFFF) + "\n" + ((1 << image.bits()) - 1) + "\n";
+                out.write(header.getBytes("US-ASCII"));
+            }
+            out.write(data);
+        }
+    }
+
+    public static void main(String[] args) throws IOException {
+        File dir = new File(args.length > 0 ? args[0] : ".");
+        List<File> files = new ArrayList<File>();
+        File[] list = dir.listFiles();
+        for (File f : list != null ? list : new File[0]) {
+            String name = f.getName().toLowerCase();
+            if (name.endsWith(".dng") || name.endsWith(".cr2") || name.endsWith(".cr3") || name.endsWith(".nef")
+                    || name.endsWith(".arw") || name.endsWith(".raf") || name.endsWith(".orf") || name.endsWith(".rw2")) {
+                files.add(f);
+            }
+        }
+
+        try (LibRaw_batch_processor processor = new LibRaw_batch_processor()) {
+            System.out.println("Processing " + files.size() + " files with "
+                    + processor.threads_count() + " threads");
+            long start = System.nanoTime();
+            int made = 0;
+            for (int first = 0; first < files.size(); first += BATCH_SIZE) {
+                int count = Math.min(BATCH_SIZE, files.size() - first);
+                String[] names = new String[count];
+                for (int i = 0; i < count; i++) {
+                    names[i] = files.get(first + i).getPath();
+                }
+                try (PointerPointer fnames = new PointerPointer(names);
+                     PointerPointer images = new PointerPointer(count);
+                     IntPointer errors = new IntPointer(count)) {
+                    made += processor.process_files(fnames, count, LibRaw_batch_modes.LIBRAW_BATCH_PREVIEW.value, images, errors);
+                    for (int i = 0; i < count; i++) {
+                        libraw_processed_image_t image = images.get(libraw_processed_image_t.class, i);
+                        if (image == null) {
+                            try (BytePointer e = libraw_strerror(errors.get(i))) {
+                                System.err.println("Cannot process " + names[i] + " : " + e.getString());
+                            }
+                            continue;
+                        }
+                        write(image, names[i]);
+                        LibRaw.dcraw_clear_mem(image);
+                    }
+                }
+            }
+            long time = System.nanoTime() - start;
+            System.out.printf("Made %d previews in %.3f s%n", made, time / 1e9);
+        }
+        System.exit(0);
+    }
+}
@@ -0,0 +1,59 @@
+// Targeted by JavaCPP version 1.5.9-SNAPSHOT: DO NOT EDIT THIS FILE
+
+package org.bytedeco.libraw;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.libraw.global.LibRaw.*;
+
+
+@NoOffset @Properties(inherit = org.bytedeco.libraw.presets.LibRaw.class)
+public class LibRaw_batch_processor extends Pointer {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public LibRaw_batch_processor(Pointer p) { super(p); }
+
+  /* nthreads: number of LibRaw processors and threads, including the calling
+     one, or 0 for the number of hardware threads; flags: as for LibRaw() */
+  public LibRaw_batch_processor(int nthreads/*=0*/, @Cast("unsigned int") int flags/*=LIBRAW_OPTIONS_NONE*/) { super((Pointer)null); allocate(nthreads, flags); }
+  private native void allocate(int nthreads/*=0*/, @Cast("unsigned int") int flags/*=LIBRAW_OPTIONS_NONE*/);
+  public LibRaw_batch_processor() { super((Pointer)null); allocate(); }
+  private native void allocate();
+
+  public native int threads_count();
+
+  /* Output parameters copied to the processors before each file, initially those of LibRaw() */
+  public native libraw_output_params_t output_params_ptr();
+
+  /* Processes count files in the given mode, one of LibRaw_batch_modes, storing
+     images[i] for files[i], or NULL with its error code in errors[i], if not NULL.
+     Returns the number of images made. */
+  public native int process_files(@Cast("const char*const*") PointerPointer fnames, int count, int mode,
+                      @Cast("libraw_processed_image_t**") PointerPointer images, IntPointer errors/*=NULL*/);
+  public native int process_files(@Cast("const char*const*") PointerPointer fnames, int count, int mode,
+                      @Cast("libraw_processed_image_t**") PointerPointer images);
+  public native int process_files(@Cast("const char*const*") @ByPtrPtr BytePointer fnames, int count, int mode,
+                      @ByPtrPtr libraw_processed_image_t images, IntBuffer errors/*=NULL*/);
+  public native int process_files(@Cast("const char*const*") @ByPtrPtr BytePointer fnames, int count, int mode,
+                      @ByPtrPtr libraw_processed_image_t images);
+  public native int process_files(@Cast("const char*const*") @ByPtrPtr String fnames, int count, int mode,
+                      @ByPtrPtr libraw_processed_image_t images, int[] errors/*=NULL*/);
+  public native int process_files(@Cast("const char*const*") @ByPtrPtr String fnames, int count, int mode,
+                      @ByPtrPtr libraw_processed_image_t images);
+
+  /* The same for count buffers already in memory */
+  public native int process_buffers(@Cast("void*const*") PointerPointer buffers, @Cast("const size_t*") SizeTPointer sizes, int count, int mode,
+                        @Cast("libraw_processed_image_t**") PointerPointer images, IntPointer errors/*=NULL*/);
+  public native int process_buffers(@Cast("void*const*") PointerPointer buffers, @Cast("const size_t*") SizeTPointer sizes, int count, int mode,
+                        @Cast("libraw_processed_image_t**") PointerPointer images);
+  public native int process_buffers(@Cast("void*const*") @ByPtrPtr Pointer buffers, @Cast("const size_t*") SizeTPointer sizes, int count, int mode,
+                        @ByPtrPtr libraw_processed_image_t images, IntBuffer errors/*=NULL*/);
+  public native int process_buffers(@Cast("void*const*") @ByPtrPtr Pointer buffers, @Cast("const size_t*") SizeTPointer sizes, int count, int mode,
+                        @ByPtrPtr libraw_processed_image_t images);
+  public native int process_buffers(@Cast("void*const*") @ByPtrPtr Pointer buffers, @Cast("const size_t*") SizeTPointer sizes, int count, int mode,
+                        @ByPtrPtr libraw_processed_image_t images, int[] errors/*=NULL*/);
+}
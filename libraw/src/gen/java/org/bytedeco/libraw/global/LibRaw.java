@@ -1396,4 +1396,63 @@ public static final long LIBRAW_USE_STREAMS_DATASTREAM_MAXSIZE = (250 * 1024L *
 // #endif /* _LIBRAW_CLASS_H */
 
 
+// Parsed from libraw_batch.h
+
+/* -*- C++ -*-
+ * File: libraw_batch.h
+ *
+ * Batch processing of RAW files with a pool of LibRaw processors
+ *
+ * A LibRaw_batch_processor owns one LibRaw object per thread and processes
+ * many files or buffers at once: files are memory-mapped and opened with
+ * open_buffer(), then unpacked and processed concurrently, each into a
+ * libraw_processed_image_t to free with LibRaw::dcraw_clear_mem(). Previews
+ * can be made from the half-size image, which bins 2x2 pixels instead of
+ * demosaicing, or from the embedded thumbnail, without unpacking the raw data.
+ *
+ * A processor handles one batch at a time, with process_files() and
+ * process_buffers() running on all its threads and returning once done, so it
+ * must not be used by several threads at once. LibRaw itself may use OpenMP in
+ * some stages, so OMP_NUM_THREADS=1 usually works best when all the threads of
+ * the pool are busy.
+ */
+
+// #ifndef _LIBRAW_BATCH_H
+// #define _LIBRAW_BATCH_H
+
+// #include <atomic>
+// #include <new>
+// #include <thread>
+// #include <vector>
+// #ifdef _WIN32
+// #include <windows.h>
+// #else
+// #include <fcntl.h>
+// #include <sys/mman.h>
+// #include <sys/stat.h>
+// #include <unistd.h>
+// #endif
+
+// #include "libraw/libraw.h"
+// #include "batch_pool.h"
+
+public enum LibRaw_batch_modes {
+  LIBRAW_BATCH_FULL(0),      /* unpack(), dcraw_process() and dcraw_make_mem_image() */
+  LIBRAW_BATCH_HALF_SIZE(1), /* the same with params.half_size set */
+  LIBRAW_BATCH_THUMBNAIL(2), /* unpack_thumb() and dcraw_make_mem_thumb() */
+  LIBRAW_BATCH_PREVIEW(3);    /* the thumbnail if there is one, or else the half-size image */
+
+    public final int value;
+    private LibRaw_batch_modes(int v) { this.value = v; }
+    private LibRaw_batch_modes(LibRaw_batch_modes e) { this.value = e.value; }
+    public LibRaw_batch_modes intern() { for (LibRaw_batch_modes e : values()) if (e.value == value) return e; return this; }
+    @Override public String toString() { return intern().name(); }
+}
+// Targeting ../LibRaw_batch_processor.java
+
+
+
+// #endif /* _LIBRAW_BATCH_H */
+
+
 }
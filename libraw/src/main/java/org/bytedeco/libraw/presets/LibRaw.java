@@ -47,7 +47,9 @@ import org.bytedeco.javacpp.tools.InfoMapper;
                                 "libraw/libraw_types.h",
                                 "libraw/libraw_datastream.h",
                                 "libraw/libraw.h",
+                                "libraw_batch.h",
                         },
+                        compiler = "cpp11",
                         link = "raw_r@.20",
                         preload = "gomp@.1"
                 ),
@@ -138,6 +140,11 @@ public class LibRaw implements InfoMapper {
                 //
                 .put(new Info("LibRaw::get_internal_data_pointer").skip(true))
 
+                //
+                // libraw_batch.h
+                //
+                .put(new Info("libraw_batch.h").linePatterns("^#ifndef LIBRAW_BATCH_PRIVATE_H$", "^#endif /\\* LIBRAW_BATCH_PRIVATE_H \\*/$").skip())
+
                 //
                 // To build on non-Windows
                 //
@@ -0,0 +1,292 @@
+/* -*- C++ -*-
+ * File: libraw_batch.h
+ *
+ * Batch processing of RAW files with a pool of LibRaw processors
+ *
+ * A LibRaw_batch_processor owns one LibRaw object per thread and processes
+ * many files or buffers at once: files are memory-mapped and opened with
+ * open_buffer(), then unpacked and processed concurrently, each into a
+ * libraw_processed_image_t to free with LibRaw::dcraw_clear_mem(). Previews
+ * can be made from the half-size image, which bins 2x2 pixels instead of
+ * demosaicing, or from the embedded thumbnail, without unpacking the raw data.
+ *
+ * A processor handles one batch at a time, with process_files() and
+ * process_buffers() running on all its threads and returning once done, so it
+ * must not be used by several threads at once. LibRaw itself may use OpenMP in
+ * some stages, so OMP_NUM_THREADS=1 usually works best when all the threads of
+ * the pool are busy.
+ */
+
+#ifndef _LIBRAW_BATCH_H
+#define _LIBRAW_BATCH_H
+
+#include <atomic>
+#include <new>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "libraw/libraw.h"
+#include "batch_pool.h"
+
+enum LibRaw_batch_modes
+{
+  LIBRAW_BATCH_FULL = 0,      /* unpack(), dcraw_process() and dcraw_make_mem_image() */
+  LIBRAW_BATCH_HALF_SIZE = 1, /* the same with params.half_size set */
+  LIBRAW_BATCH_THUMBNAIL = 2, /* unpack_thumb() and dcraw_make_mem_thumb() */
+  LIBRAW_BATCH_PREVIEW = 3    /* the thumbnail if there is one, or else the half-size image */
+};
+
+#ifndef LIBRAW_BATCH_PRIVATE_H
+#define LIBRAW_BATCH_PRIVATE_H
+
+/* A file mapped read-only in memory */
+struct libraw_mapped_file_t
+{
+  void *data;
+  size_t size;
+#ifdef _WIN32
+  HANDLE mapping;
+#endif
+
+  libraw_mapped_file_t() : data(NULL), size(0)
+  {
+#ifdef _WIN32
+    mapping = NULL;
+#endif
+  }
+
+  int map(const char *fname, bool sequential)
+  {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+      return LIBRAW_IO_ERROR;
+    LARGE_INTEGER fsize;
+    if (!GetFileSizeEx(file, &fsize) || fsize.QuadPart == 0)
+    {
+      CloseHandle(file);
+      return LIBRAW_IO_ERROR;
+    }
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL)
+      return LIBRAW_IO_ERROR;
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL)
+    {
+      CloseHandle(mapping);
+      mapping = NULL;
+      return LIBRAW_IO_ERROR;
+    }
+    size = (size_t)fsize.QuadPart;
+#else
+    int fd = open(fname, O_RDONLY);
+    if (fd < 0)
+      return LIBRAW_IO_ERROR;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+      close(fd);
+      return LIBRAW_IO_ERROR;
+    }
+    void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+      return LIBRAW_IO_ERROR;
+    if (sequential)
+      madvise(p, (size_t)st.st_size, MADV_SEQUENTIAL);
+    data = p;
+    size = (size_t)st.st_size;
+#endif
+    return LIBRAW_SUCCESS;
+  }
+
+  void unmap()
+  {
+    if (data == NULL)
+      return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(mapping);
+    mapping = NULL;
+#else
+    munmap(data, size);
+#endif
+    data = NULL;
+    size = 0;
+  }
+
+  ~libraw_mapped_file_t() { unmap(); }
+};
+
+#endif /* LIBRAW_BATCH_PRIVATE_H */
+
+class LibRaw_batch_processor
+{
+public:
+  /* nthreads: number of LibRaw processors and threads, including the calling
+     one, or 0 for the number of hardware threads; flags: as for LibRaw() */
+  LibRaw_batch_processor(int nthreads = 0, unsigned int flags = LIBRAW_OPTIONS_NONE)
+      : pool(NULL), next(0), count(0), mode(0),
+        files(NULL), buffers(NULL), sizes(NULL), images(NULL), errors(NULL), produced(0)
+  {
+    if (nthreads <= 0)
+      nthreads = (int)std::thread::hardware_concurrency();
+    if (nthreads <= 0)
+      nthreads = 1;
+    try
+    {
+      processors.reserve(nthreads);
+      for (int i = 0; i < nthreads; i++)
+        processors.push_back(new LibRaw(flags));
+      params = processors[0]->imgdata.params;
+      pool = new bytedeco::BatchPool(nthreads);
+    }
+    catch (...)
+    {
+      shutdown();
+      throw;
+    }
+  }
+  ~LibRaw_batch_processor() { shutdown(); }
+
+  int threads_count() const { return (int)processors.size(); }
+
+  /* Output parameters copied to the processors before each file, initially those of LibRaw() */
+  libraw_output_params_t *output_params_ptr() { return &params; }
+
+  /* Processes count files in the given mode, one of LibRaw_batch_modes, storing
+     images[i] for files[i], or NULL with its error code in errors[i], if not NULL.
+     Returns the number of images made. */
+  int process_files(const char *const *fnames, int count, int mode,
+                    libraw_processed_image_t **images, int *errors = NULL)
+  {
+    return run(fnames, NULL, NULL, count, mode, images, errors);
+  }
+
+  /* The same for count buffers already in memory */
+  int process_buffers(void *const *buffers, const size_t *sizes, int count, int mode,
+                      libraw_processed_image_t **images, int *errors = NULL)
+  {
+    return run(NULL, buffers, sizes, count, mode, images, errors);
+  }
+
+private:
+  std::vector<LibRaw *> processors;
+  bytedeco::BatchPool *pool; /* calls jobs with the index of the processor of the thread */
+  libraw_output_params_t params;
+
+  /* state of the batch being processed */
+  std::atomic<int> next;
+  int count, mode;
+  const char *const *files;
+  void *const *buffers;
+  const size_t *sizes;
+  libraw_processed_image_t **images;
+  int *errors;
+  std::atomic<int> produced;
+
+  LibRaw_batch_processor(const LibRaw_batch_processor &);
+  LibRaw_batch_processor &operator=(const LibRaw_batch_processor &);
+
+  void shutdown()
+  {
+    delete pool;
+    pool = NULL;
+    for (size_t i = 0; i < processors.size(); i++)
+      delete processors[i];
+    processors.clear();
+  }
+
+  libraw_processed_image_t *process_one(LibRaw *proc, int i, int *err)
+  {
+    libraw_mapped_file_t file;
+    void *data;
+    size_t size;
+    if (files != NULL)
+    {
+      if ((*err = file.map(files[i], mode == LIBRAW_BATCH_FULL || mode == LIBRAW_BATCH_HALF_SIZE)) != LIBRAW_SUCCESS)
+        return NULL;
+      data = file.data;
+      size = file.size;
+    }
+    else
+    {
+      data = buffers[i];
+      size = sizes[i];
+    }
+
+    libraw_processed_image_t *image = NULL;
+    proc->imgdata.params = params;
+    if ((*err = proc->open_buffer(data, size)) == LIBRAW_SUCCESS)
+    {
+      if (mode == LIBRAW_BATCH_THUMBNAIL || mode == LIBRAW_BATCH_PREVIEW)
+      {
+        if ((*err = proc->unpack_thumb()) == LIBRAW_SUCCESS)
+          image = proc->dcraw_make_mem_thumb(err);
+      }
+      if (image == NULL && mode != LIBRAW_BATCH_THUMBNAIL && !LIBRAW_FATAL_ERROR(*err))
+      {
+        if (mode != LIBRAW_BATCH_FULL)
+          proc->imgdata.params.half_size = 1;
+        if ((*err = proc->unpack()) == LIBRAW_SUCCESS && (*err = proc->dcraw_process()) == LIBRAW_SUCCESS)
+          image = proc->dcraw_make_mem_image(err);
+      }
+    }
+    /* release the buffer before unmapping the file */
+    proc->recycle();
+    if (image == NULL && *err == LIBRAW_SUCCESS)
+      *err = LIBRAW_UNSUFFICIENT_MEMORY;
+    return image;
+  }
+
+  void work(LibRaw *proc)
+  {
+    for (int i = next++; i < count; i = next++)
+    {
+      int err = LIBRAW_SUCCESS;
+      libraw_processed_image_t *image = NULL;
+      try
+      {
+        image = process_one(proc, i, &err);
+      }
+      catch (...)
+      {
+        proc->recycle();
+        err = LIBRAW_UNSUFFICIENT_MEMORY;
+      }
+      images[i] = image;
+      if (errors != NULL)
+        errors[i] = err;
+      if (image != NULL)
+        produced++;
+    }
+  }
+
+  int run(const char *const *f, void *const *b, const size_t *s, int n, int m,
+          libraw_processed_image_t **im, int *er)
+  {
+    files = f;
+    buffers = b;
+    sizes = s;
+    count = n;
+    mode = m;
+    images = im;
+    errors = er;
+    next = 0;
+    produced = 0;
+    pool->run([this](int index) { work(processors[index]); });
+    return produced;
+  }
+};
+
+#endif /* _LIBRAW_BATCH_H */
@@ -0,0 +1,80 @@
+import java.nio.FloatBuffer;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.liquidfun.*;
+import static org.bytedeco.liquidfun.global.liquidfun.*;
+
+/**
+ * Reports the time taken by b2World.Step() to step a single particle system
+ * versus its number of particles, and reads the positions of the particles in
+ * place with b2ParticleSystem_GetPositionData() after each step, without copying.
+ * LiquidFun steps a particle system on the calling thread only.
+ *
+ * Run with: mvn compile exec:java -Dexec.mainClass=ParticleBenchmark
+ */
+public class ParticleBenchmark {
+  static final int WARMUP_STEPS = 10, STEPS = 50;
+  static final float RADIUS = 0.05f, TIME_STEP = 1.0f / 60.0f;
+
+  static b2World createWorld(int particleCount) {
+    b2World w = new b2World(0.0f, -10.0f);
+
+    // a box to hold the liquid
+    b2BodyDef bd = new b2BodyDef();
+    b2Body ground = w.CreateBody(bd);
+    b2PolygonShape wall = new b2PolygonShape();
+    b2FixtureDef fd = new b2FixtureDef();
+    fd.shape(wall);
+    float side = (float)Math.sqrt(particleCount) * RADIUS * 2;
+    wall.SetAsBox(side, 0.1f, new b2Vec2(0.0f, -0.1f), 0.0f);
+    ground.CreateFixture(fd);
+    wall.SetAsBox(0.1f, 2 * side, new b2Vec2(-side - 0.1f, side), 0.0f);
+    ground.CreateFixture(fd);
+    wall.SetAsBox(0.1f, 2 * side, new b2Vec2(side + 0.1f, side), 0.0f);
+    ground.CreateFixture(fd);
+
+    // a square block of water that fills about half of it
+    b2ParticleSystemDef psd = new b2ParticleSystemDef();
+    psd.radius(RADIUS);
+    b2ParticleSystem ps = w.CreateParticleSystem(psd);
+    b2PolygonShape block = new b2PolygonShape();
+    block.SetAsBox(side / 2, side / 2, new b2Vec2(0.0f, side), 0.0f);
+    b2ParticleGroupDef pgd = new b2ParticleGroupDef();
+    pgd.flags(b2_waterParticle);
+    pgd.shape(block);
+    ps.CreateParticleGroup(pgd);
+    return w;
+  }
+
+  public static void main(String[] args) {
+    int[] particleCounts = {12500, 25000, 50000, 100000};
+
+    System.out.println("particles,ms/step,us/step/particle");
+    for (int particleCount : particleCounts) {
+      b2World w = createWorld(particleCount);
+      b2ParticleSystem ps = w.GetParticleSystemList();
+      for (int i = 0; i < WARMUP_STEPS; i++) {
+        w.Step(TIME_STEP, 8, 3, 1);
+      }
+      long total = 0;
+      double sum = 0;
+      for (int i = 0; i < STEPS; i++) {
+        long start = System.nanoTime();
+        w.Step(TIME_STEP, 8, 3, 1);
+        total += System.nanoTime() - start;
+
+        // the buffer may be reallocated by a step, so get it again each time
+        FloatBuffer positions = b2ParticleSystem_GetPositionData(ps).capacity(2 * ps.GetParticleCount()).asBuffer();
+        for (int j = 1; j < positions.limit(); j += 2) {
+          sum += positions.get(j);
+        }
+      }
+      if (Double.isNaN(sum)) {
+        throw new IllegalStateException("Simulation diverged");
+      }
+      double ms = total / 1e6 / STEPS;
+      System.out.printf("%d,%.3f,%.4f%n", ps.GetParticleCount(), ms, 1000 * ms / ps.GetParticleCount());
+      w.deallocate();
+    }
+    System.exit(0);
+  }
+}
@@ -919,6 +919,7 @@ public static native @Cast("bool") boolean b2TestOverlap(@Const @ByRef b2AABB a,
 // #include <Box2D/Common/b2Settings.h>
 // #include <Box2D/Collision/b2Collision.h>
 // #include <Box2D/Collision/b2DynamicTree.h>
+// #include <Box2D/Particle/b2ParticleSystem.h>
 // #include <algorithm>
 // Targeting ../b2Pair.java
 
@@ -2560,6 +2561,7 @@ public static final int
 // Parsed from liquidfun_adapters.h
 
 // #include <Box2D/Common/b2Settings.h>
+// #include <Box2D/Collision/b2DynamicTree.h>
 // Targeting ../b2DynamicTreeQueryCallback.java
 
 
@@ -2567,5 +2569,50 @@ public static final int
 
 
 
+/** Query the tree with aabbs[begin, end) without calling back into Java.
+ *  The IDs of the nodes overlapping aabbs[i] are written to
+ *  nodeIds[i * maxHits, (i + 1) * maxHits) and their total number, which
+ *  may exceed maxHits, to hitCounts[i]. Only the output slots of the range
+ *  are touched, so threads may process disjoint ranges of one batch at once.
+ *  @return the number of node IDs written. */
+public static native @Cast("int32") int b2DynamicTree_QueryBatch(@Const b2DynamicTree tree, @Const b2AABB aabbs,
+                               @Cast("int32") int begin, @Cast("int32") int end, @Cast("int32") int maxHits,
+                               @Cast("int32*") IntPointer hitCounts, @Cast("int32*") IntPointer nodeIds);
+public static native @Cast("int32") int b2DynamicTree_QueryBatch(@Const b2DynamicTree tree, @Const b2AABB aabbs,
+                               @Cast("int32") int begin, @Cast("int32") int end, @Cast("int32") int maxHits,
+                               @Cast("int32*") IntBuffer hitCounts, @Cast("int32*") IntBuffer nodeIds);
+public static native @Cast("int32") int b2DynamicTree_QueryBatch(@Const b2DynamicTree tree, @Const b2AABB aabbs,
+                               @Cast("int32") int begin, @Cast("int32") int end, @Cast("int32") int maxHits,
+                               @Cast("int32*") int[] hitCounts, @Cast("int32*") int[] nodeIds);
+
+/** Ray-cast inputs[begin, end) against the tree without calling back into Java.
+ *  The IDs of the nodes hit by inputs[i] are written to
+ *  nodeIds[i * maxHits, (i + 1) * maxHits) along with the fractions at which
+ *  the ray enters their fat AABB, and their total number to hitCounts[i].
+ *  If closestOnly is true, only the nearest node is reported, and the
+ *  traversal is clipped as it goes. Threads may process disjoint ranges at once.
+ *  @return the number of node IDs written. */
+public static native @Cast("int32") int b2DynamicTree_RayCastBatch(@Const b2DynamicTree tree, @Const b2RayCastInput inputs,
+                                 @Cast("int32") int begin, @Cast("int32") int end, @Cast("int32") int maxHits, @Cast("bool") boolean closestOnly,
+                                 @Cast("int32*") IntPointer hitCounts, @Cast("int32*") IntPointer nodeIds, @Cast("float32*") FloatPointer fractions);
+public static native @Cast("int32") int b2DynamicTree_RayCastBatch(@Const b2DynamicTree tree, @Const b2RayCastInput inputs,
+                                 @Cast("int32") int begin, @Cast("int32") int end, @Cast("int32") int maxHits, @Cast("bool") boolean closestOnly,
+                                 @Cast("int32*") IntBuffer hitCounts, @Cast("int32*") IntBuffer nodeIds, @Cast("float32*") FloatBuffer fractions);
+public static native @Cast("int32") int b2DynamicTree_RayCastBatch(@Const b2DynamicTree tree, @Const b2RayCastInput inputs,
+                                 @Cast("int32") int begin, @Cast("int32") int end, @Cast("int32") int maxHits, @Cast("bool") boolean closestOnly,
+                                 @Cast("int32*") int[] hitCounts, @Cast("int32*") int[] nodeIds, @Cast("float32*") float[] fractions);
+
+/** Get the position buffer of the particles as an array of floats, without copying.
+ *  Each attribute of the particles has a buffer of its own, but a position is a
+ *  b2Vec2, so the x and y of each particle are interleaved in this one.
+ *  The array holds 2 * GetParticleCount() values and is valid until the next step. */
+public static native @Cast("float32*") FloatPointer b2ParticleSystem_GetPositionData(b2ParticleSystem system);
+
+/** Get the velocity buffer of the particles as an array of floats, without copying,
+ *  with the x and y of each particle interleaved as for the positions.
+ *  The array holds 2 * GetParticleCount() values and is valid until the next step. */
+public static native @Cast("float32*") FloatPointer b2ParticleSystem_GetVelocityData(b2ParticleSystem system);
+
+
 
 }
@@ -75,6 +75,7 @@ import org.bytedeco.javacpp.tools.InfoMapper;
                          "<Box2D/Particle/b2ParticleSystem.h>",
                          "liquidfun_adapters.h"
                          },
+              compiler = "cpp11",
               link = "liquidfun@.2.3.0")
 })
 public class liquidfun implements InfoMapper {
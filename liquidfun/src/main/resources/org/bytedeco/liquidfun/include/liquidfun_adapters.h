@@ -1,4 +1,6 @@
 #include <Box2D/Common/b2Settings.h>
+#include <Box2D/Collision/b2DynamicTree.h>
+#include <Box2D/Particle/b2ParticleSystem.h>
 
 class b2DynamicTreeQueryCallback {
  public:
@@ -9,3 +11,106 @@ class b2DynamicTreeRayCastCallback {
  public:
   virtual bool RayCastCallback(b2RayCastInput& subInput, int32 nodeId) = 0;
 };
+
+/// Query the tree with aabbs[begin, end) without calling back into Java.
+/// The IDs of the nodes overlapping aabbs[i] are written to
+/// nodeIds[i * maxHits, (i + 1) * maxHits) and their total number, which
+/// may exceed maxHits, to hitCounts[i]. Only the output slots of the range
+/// are touched, so threads may process disjoint ranges of one batch at once.
+/// @return the number of node IDs written.
+inline int32 b2DynamicTree_QueryBatch(const b2DynamicTree* tree, const b2AABB* aabbs,
+                                      int32 begin, int32 end, int32 maxHits,
+                                      int32* hitCounts, int32* nodeIds) {
+  struct Collector {
+    int32 maxHits, count;
+    int32* nodeIds;
+    bool QueryCallback(int32 nodeId) {
+      if (count < maxHits) {
+        nodeIds[count] = nodeId;
+      }
+      count++;
+      return true;
+    }
+  };
+
+  int32 written = 0;
+  for (int32 i = begin; i < end; i++) {
+    Collector collector = { maxHits, 0, nodeIds + (size_t)i * maxHits };
+    tree->Query(&collector, aabbs[i]);
+    hitCounts[i] = collector.count;
+    written += b2Min(collector.count, maxHits);
+  }
+  return written;
+}
+
+/// Ray-cast inputs[begin, end) against the tree without calling back into Java.
+/// The IDs of the nodes hit by inputs[i] are written to
+/// nodeIds[i * maxHits, (i + 1) * maxHits) along with the fractions at which
+/// the ray enters their fat AABB, and their total number to hitCounts[i].
+/// If closestOnly is true, only the nearest node is reported, and the
+/// traversal is clipped as it goes. Threads may process disjoint ranges at once.
+/// @return the number of node IDs written.
+inline int32 b2DynamicTree_RayCastBatch(const b2DynamicTree* tree, const b2RayCastInput* inputs,
+                                        int32 begin, int32 end, int32 maxHits, bool closestOnly,
+                                        int32* hitCounts, int32* nodeIds, float32* fractions) {
+  struct Collector {
+    const b2DynamicTree* tree;
+    int32 maxHits, count;
+    bool closestOnly;
+    int32* nodeIds;
+    float32* fractions;
+    float32 RayCastCallback(const b2RayCastInput& subInput, int32 nodeId) {
+      const b2AABB& aabb = tree->GetFatAABB(nodeId);
+      const b2Vec2& p = subInput.p1;
+      float32 fraction;
+      b2RayCastOutput output;
+      if (aabb.lowerBound.x <= p.x && p.x <= aabb.upperBound.x &&
+          aabb.lowerBound.y <= p.y && p.y <= aabb.upperBound.y) {
+        fraction = 0.0f;
+      } else if (aabb.RayCast(&output, subInput)) {
+        fraction = output.fraction;
+      } else {
+        return -1.0f; // the fat AABB only overlaps the bounds of the segment
+      }
+      if (closestOnly) {
+        count = 1;
+        if (maxHits > 0) {
+          nodeIds[0] = nodeId;
+          fractions[0] = fraction;
+        }
+        return fraction; // clip the ray, or terminate if it starts inside
+      }
+      if (count < maxHits) {
+        nodeIds[count] = nodeId;
+        fractions[count] = fraction;
+      }
+      count++;
+      return -1.0f; // keep going without clipping
+    }
+  };
+
+  int32 written = 0;
+  for (int32 i = begin; i < end; i++) {
+    size_t offset = (size_t)i * maxHits;
+    Collector collector = { tree, maxHits, 0, closestOnly, nodeIds + offset, fractions + offset };
+    tree->RayCast(&collector, inputs[i]);
+    hitCounts[i] = collector.count;
+    written += b2Min(collector.count, maxHits);
+  }
+  return written;
+}
+
+/// Get the position buffer of the particles as an array of floats, without copying.
+/// Each attribute of the particles has a buffer of its own, but a position is a
+/// b2Vec2, so the x and y of each particle are interleaved in this one.
+/// The array holds 2 * GetParticleCount() values and is valid until the next step.
+inline float32* b2ParticleSystem_GetPositionData(b2ParticleSystem* system) {
+  return &system->GetPositionBuffer()->x;
+}
+
+/// Get the velocity buffer of the particles as an array of floats, without copying,
+/// with the x and y of each particle interleaved as for the positions.
+/// The array holds 2 * GetParticleCount() values and is valid until the next step.
+inline float32* b2ParticleSystem_GetVelocityData(b2ParticleSystem* system) {
+  return &system->GetVelocityBuffer()->x;
+}
@@ -1,8 +1,25 @@
+import java.io.BufferedReader;
+import java.io.File;
+import java.io.IOException;
+import java.io.InputStreamReader;
+import java.io.PrintWriter;
+import java.net.URL;
+import java.net.URLClassLoader;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.LinkedHashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
 import java.util.Random;
+import java.util.Set;
 import org.bytedeco.javacpp.*;
+import org.bytedeco.dnnl.*;
 import org.bytedeco.libffi.*;
 import org.bytedeco.llvm.LLVM.*;
 
+import static org.bytedeco.dnnl.global.dnnl.*;
 import static org.bytedeco.libffi.global.ffi.*;
 import static org.bytedeco.llvm.global.LLVM.*;
 import static org.bytedeco.mkl.global.mkl_rt.*;
@@ -10,88 +27,696 @@ import static org.bytedeco.mkl.global.mkl_rt.*;
 /**
  * Matrix multiply benchmark.
  *
+ * Measures the GFLOP/s of OpenBLAS, MKL, MKL JIT, DNNL matmul, code generated by LLVM with Polly,
+ * and pure Java, for square, tall-skinny, and small batched shapes, in single and double precision,
+ * with various numbers of threads, and prints a table, optionally saved as CSV or JSON.
+ *
  * To run this sample, execute this command:
- * mvn clean compile exec:java -Djavacpp.platform.host
+ * mvn clean compile exec:java -Djavacpp.platform.host -Dexec.args="--csv results.csv --json results.json"
+ *
+ * Options, all optional:
+ *   --backends openblas,mkl,mkl-jit,dnnl,polly,java   backends to measure, all but java by default
+ *   --types f32,f64                                   precisions, both by default
+ *   --threads 1,max                                   numbers of threads, 1 and all cores by default
+ *   --shapes square,tall-skinny,small-batched         predefined shapes, all by default
+ *   --sizes MxNxK,BxMxNxK,...                         custom shapes, B being the batch size
+ *   --min-time 0.5                                    minimum time in seconds to measure each case
+ *   --csv FILE, --json FILE                           files where to save the results
+ *
+ * Each backend runs in its own JVM, since OpenBLAS and MKL export the same functions, and they
+ * may not all use the same OpenMP runtime. To avoid measuring JNI and libffi, each backend gets
+ * called from a loop generated with LLVM, except for pure Java. Backends that fail to load or do
+ * not support a case, like DNNL with f64, show up as "-" in the table and are omitted from files.
  *
  * If you set usePollyParallel, you may have to modify the file name of LLVMLoadLibraryPermanently().
  *
- * Note: This code is equivalent to this:
+ * Note: The Polly kernels are equivalent to this:
  * clang -O3 -march=native -mllvm -polly -mllvm -polly-vectorizer=stripmine
  *
- * Note: Instead of JNA or libffi, to obtain maximum performance, FunctionPointer should be used as shown here:
- * https://github.com/bytedeco/javacpp/blob/master/src/test/java/org/bytedeco/javacpp/PointerTest.java
- *
  * @author Yu Kobayashi
  */
 public class MatMulBenchmark {
-    static final int M = 2000, N = 2000, K = 2000;
     static final boolean usePolly = true;
     static final boolean usePollyParallel = true;
-    static final boolean printResult = false;
+    static final String RESULT = "RESULT,";
 
     static final BytePointer cpu = LLVMGetHostCPUName();
     static LLVMTypeRef llvmVoidType;
     static LLVMTypeRef llvmInt32Type;
-    static LLVMTypeRef llvmFloatType;
-    static LLVMTypeRef llvmFloatPointerType;
+    static LLVMTypeRef llvmInt64Type;
+    static LLVMTypeRef llvmVoidPointerType;
+
+    /** A shape of batch multiplications of M x K by K x N matrices, in row-major order. */
+    static class Shape {
+        final String category;
+        final int batch, m, n, k;
+
+        Shape(String category, int batch, int m, int n, int k) {
+            this.category = category;
+            this.batch = batch;
+            this.m = m;
+            this.n = n;
+            this.k = k;
+        }
+
+        double flops() {
+            return 2.0 * batch * m * n * k;
+        }
+
+        @Override public String toString() {
+            return (batch > 1 ? batch + "x" : "") + m + "x" + n + "x" + k;
+        }
+    }
+
+    static final Shape[] shapes = {
+        new Shape("square", 1, 256, 256, 256),
+        new Shape("square", 1, 1024, 1024, 1024),
+        new Shape("square", 1, 2048, 2048, 2048),
+        new Shape("tall-skinny", 1, 65536, 64, 64),
+        new Shape("tall-skinny", 1, 65536, 16, 256),
+        new Shape("tall-skinny", 1, 64, 64, 65536),
+        new Shape("small-batched", 4096, 8, 8, 8),
+        new Shape("small-batched", 1024, 16, 16, 16),
+        new Shape("small-batched", 256, 32, 32, 32),
+        new Shape("small-batched", 64, 64, 64, 64),
+    };
+
+    static class Options {
+        List<String> backends = Arrays.asList("openblas", "mkl", "mkl-jit", "dnnl", "polly");
+        List<String> types = Arrays.asList("f32", "f64");
+        List<Integer> threads = new ArrayList<>(new LinkedHashSet<>(Arrays.asList(1, Runtime.getRuntime().availableProcessors())));
+        List<Shape> shapes = new ArrayList<>();
+        double minTime = 0.5;
+        String csv, json, worker;
+
+        static Options parse(String[] args) {
+            Options o = new Options();
+            List<String> categories = Arrays.asList("square", "tall-skinny", "small-batched");
+            List<Shape> sizes = new ArrayList<>();
+            for (int i = 0; i < args.length; i++) {
+                String value = i + 1 < args.length ? args[i + 1] : null;
+                switch (args[i]) {
+                    case "--backends": o.backends = Arrays.asList(value.split(",")); break;
+                    case "--types":    o.types = Arrays.asList(value.split(",")); break;
+                    case "--shapes":   categories = Arrays.asList(value.split(",")); break;
+                    case "--min-time": o.minTime = Double.parseDouble(value); break;
+                    case "--csv":      o.csv = value; break;
+                    case "--json":     o.json = value; break;
+                    case "--worker":   o.worker = value; break;
+                    case "--threads":
+                        o.threads = new ArrayList<>();
+                        for (String s : value.split(",")) {
+                            o.threads.add(s.equals("max") ? Runtime.getRuntime().availableProcessors() : Integer.parseInt(s));
+                        }
+                        break;
+                    case "--sizes":
+                        for (String s : value.split(",")) {
+                            String[] d = s.split("x");
+                            int b = d.length > 3 ? Integer.parseInt(d[0]) : 1;
+                            sizes.add(new Shape("custom", b, Integer.parseInt(d[d.length - 3]),
+                                    Integer.parseInt(d[d.length - 2]), Integer.parseInt(d[d.length - 1])));
+                        }
+                        categories = new ArrayList<>();
+                        break;
+                    default: throw new IllegalArgumentException("Unknown option: " + args[i]);
+                }
+                i++;
+            }
+            for (Shape s : MatMulBenchmark.shapes) {
+                if (categories.contains(s.category)) {
+                    o.shapes.add(s);
+                }
+            }
+            o.shapes.addAll(sizes);
+            return o;
+        }
+    }
+
+    /** One line of the tables, also what workers print to their standard output. */
+    static class Result {
+        String backend, type, category, shape;
+        int threads, batch, m, n, k;
+        long iterations;
+        double seconds, gflops;
+        boolean valid;
+
+        static final String header = "backend,type,threads,category,shape,batch,m,n,k,iterations,seconds,gflops,valid";
+
+        String toCSV() {
+            return String.format(Locale.ROOT, "%s,%s,%d,%s,%s,%d,%d,%d,%d,%d,%.6f,%.3f,%b",
+                    backend, type, threads, category, shape, batch, m, n, k, iterations, seconds, gflops, valid);
+        }
+
+        String toJSON() {
+            return String.format(Locale.ROOT, "{\"backend\": \"%s\", \"type\": \"%s\", \"threads\": %d, \"category\": \"%s\", "
+                    + "\"shape\": \"%s\", \"batch\": %d, \"m\": %d, \"n\": %d, \"k\": %d, \"iterations\": %d, "
+                    + "\"seconds\": %.6f, \"gflops\": %.3f, \"valid\": %b}",
+                    backend, type, threads, category, shape, batch, m, n, k, iterations, seconds, gflops, valid);
+        }
+
+        static Result parseCSV(String line) {
+            String[] s = line.split(",");
+            Result r = new Result();
+            r.backend = s[0];
+            r.type = s[1];
+            r.threads = Integer.parseInt(s[2]);
+            r.category = s[3];
+            r.shape = s[4];
+            r.batch = Integer.parseInt(s[5]);
+            r.m = Integer.parseInt(s[6]);
+            r.n = Integer.parseInt(s[7]);
+            r.k = Integer.parseInt(s[8]);
+            r.iterations = Long.parseLong(s[9]);
+            r.seconds = Double.parseDouble(s[10]);
+            r.gflops = Double.parseDouble(s[11]);
+            r.valid = Boolean.parseBoolean(s[12]);
+            return r;
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Options options = Options.parse(args);
+        if (options.worker != null) {
+            runWorker(options);
+            System.exit(0);
+        }
+
+        List<Result> results = new ArrayList<>();
+        for (String backend : options.backends) {
+            results.addAll(fork(backend, args));
+        }
+        printTable(options, results);
+        if (options.csv != null) {
+            try (PrintWriter out = new PrintWriter(options.csv, "UTF-8")) {
+                out.println(Result.header);
+                for (Result r : results) {
+                    out.println(r.toCSV());
+                }
+            }
+        }
+        if (options.json != null) {
+            try (PrintWriter out = new PrintWriter(options.json, "UTF-8")) {
+                out.println("[");
+                for (int i = 0; i < results.size(); i++) {
+                    out.println("  " + results.get(i).toJSON() + (i + 1 < results.size() ? "," : ""));
+                }
+                out.println("]");
+            }
+        }
+        System.exit(0);
+    }
+
+    /** Runs the benchmark of one backend in a new JVM, and returns its results. */
+    static List<Result> fork(String backend, String[] args) throws IOException, InterruptedException {
+        String classpath = System.getProperty("java.class.path");
+        ClassLoader loader = MatMulBenchmark.class.getClassLoader();
+        if (loader instanceof URLClassLoader) {
+            // with exec:java, the classes come from a class loader of Maven
+            StringBuilder s = new StringBuilder();
+            for (URL url : ((URLClassLoader)loader).getURLs()) {
+                try {
+                    s.append(s.length() > 0 ? File.pathSeparator : "").append(new File(url.toURI()).getPath());
+                } catch (Exception e) {
+                    s.append(s.length() > 0 ? File.pathSeparator : "").append(url.getPath());
+                }
+            }
+            classpath = s.toString();
+        }
+        List<String> command = new ArrayList<>(Arrays.asList(
+                System.getProperty("java.home") + File.separator + "bin" + File.separator + "java",
+                "-cp", classpath, MatMulBenchmark.class.getName()));
+        command.addAll(Arrays.asList(args));
+        command.addAll(Arrays.asList("--worker", backend));
+
+        List<Result> results = new ArrayList<>();
+        Process process = new ProcessBuilder(command).redirectError(ProcessBuilder.Redirect.INHERIT).start();
+        try (BufferedReader in = new BufferedReader(new InputStreamReader(process.getInputStream(), "UTF-8"))) {
+            String line;
+            while ((line = in.readLine()) != null) {
+                if (line.startsWith(RESULT)) {
+                    Result r = Result.parseCSV(line.substring(RESULT.length()));
+                    System.out.printf(Locale.ROOT, "%-8s %-4s %3d threads %-13s %-16s %10.2f GFLOP/s%s\n",
+                            r.backend, r.type, r.threads, r.category, r.shape, r.gflops, r.valid ? "" : " (wrong result)");
+                    results.add(r);
+                } else {
+                    System.out.println(line);
+                }
+            }
+        }
+        int status = process.waitFor();
+        if (status != 0) {
+            System.err.println("Benchmark of " + backend + " failed with exit status " + status);
+        }
+        return results;
+    }
+
+    /** Prints one row per case with the GFLOP/s of each backend as columns. */
+    static void printTable(Options options, List<Result> results) {
+        Map<String, Map<String, Result>> rows = new LinkedHashMap<>();
+        Set<String> backends = new LinkedHashSet<>(options.backends);
+        for (Shape s : options.shapes) {
+            for (String type : options.types) {
+                for (int threads : options.threads) {
+                    rows.put(String.format("%-13s %-16s %-4s %3d", s.category, s, type, threads), new LinkedHashMap<String, Result>());
+                }
+            }
+        }
+        for (Result r : results) {
+            String key = String.format("%-13s %-16s %-4s %3d", r.category, r.shape, r.type, r.threads);
+            if (rows.containsKey(key)) {
+                rows.get(key).put(r.backend, r);
+            }
+        }
+
+        System.out.println();
+        System.out.printf("%-13s %-16s %-4s %3s", "category", "shape", "type", "thr");
+        for (String b : backends) {
+            System.out.printf(" %10s", b);
+        }
+        System.out.println("   (GFLOP/s)");
+        for (Map.Entry<String, Map<String, Result>> e : rows.entrySet()) {
+            System.out.print(e.getKey());
+            String best = null;
+            for (Result r : e.getValue().values()) {
+                if (r.valid && (best == null || r.gflops > e.getValue().get(best).gflops)) {
+                    best = r.backend;
+                }
+            }
+            for (String b : backends) {
+                Result r = e.getValue().get(b);
+                System.out.print(r == null ? String.format(" %10s", "-")
+                        : String.format(Locale.ROOT, " %9.2f%s", r.gflops, !r.valid ? "!" : b.equals(best) ? "*" : " "));
+            }
+            System.out.println();
+        }
+        System.out.println("* fastest, ! wrong result, - unavailable");
+    }
+
+    /** Measures all cases with one backend, printing the results to the standard output. */
+    static void runWorker(Options options) {
+        Backend backend;
+        switch (options.worker) {
+            case "openblas": backend = new CblasBackend("openblas", org.bytedeco.openblas.global.openblas_nolapack.class); break;
+            case "mkl":      backend = new CblasBackend("mkl", org.bytedeco.mkl.global.mkl_rt.class); break;
+            case "mkl-jit":  backend = new MklJitBackend(); break;
+            case "dnnl":     backend = new DnnlBackend(); break;
+            case "polly":    backend = new PollyBackend(); break;
+            case "java":     backend = new JavaBackend(); break;
+            default: throw new IllegalArgumentException("Unknown backend: " + options.worker);
+        }
+        initialize(backend instanceof PollyBackend);
+        backend.load();
+
+        Random random = new Random(42);
+        for (Shape s : options.shapes) {
+            for (String type : options.types) {
+                boolean fp64 = type.equals("f64");
+                int size = fp64 ? 8 : 4;
+                Pointer a = allocate(random, (long)s.batch * s.m * s.k, fp64);
+                Pointer b = allocate(random, (long)s.batch * s.k * s.n, fp64);
+                Pointer c = allocate(null, (long)s.batch * s.m * s.n, fp64);
+                for (int threads : options.threads) {
+                    if (threads > 1 && backend.sequential()) {
+                        continue;
+                    }
+                    setNumThreads(threads);
+                    try (Kernel kernel = backend.prepare(s, fp64, a, b, c, size)) {
+                        if (kernel == null) {
+                            continue;
+                        }
+                        // warm up and calibrate to run for at least minTime
+                        long start = System.nanoTime();
+                        kernel.run(1);
+                        double once = Math.max((System.nanoTime() - start) / 1e9, 1e-9);
+                        long iterations = Math.max(1, (long)Math.ceil(options.minTime / once / 3));
+                        double best = Double.MAX_VALUE;
+                        for (int i = 0; i < 3; i++) {
+                            start = System.nanoTime();
+                            kernel.run(iterations);
+                            best = Math.min(best, (System.nanoTime() - start) / (1e9 * iterations));
+                        }
+
+                        Result r = new Result();
+                        r.backend = backend.name;
+                        r.type = type;
+                        r.threads = threads;
+                        r.category = s.category;
+                        r.shape = s.toString();
+                        r.batch = s.batch;
+                        r.m = s.m;
+                        r.n = s.n;
+                        r.k = s.k;
+                        r.iterations = iterations;
+                        r.seconds = best;
+                        r.gflops = s.flops() / best / 1e9;
+                        r.valid = check(s, fp64, a, b, c);
+                        System.out.println(RESULT + r.toCSV());
+                        System.out.flush();
+                    }
+                }
+                a.deallocate();
+                b.deallocate();
+                c.deallocate();
+            }
+        }
+    }
+
+    static Pointer allocate(Random random, long length, boolean fp64) {
+        Pointer p = fp64 ? new DoublePointer(length) : new FloatPointer(length);
+        p.zero();
+        if (random != null) {
+            for (long i = 0; i < length; i++) {
+                if (fp64) {
+                    ((DoublePointer)p).put(i, random.nextDouble());
+                } else {
+                    ((FloatPointer)p).put(i, random.nextFloat());
+                }
+            }
+        }
+        return p;
+    }
+
+    static double get(Pointer p, long i) {
+        return p instanceof DoublePointer ? ((DoublePointer)p).get(i) : ((FloatPointer)p).get(i);
+    }
+
+    /** Checks a few elements of the first and the last products of the batch. */
+    static boolean check(Shape s, boolean fp64, Pointer a, Pointer b, Pointer c) {
+        for (int batch : new int[] {0, s.batch - 1}) {
+            for (int[] mn : new int[][] {{0, 0}, {s.m - 1, s.n - 1}, {s.m / 2, s.n / 3}}) {
+                double expected = 0;
+                for (int k = 0; k < s.k; k++) {
+                    expected += get(a, ((long)batch * s.m + mn[0]) * s.k + k) * get(b, ((long)batch * s.k + k) * s.n + mn[1]);
+                }
+                double actual = get(c, ((long)batch * s.m + mn[0]) * s.n + mn[1]);
+                if (!(Math.abs(actual - expected) <= (fp64 ? 1e-9 : 1e-3) * Math.max(1, Math.abs(expected)))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /** Sets the number of threads of the libraries loaded, the same way as blas_set_num_threads(). */
+    static void setNumThreads(int threads) {
+        for (String name : new String[] {"openblas_set_num_threads", "MKL_Set_Num_Threads", "omp_set_num_threads"}) {
+            Pointer f = Loader.addressof(name);
+            if (f != null) {
+                ffi_cif cif = new ffi_cif();
+                ffi_prep_cif(cif, FFI_DEFAULT_ABI(), 1, ffi_type_void(), new PointerPointer<>(ffi_type_sint32()));
+                IntPointer value = new IntPointer(1).put(threads);
+                ffi_call(cif, f, null, new PointerPointer<>(value));
+            }
+        }
+    }
+
+    /** Batch multiplications ready to run repeatedly, all at once. */
+    static abstract class Kernel implements AutoCloseable {
+        final List<Runnable> cleanup = new ArrayList<>();
+
+        abstract void run(long iterations);
+
+        @Override public void close() {
+            for (int i = cleanup.size() - 1; i >= 0; i--) {
+                cleanup.get(i).run();
+            }
+        }
+    }
+
+    static abstract class Backend {
+        final String name;
+
+        Backend(String name) {
+            this.name = name;
+        }
+
+        void load() { }
+
+        /** Returns true if the backend does not use more than one thread. */
+        boolean sequential() {
+            return false;
+        }
+
+        /** Returns a kernel computing c = a * b for the shape, or null if not supported. */
+        abstract Kernel prepare(Shape s, boolean fp64, Pointer a, Pointer b, Pointer c, int size);
+    }
 
-    public static void main(String[] args) {
-        float[] a = createRandomArray(M, K);
-        float[] b = createRandomArray(K, N);
-        float[] c = new float[M * N];
+    /** OpenBLAS or MKL, through cblas_sgemm() and cblas_dgemm(). */
+    static class CblasBackend extends Backend {
+        final Class library;
 
-        initialize();
+        CblasBackend(String name, Class library) {
+            super(name);
+            this.library = library;
+        }
+
+        @Override void load() {
+            Loader.load(library);
+        }
+
+        @Override Kernel prepare(Shape s, boolean fp64, Pointer a, Pointer b, Pointer c, int size) {
+            Pointer gemm = Loader.addressof(fp64 ? "cblas_dgemm" : "cblas_sgemm");
+            Object alpha = fp64 ? (Object)1.0 : (Object)1.0f, beta = fp64 ? (Object)0.0 : (Object)0.0f;
+            return new NativeKernel(new Call(gemm.address(), s.batch, CblasRowMajor, CblasNoTrans, CblasNoTrans, s.m, s.n, s.k,
+                    alpha, new Strided(a, (long)s.m * s.k * size), s.k, new Strided(b, (long)s.k * s.n * size), s.n,
+                    beta, new Strided(c, (long)s.m * s.n * size), s.n));
+        }
+    }
+
+    /** Kernels generated by MKL for each shape, which run on the calling thread only. */
+    static class MklJitBackend extends Backend {
+        MklJitBackend() {
+            super("mkl-jit");
+        }
+
+        @Override void load() {
+            Loader.load(org.bytedeco.mkl.global.mkl_rt.class);
+        }
+
+        @Override boolean sequential() {
+            return true;
+        }
 
-        benchmarkMKL(a, b, c);
-        benchmarkLLVM(a, b, c);
-        benchmarkPureJava(a, b, c);
+        @Override Kernel prepare(Shape s, boolean fp64, Pointer a, Pointer b, Pointer c, int size) {
+            final Pointer jitter = new Pointer();
+            int status = fp64 ? mkl_cblas_jit_create_dgemm(jitter, CblasRowMajor, CblasNoTrans, CblasNoTrans, s.m, s.n, s.k, 1.0, s.k, s.n, 0.0, s.n)
+                              : mkl_cblas_jit_create_sgemm(jitter, CblasRowMajor, CblasNoTrans, CblasNoTrans, s.m, s.n, s.k, 1.0f, s.k, s.n, 0.0f, s.n);
+            if (status == MKL_JIT_ERROR) {
+                return null;
+            }
+            long gemm = fp64 ? mkl_jit_get_dgemm_ptr(jitter).address() : mkl_jit_get_sgemm_ptr(jitter).address();
+            Kernel kernel = new NativeKernel(new Call(gemm, s.batch, jitter, new Strided(a, (long)s.m * s.k * size),
+                    new Strided(b, (long)s.k * s.n * size), new Strided(c, (long)s.m * s.n * size)));
+            kernel.cleanup.add(() -> mkl_jit_destroy(jitter));
+            return kernel;
+        }
     }
 
-    static void benchmarkMKL(float[] a, float[] b, float[] c) {
-        Pointer jitter = new Pointer();
-        mkl_cblas_jit_create_sgemm(jitter, CblasRowMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, K, N, 0.0f, N);
-        sgemm_jit_kernel_t sgemm = mkl_jit_get_sgemm_ptr(jitter);
+    /** DNNL matmul primitives, with the batch as their first dimension. */
+    static class DnnlBackend extends Backend {
+        dnnl_engine engine = new dnnl_engine();
+        dnnl_stream stream = new dnnl_stream();
+
+        DnnlBackend() {
+            super("dnnl");
+        }
+
+        static void check(int status) {
+            if (status != dnnl_success) {
+                throw new RuntimeException("DNNL error: " + status);
+            }
+        }
+
+        @Override void load() {
+            check(dnnl_engine_create(engine, dnnl_cpu, 0));
+            check(dnnl_stream_create(stream, engine, dnnl_stream_default_flags));
+        }
+
+        dnnl_memory memory(long d0, long d1, long d2, int type, Pointer data, dnnl_memory_desc_t desc) {
+            check(dnnl_memory_desc_init_by_tag(desc, 3, new LongPointer(d0, d1, d2), type, dnnl_abc));
+            dnnl_memory memory = new dnnl_memory();
+            check(dnnl_memory_create(memory, desc, engine, data));
+            return memory;
+        }
+
+        @Override Kernel prepare(Shape s, boolean fp64, Pointer a, Pointer b, Pointer c, int size) {
+            int type = fp64 ? dnnl_f64 : dnnl_f32;
+            dnnl_memory_desc_t aDesc = new dnnl_memory_desc_t(), bDesc = new dnnl_memory_desc_t(), cDesc = new dnnl_memory_desc_t();
+            final dnnl_memory aMemory = memory(s.batch, s.m, s.k, type, a, aDesc);
+            final dnnl_memory bMemory = memory(s.batch, s.k, s.n, type, b, bDesc);
+            final dnnl_memory cMemory = memory(s.batch, s.m, s.n, type, c, cDesc);
+
+            dnnl_matmul_desc_t desc = new dnnl_matmul_desc_t();
+            check(dnnl_matmul_desc_init(desc, aDesc, bDesc, null, cDesc));
+            dnnl_primitive_desc pd = new dnnl_primitive_desc();
+            final dnnl_primitive matmul = new dnnl_primitive();
+            if (dnnl_primitive_desc_create(pd, new const_dnnl_op_desc_t(desc), null, engine, null) != dnnl_success) {
+                // the type is not supported on this CPU
+                dnnl_memory_destroy(aMemory);
+                dnnl_memory_destroy(bMemory);
+                dnnl_memory_destroy(cMemory);
+                return null;
+            }
+            check(dnnl_primitive_create(matmul, pd));
+            check(dnnl_primitive_desc_destroy(pd));
+
+            final dnnl_exec_arg_t args = new dnnl_exec_arg_t(3);
+            args.getPointer(0).arg(DNNL_ARG_SRC).memory(aMemory);
+            args.getPointer(1).arg(DNNL_ARG_WEIGHTS).memory(bMemory);
+            args.getPointer(2).arg(DNNL_ARG_DST).memory(cMemory);
+            Kernel kernel = new NativeKernel(
+                    new Call(Loader.addressof("dnnl_primitive_execute").address(), 1, matmul, stream, 3, args),
+                    new Call(Loader.addressof("dnnl_stream_wait").address(), 1, stream));
+            kernel.cleanup.add(() -> {
+                dnnl_primitive_destroy(matmul);
+                dnnl_memory_destroy(aMemory);
+                dnnl_memory_destroy(bMemory);
+                dnnl_memory_destroy(cMemory);
+                args.deallocate();
+            });
+            return kernel;
+        }
+    }
 
-        FloatPointer A = new FloatPointer(a);
-        FloatPointer B = new FloatPointer(b);
-        FloatPointer C = new FloatPointer(c);
+    /** Kernels generated by LLVM with Polly for each shape. */
+    static class PollyBackend extends Backend {
+        PollyBackend() {
+            super("polly");
+        }
 
-        int iterations = 10;
-        long start = System.nanoTime();
-        for (int i = 0; i < iterations; i++) {
-            sgemm.call(jitter, A, B, C);
+        @Override boolean sequential() {
+            return !usePolly || !usePollyParallel;
         }
-        long end = System.nanoTime();
-        C.get(c);
-        System.out.printf("MKL: %fms. c[0] = %f\n", (end - start) / (iterations * 1000d * 1000d), c[0]);
-        printArray(c);
 
-        mkl_jit_destroy(jitter);
+        @Override Kernel prepare(Shape s, boolean fp64, Pointer a, Pointer b, Pointer c, int size) {
+            final LLVMExecutionEngineRef engine = new LLVMExecutionEngineRef();
+            LLVMModuleRef module = build(s, fp64);
+            verify(module, false);
+            optimize(module);
+            jitCompile(engine, module);
+            Kernel kernel = new NativeKernel(new Call(LLVMGetFunctionAddress(engine, "matmul"), s.batch, new Strided(a, (long)s.m * s.k * size),
+                    new Strided(b, (long)s.k * s.n * size), new Strided(c, (long)s.m * s.n * size)));
+            kernel.cleanup.add(() -> LLVMDisposeExecutionEngine(engine));
+            return kernel;
+        }
     }
 
-    static void benchmarkPureJava(float[] a, float[] b, float[] c) {
-        assert a.length == M * K;
-        assert b.length == K * N;
-        assert c.length == M * N;
+    /** The loops in pure Java, on arrays copied from and to native memory. */
+    static class JavaBackend extends Backend {
+        JavaBackend() {
+            super("java");
+        }
+
+        @Override boolean sequential() {
+            return true;
+        }
+
+        @Override Kernel prepare(final Shape s, final boolean fp64, Pointer a, Pointer b, final Pointer c, int size) {
+            if (fp64) {
+                final double[] x = new double[(int)a.capacity()], y = new double[(int)b.capacity()], z = new double[(int)c.capacity()];
+                ((DoublePointer)a).get(x);
+                ((DoublePointer)b).get(y);
+                return new Kernel() {
+                    @Override void run(long iterations) {
+                        for (long i = 0; i < iterations; i++) {
+                            for (int batch = 0; batch < s.batch; batch++) {
+                                matmul(s, x, batch * s.m * s.k, y, batch * s.k * s.n, z, batch * s.m * s.n);
+                            }
+                        }
+                        ((DoublePointer)c).put(z);
+                    }
+                };
+            } else {
+                final float[] x = new float[(int)a.capacity()], y = new float[(int)b.capacity()], z = new float[(int)c.capacity()];
+                ((FloatPointer)a).get(x);
+                ((FloatPointer)b).get(y);
+                return new Kernel() {
+                    @Override void run(long iterations) {
+                        for (long i = 0; i < iterations; i++) {
+                            for (int batch = 0; batch < s.batch; batch++) {
+                                matmul(s, x, batch * s.m * s.k, y, batch * s.k * s.n, z, batch * s.m * s.n);
+                            }
+                        }
+                        ((FloatPointer)c).put(z);
+                    }
+                };
+            }
+        }
+
+        static void matmul(Shape s, double[] a, int ai, double[] b, int bi, double[] c, int ci) {
+            for (int m = 0; m < s.m; m++) {
+                for (int n = 0; n < s.n; n++) {
+                    double sum = 0;
+                    for (int k = 0; k < s.k; k++) {
+                        sum += a[ai + m * s.k + k] * b[bi + k * s.n + n];
+                    }
+                    c[ci + m * s.n + n] = sum;
+                }
+            }
+        }
 
-        System.out.println("Now starting pure Java benchmark: This may take a minute.");
-        long start = System.nanoTime();
-        for (int m = 0; m < M; m++) {
-            for (int n = 0; n < N; n++) {
-                float s = 0;
-                for (int k = 0; k < K; k++) {
-                    s += a[m * K + k] * b[k * N + n];
+        static void matmul(Shape s, float[] a, int ai, float[] b, int bi, float[] c, int ci) {
+            for (int m = 0; m < s.m; m++) {
+                for (int n = 0; n < s.n; n++) {
+                    float sum = 0;
+                    for (int k = 0; k < s.k; k++) {
+                        sum += a[ai + m * s.k + k] * b[bi + k * s.n + n];
+                    }
+                    c[ci + m * s.n + n] = sum;
                 }
-                c[m * N + n] = s;
             }
         }
-        long end = System.nanoTime();
-        System.out.printf("Pure Java: %fms. c[0] = %f\n", (end - start) / (1000d * 1000d), c[0]);
-        printArray(c);
     }
 
-    static void initialize() {
-        if (usePolly) {
+    /** A pointer argument advanced by stride bytes for each call of a batch. */
+    static class Strided {
+        final long address, stride;
+
+        Strided(Pointer p, long stride) {
+            this.address = p.address();
+            this.stride = stride;
+        }
+    }
+
+    /**
+     * A call to a native function repeated count times, with constant arguments of type Integer, Long,
+     * Float, Double, Pointer, or Strided. The function may return a value, but it gets ignored.
+     */
+    static class Call {
+        final long function;
+        final int count;
+        final Object[] args;
+
+        Call(long function, int count, Object... args) {
+            this.function = function;
+            this.count = count;
+            this.args = args;
+        }
+    }
+
+    /** Runs calls from a loop compiled by LLVM, so the time measured is the one of the calls only. */
+    static class NativeKernel extends Kernel {
+        final LLVMExecutionEngineRef engine = new LLVMExecutionEngineRef();
+        final long function;
+
+        NativeKernel(Call... calls) {
+            LLVMModuleRef module = buildLoop(calls);
+            verify(module, false);
+            jitCompile(engine, module);
+            function = LLVMGetFunctionAddress(engine, "loop");
+            cleanup.add(() -> LLVMDisposeExecutionEngine(engine));
+        }
+
+        @Override void run(long iterations) {
+            ffi_cif cif = new ffi_cif();
+            ffi_prep_cif(cif, FFI_DEFAULT_ABI(), 1, ffi_type_void(), new PointerPointer<>(ffi_type_sint64()));
+            LongPointer value = new LongPointer(1).put(iterations);
+            ffi_call(cif, new Pointer() {{ address = function; }}, null, new PointerPointer<>(value));
+        }
+    }
+
+    static void initialize(boolean polly) {
+        if (polly && usePolly) {
             if (usePollyParallel) {
                 String platform = Loader.getPlatform();
                 String omplib = platform.startsWith("linux") ? "libiomp5.so"
@@ -120,47 +745,104 @@ public class MatMulBenchmark {
 
         llvmVoidType = LLVMVoidType();
         llvmInt32Type = LLVMInt32Type();
-        llvmFloatType = LLVMFloatType();
-        llvmFloatPointerType = LLVMPointerType(llvmFloatType, 0);
+        llvmInt64Type = LLVMInt64Type();
+        llvmVoidPointerType = LLVMPointerType(LLVMInt8Type(), 0);
+    }
+
+    static LLVMTypeRef typeOf(Object arg) {
+        return arg instanceof Integer ? llvmInt32Type
+             : arg instanceof Long ? llvmInt64Type
+             : arg instanceof Float ? LLVMFloatType()
+             : arg instanceof Double ? LLVMDoubleType()
+             : llvmVoidPointerType;
     }
 
-    static void benchmarkLLVM(float[] a, float[] b, float[] c) {
-        assert a.length == M * K;
-        assert b.length == K * N;
-        assert c.length == M * N;
+    static LLVMValueRef valueOf(LLVMBuilderRef builder, Object arg, LLVMValueRef index) {
+        if (arg instanceof Integer) {
+            return LLVMConstInt(llvmInt32Type, (Integer)arg, 1);
+        } else if (arg instanceof Long) {
+            return LLVMConstInt(llvmInt64Type, (Long)arg, 1);
+        } else if (arg instanceof Float) {
+            return LLVMConstReal(LLVMFloatType(), (Float)arg);
+        } else if (arg instanceof Double) {
+            return LLVMConstReal(LLVMDoubleType(), (Double)arg);
+        } else if (arg instanceof Strided) {
+            Strided s = (Strided)arg;
+            LLVMValueRef offset = LLVMBuildMul(builder, index, LLVMConstInt(llvmInt64Type, s.stride, 0), "offset");
+            LLVMValueRef address = LLVMBuildAdd(builder, LLVMConstInt(llvmInt64Type, s.address, 0), offset, "address");
+            return LLVMBuildIntToPtr(builder, address, llvmVoidPointerType, "pointer");
+        } else {
+            return LLVMConstIntToPtr(LLVMConstInt(llvmInt64Type, ((Pointer)arg).address(), 0), llvmVoidPointerType);
+        }
+    }
 
-        LLVMExecutionEngineRef engine = new LLVMExecutionEngineRef();
-        try {
-            LLVMModuleRef module = build();
-            verify(module, false);
-            optimize(module);
-            jitCompile(engine, module);
+    /** Begins a loop over a 64-bit index from 0, returning the index. */
+    static LLVMValueRef buildLoopStart(LLVMBuilderRef builder, LLVMValueRef func, String name) {
+        LLVMBasicBlockRef previousBB = LLVMGetInsertBlock(builder);
+        LLVMBasicBlockRef loopBB = LLVMAppendBasicBlock(func, name);
+        LLVMBuildBr(builder, loopBB);
+        LLVMPositionBuilderAtEnd(builder, loopBB);
+        LLVMValueRef index = LLVMBuildPhi(builder, llvmInt64Type, name);
+        LLVMAddIncoming(index, LLVMConstInt(llvmInt64Type, 0, 0), previousBB, 1);
+        return index;
+    }
 
-            long fnAddr = LLVMGetFunctionAddress(engine, "matmul");
-            // Using libffi directly reduces overhead, but we can also do the equivalent with JNA as follows:
-            //  com.sun.jna.Function func = com.sun.jna.Function.getFunction(new com.sun.jna.Pointer(fnAddr));
-            //  func.invoke(Void.class, new Object[]{a, b, c});
-            ffi_cif cif = new ffi_cif();
-            Pointer fn = new Pointer() {{ address = fnAddr; }};
-            PointerPointer<ffi_type> args = new PointerPointer<>(ffi_type_pointer(), ffi_type_pointer(), ffi_type_pointer());
-            PointerPointer<FloatPointer> pointers = new PointerPointer<>(a, b, c);
-            PointerPointer<PointerPointer> values = new PointerPointer<>(pointers.getPointer(0), pointers.getPointer(1), pointers.getPointer(2));
-            ffi_prep_cif(cif, FFI_DEFAULT_ABI(), 3, ffi_type_void(), args);
-            long start = System.nanoTime();
-            ffi_call(cif, fn, null, values);
-            long end = System.nanoTime();
-            pointers.get(FloatPointer.class, 2).get(c);
-            System.out.printf("LLVM%s: %fms. c[0] = %f\n",
-                    usePolly ? " with Polly" : " without Polly",
-                    (end - start) / (1000d * 1000d),
-                    c[0]);
-            printArray(c);
-        } finally {
-            LLVMDisposeExecutionEngine(engine);
+    /** Ends the loop of the index, once incremented up to count. */
+    static void buildLoopEnd(LLVMBuilderRef builder, LLVMValueRef func, LLVMValueRef index, LLVMValueRef count, String name) {
+        LLVMValueRef nextIndex = LLVMBuildAdd(builder, index, LLVMConstInt(llvmInt64Type, 1, 0), name + " + 1");
+        LLVMValueRef endCond = LLVMBuildICmp(builder, LLVMIntEQ, nextIndex, count, name + " == count");
+        LLVMBasicBlockRef loopEndBB = LLVMGetInsertBlock(builder);
+        LLVMBasicBlockRef afterBB = LLVMAppendBasicBlock(func, "after " + name);
+        LLVMBuildCondBr(builder, endCond, afterBB, LLVMGetInstructionParent(index));
+        LLVMPositionBuilderAtEnd(builder, afterBB);
+        LLVMAddIncoming(index, nextIndex, loopEndBB, 1);
+    }
+
+    /** Builds void loop(int64_t n), which makes the calls n times. */
+    static LLVMModuleRef buildLoop(Call[] calls) {
+        LLVMBuilderRef builder = LLVMCreateBuilder();
+        LLVMModuleRef module = LLVMModuleCreateWithName("loopModule");
+
+        LLVMTypeRef funcType = LLVMFunctionType(llvmVoidType, new PointerPointer<>(llvmInt64Type), 1, 0);
+        LLVMValueRef func = LLVMAddFunction(module, "loop", funcType);
+        LLVMSetFunctionCallConv(func, LLVMCCallConv);
+        LLVMValueRef paramN = LLVMGetParam(func, 0);
+
+        LLVMBasicBlockRef entryBB = LLVMAppendBasicBlock(func, "entry");
+        LLVMPositionBuilderAtEnd(builder, entryBB);
+        LLVMValueRef iteration = buildLoopStart(builder, func, "i");
+
+        for (Call call : calls) {
+            LLVMTypeRef[] types = new LLVMTypeRef[call.args.length];
+            for (int i = 0; i < types.length; i++) {
+                types[i] = typeOf(call.args[i]);
+            }
+            LLVMTypeRef calleeType = LLVMFunctionType(llvmVoidType, new PointerPointer<>(types), types.length, 0);
+            LLVMValueRef callee = LLVMConstIntToPtr(LLVMConstInt(llvmInt64Type, call.function, 0), LLVMPointerType(calleeType, 0));
+
+            LLVMValueRef count = LLVMConstInt(llvmInt64Type, call.count, 0);
+            LLVMValueRef index = call.count > 1 ? buildLoopStart(builder, func, "j") : LLVMConstInt(llvmInt64Type, 0, 0);
+            LLVMValueRef[] values = new LLVMValueRef[call.args.length];
+            for (int i = 0; i < values.length; i++) {
+                values[i] = valueOf(builder, call.args[i], index);
+            }
+            LLVMBuildCall2(builder, calleeType, callee, new PointerPointer<>(values), values.length, "");
+            if (call.count > 1) {
+                buildLoopEnd(builder, func, index, count, "j");
+            }
         }
+
+        buildLoopEnd(builder, func, iteration, paramN, "i");
+        LLVMBuildRetVoid(builder);
+        LLVMDisposeBuilder(builder);
+        return module;
     }
 
-    static LLVMModuleRef build() {
+    static LLVMModuleRef build(Shape shape, boolean fp64) {
+        final int M = shape.m, N = shape.n, K = shape.k;
+        LLVMTypeRef llvmFloatType = fp64 ? LLVMDoubleType() : LLVMFloatType();
+        LLVMTypeRef llvmFloatPointerType = LLVMPointerType(llvmFloatType, 0);
+
         LLVMBuilderRef builder = LLVMCreateBuilder();
 
         LLVMModuleRef module = LLVMModuleCreateWithName("matmulModule");
@@ -211,7 +893,7 @@ public class MatMulBenchmark {
 
         // s = 0
         LLVMValueRef s = LLVMBuildPhi(builder, llvmFloatType, "s");
-        LLVMAddIncoming(s, toConstFloat(0), loopNBB, 1);
+        LLVMAddIncoming(s, LLVMConstReal(llvmFloatType, 0), loopNBB, 1);
 
         // s += a[m * K + k] * b[k * N + n]
         LLVMValueRef mMulK = LLVMBuildMul(builder, loopMIdx, toConstInt(K), "m * K");
@@ -311,28 +993,7 @@ public class MatMulBenchmark {
         return LLVMConstInt(llvmInt32Type, v, 0);
     }
 
-    static LLVMValueRef toConstFloat(float v) {
-        return LLVMConstReal(llvmFloatType, v);
-    }
-
     static void setLLVMCommandLineOptions(String... args) {
         LLVMParseCommandLineOptions(args.length, new PointerPointer<>(args), null);
     }
-
-    static float[] createRandomArray(int m, int n) {
-        Random rand = new Random();
-        float[] ary = new float[m * n];
-        for (int i = 0; i < ary.length; i++) {
-            ary[i] = rand.nextFloat();
-        }
-        return ary;
-    }
-
-    static void printArray(float[] ary) {
-        if (printResult) {
-            for (float v : ary) {
-                System.out.println(v);
-            }
-        }
-    }
 }
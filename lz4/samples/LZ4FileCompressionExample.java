@@ -0,0 +1,61 @@
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.util.Arrays;
+import org.bytedeco.lz4.*;
+import org.bytedeco.lz4.global.lz4;
+
+/**
+ * Compresses and decompresses a file with one native call each, without loading it in memory.
+ * Run with: mvn compile exec:java -Dexec.mainClass=LZ4FileCompressionExample -Dexec.args="somefile"
+ */
+public final class LZ4FileCompressionExample {
+
+    public static void main(String[] args) throws IOException, LZ4Exception {
+        final File input = new File(args[0]);
+        final File compressed = new File(args[0] + ".lz4");
+        final File decompressed = new File(args[0] + ".out");
+
+        final LZ4FCompressionContext cctx = new LZ4FCompressionContext();
+        final LZ4FDecompressionContext dctx = new LZ4FDecompressionContext();
+        checkForError(lz4.LZ4F_createCompressionContext(cctx, lz4.LZ4F_VERSION));
+        checkForError(lz4.LZ4F_createDecompressionContext(dctx, lz4.LZ4F_VERSION));
+        try {
+            // Record the content size in the frame, and use the default window size
+            final LZ4FPreferences prefs = org.bytedeco.lz4.presets.lz4.LZ4F_INIT_PREFERENCES(new LZ4FPreferences());
+            prefs.frameInfo().contentSize(1);
+
+            long start = System.nanoTime();
+            final long compressedSize = lz4.LZ4F_compressFile(cctx, input.getPath(), compressed.getPath(), prefs, 0);
+            checkForError(compressedSize);
+            long middle = System.nanoTime();
+            final long decompressedSize = lz4.LZ4F_decompressFile(dctx, compressed.getPath(), decompressed.getPath(), 0);
+            checkForError(decompressedSize);
+            long end = System.nanoTime();
+
+            System.out.printf("Compressed %d bytes into %d bytes in %.3f s%n", input.length(), compressedSize, (middle - start) / 1e9);
+            System.out.printf("Decompressed %d bytes in %.3f s%n", decompressedSize, (end - middle) / 1e9);
+        } finally {
+            lz4.LZ4F_freeCompressionContext(cctx);
+            lz4.LZ4F_freeDecompressionContext(dctx);
+        }
+
+        if (input.length() < Integer.MAX_VALUE
+                && !Arrays.equals(Files.readAllBytes(input.toPath()), Files.readAllBytes(decompressed.toPath()))) {
+            throw new IllegalStateException("Input and output differ.");
+        }
+        System.out.println("Verified that input file == output file");
+    }
+
+    private static void checkForError(long errorCode) throws LZ4Exception {
+        if (lz4.LZ4F_isError(errorCode) != 0) {
+            throw new LZ4Exception(lz4.LZ4F_getErrorName(errorCode).getString());
+        }
+    }
+
+    private static final class LZ4Exception extends Exception {
+        public LZ4Exception(final String message) {
+            super(message);
+        }
+    }
+}
@@ -0,0 +1,80 @@
+import java.nio.ByteBuffer;
+import java.util.Random;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.lz4.*;
+import org.bytedeco.lz4.global.lz4;
+
+/**
+ * Measures the throughput of LZ4F_compressFrameParallel() and LZ4F_decompressFrameParallel()
+ * versus the number of threads. Run with:
+ * mvn compile exec:java -Dexec.mainClass=LZ4ParallelCompressionBenchmark
+ */
+public final class LZ4ParallelCompressionBenchmark {
+
+    private static final int NUM_VALUES = 512 * 1024 * 1024; // 512MB
+
+    private static final int REPEATS = 3;
+
+    public static void main(String[] args) throws LZ4Exception {
+        // Generate some log-like data that compresses about as well as text
+        final ByteBuffer data = ByteBuffer.allocateDirect(NUM_VALUES);
+        final Random random = new Random(42);
+        final byte[] line = new byte[128];
+        while (data.remaining() >= line.length) {
+            for (int i = 0; i < line.length; i++) {
+                line[i] = (byte) (i % 32 == 31 ? '\n' : 'a' + random.nextInt(random.nextInt(26) + 1));
+            }
+            data.put(line);
+        }
+        data.position(0);
+
+        final Pointer dataPointer = new Pointer(data);
+        final long bound = lz4.LZ4F_compressFrameParallelBound(data.limit(), null);
+        final ByteBuffer compressed = ByteBuffer.allocateDirect((int) bound);
+        final ByteBuffer decompressed = ByteBuffer.allocateDirect(data.limit());
+        final Pointer compressedPointer = new Pointer(compressed);
+        final Pointer decompressedPointer = new Pointer(decompressed);
+
+        System.out.println("threads,compressed size,compression MB/s,decompression MB/s");
+        final int maxThreads = Runtime.getRuntime().availableProcessors();
+        for (int threads = 1; threads <= maxThreads; threads *= 2) {
+            final LZ4FParallelContext ctx = lz4.LZ4F_createParallelContext(threads);
+            long compressedSize = 0;
+            double compressionTime = Double.MAX_VALUE, decompressionTime = Double.MAX_VALUE;
+            try {
+                for (int i = 0; i < REPEATS; i++) {
+                    long start = System.nanoTime();
+                    compressedSize = lz4.LZ4F_compressFrameParallel(ctx, compressedPointer, bound,
+                            dataPointer, data.limit(), null);
+                    checkForError(compressedSize);
+                    long middle = System.nanoTime();
+                    long decompressedSize = lz4.LZ4F_decompressFrameParallel(ctx, decompressedPointer,
+                            decompressed.limit(), compressedPointer, compressedSize);
+                    checkForError(decompressedSize);
+                    long end = System.nanoTime();
+                    compressionTime = Math.min(compressionTime, (middle - start) / 1e9);
+                    decompressionTime = Math.min(decompressionTime, (end - middle) / 1e9);
+                }
+            } finally {
+                lz4.LZ4F_freeParallelContext(ctx);
+            }
+            if (!data.equals(decompressed)) {
+                throw new IllegalStateException("Input and output differ.");
+            }
+            System.out.printf("%d,%d,%.0f,%.0f%n", threads, compressedSize,
+                    data.limit() / compressionTime / 1e6, data.limit() / decompressionTime / 1e6);
+        }
+    }
+
+    private static void checkForError(long errorCode) throws LZ4Exception {
+        if (lz4.LZ4F_isError(errorCode) != 0) {
+            throw new LZ4Exception(lz4.LZ4F_getErrorName(errorCode).getString());
+        }
+    }
+
+    private static final class LZ4Exception extends Exception {
+        public LZ4Exception(final String message) {
+            super(message);
+        }
+    }
+}
@@ -1350,4 +1350,116 @@ public static native void LZ4F_resetDecompressionContext(LZ4FDecompressionContex
 
 
 
+// Parsed from lz4_parallel.h
+
+/*
+ * Multithreaded compression and decompression of LZ4 frames with independent blocks.
+ *
+ * The input is split into blocks compressed on a pool of threads owned by a
+ * LZ4F_parallelCtx, each with its own LZ4F_cctx, and the result is a standard
+ * LZ4 frame readable by LZ4F_decompress() or the lz4 command line tool.
+ * Blocks are processed in rounds of 2 per thread, so the memory used on top of
+ * the source and destination buffers is about 2 * nbThreads * block size.
+ */
+
+// #include <atomic>
+// #include <string.h>
+// #include <thread>
+// #include <vector>
+
+// #include "batch_pool.h"
+
+// #define LZ4F_STATIC_LINKING_ONLY // for LZ4F_errorCodes
+// #include <lz4.h>
+// #include <lz4frame.h>
+// Targeting ../LZ4FParallelContext.java
+
+
+
+/** Stops the threads and releases all resources of the context. */
+public static native void LZ4F_freeParallelContext(LZ4FParallelContext ctx);
+
+/** Creates a context with nbThreads threads, or as many as there are hardware threads when 0.
+ *  Returns NULL on failure. The functions taking a context run their work on its threads and
+ *  return when it is done, so a context must not be used by more than one call at a time. */
+public static native LZ4FParallelContext LZ4F_createParallelContext(@Cast("unsigned") int nbThreads);
+
+/** Returns the number of threads used by the context. */
+public static native @Cast("unsigned") int LZ4F_getParallelThreads(@Const LZ4FParallelContext ctx);
+
+/** Returns the maximum size of a frame produced by LZ4F_compressFrameParallel(). */
+public static native @Cast("size_t") long LZ4F_compressFrameParallelBound(@Cast("size_t") long srcSize, @Const LZ4FPreferences preferencesPtr);
+
+/** Compresses srcBuffer into a complete LZ4 frame in dstBuffer using all threads of the context.
+ *  The preferences are honored, except that blocks are always independent, content checksums
+ *  are disabled, and the content size gets recorded. The block size defaults to 4 MB.
+ *  Returns the size of the frame, or an error code to be tested with LZ4F_isError(). */
+public static native @Cast("size_t") long LZ4F_compressFrameParallel(LZ4FParallelContext ctx, Pointer dstBuffer, @Cast("size_t") long dstCapacity,
+                                  @Const Pointer srcBuffer, @Cast("size_t") long srcSize,
+                                  @Const LZ4FPreferences preferencesPtr);
+
+/** Decompresses all the frames in srcBuffer into dstBuffer. Frames with independent blocks and
+ *  no checksums or dictionary, as produced by LZ4F_compressFrameParallel(), are decompressed
+ *  using all threads of the context, while other frames fall back on LZ4F_decompress().
+ *  Returns the decompressed size, or an error code to be tested with LZ4F_isError(). */
+public static native @Cast("size_t") long LZ4F_decompressFrameParallel(LZ4FParallelContext ctx, Pointer dstBuffer, @Cast("size_t") long dstCapacity,
+                                    @Const Pointer srcBuffer, @Cast("size_t") long srcSize);
+
+
+// Parsed from lz4_file.h
+
+/*
+ * Streaming LZ4 frame compression and decompression between files in a single call.
+ *
+ * The files are processed in windows of a fixed size that get mapped in memory,
+ * compressed or decompressed directly from one mapping into the other, and
+ * unmapped, reusing the same LZ4F_cctx or LZ4F_dctx, so that the memory used
+ * stays constant regardless of the size of the files. On Windows, where mmap()
+ * is not available, the windows go through one read and one write buffer instead.
+ */
+
+// #include <errno.h>
+// #include <fcntl.h>
+// #include <stdlib.h>
+// #include <string.h>
+// #include <sys/stat.h>
+// #include <sys/types.h>
+// #ifdef _WIN32
+// #include <io.h>
+// #else
+// #include <sys/mman.h>
+// #include <unistd.h>
+// #endif
+
+// #define LZ4F_STATIC_LINKING_ONLY // for LZ4F_errorCodes
+// #include <lz4frame.h>
+
+/** Default size of the windows used when 0 is passed to the functions below */
+public static final int LZ4F_FILE_WINDOW_SIZE = (16 << 20);
+
+/** Compresses the regular file srcFd into an LZ4 frame written to the regular file dstFd,
+ *  from their current and start offsets respectively, in windows of windowSize bytes of input
+ *  (LZ4F_FILE_WINDOW_SIZE when 0). The content size gets recorded if preferencesPtr requests it.
+ *  The cctx can be reused for any number of files. Returns the size of the frame, or an error
+ *  code to be tested with LZ4F_isError(), where ERROR_GENERIC means I/O failure, as per errno. */
+public static native @Cast("size_t") long LZ4F_compressFd(LZ4FCompressionContext cctx, int srcFd, int dstFd,
+                       @Const LZ4FPreferences preferencesPtr, @Cast("size_t") long windowSize);
+
+/** Decompresses all the LZ4 frames of the regular file srcFd into the regular file dstFd,
+ *  from their current and start offsets respectively, in windows of windowSize bytes of output
+ *  (LZ4F_FILE_WINDOW_SIZE when 0). The dctx can be reused for any number of files.
+ *  Returns the decompressed size, or an error code to be tested with LZ4F_isError(). */
+public static native @Cast("size_t") long LZ4F_decompressFd(LZ4FDecompressionContext dctx, int srcFd, int dstFd, @Cast("size_t") long windowSize);
+
+/** Like LZ4F_compressFd(), but opens srcPath and creates or truncates dstPath. */
+public static native @Cast("size_t") long LZ4F_compressFile(LZ4FCompressionContext cctx, @Cast("const char*") BytePointer srcPath, @Cast("const char*") BytePointer dstPath,
+                         @Const LZ4FPreferences preferencesPtr, @Cast("size_t") long windowSize);
+public static native @Cast("size_t") long LZ4F_compressFile(LZ4FCompressionContext cctx, String srcPath, String dstPath,
+                         @Const LZ4FPreferences preferencesPtr, @Cast("size_t") long windowSize);
+
+/** Like LZ4F_decompressFd(), but opens srcPath and creates or truncates dstPath. */
+public static native @Cast("size_t") long LZ4F_decompressFile(LZ4FDecompressionContext dctx, @Cast("const char*") BytePointer srcPath, @Cast("const char*") BytePointer dstPath, @Cast("size_t") long windowSize);
+public static native @Cast("size_t") long LZ4F_decompressFile(LZ4FDecompressionContext dctx, String srcPath, String dstPath, @Cast("size_t") long windowSize);
+
+
 }
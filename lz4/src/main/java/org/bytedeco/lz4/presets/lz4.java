@@ -40,7 +40,7 @@ import org.bytedeco.lz4.LZ4FPreferences;
  */
 @Properties(inherit = javacpp.class, //
         value = { //
-                @Platform(include = {"<lz4.h>", "<lz4hc.h>", "<lz4frame.h>"}, link = "lz4@.1") //
+                @Platform(include = {"<lz4.h>", "<lz4hc.h>", "<lz4frame.h>", "lz4_parallel.h", "lz4_file.h"}, compiler = "cpp11", link = "lz4@.1") //
         }, //
         target = "org.bytedeco.lz4", //
         global = "org.bytedeco.lz4.global.lz4" //
@@ -101,6 +101,24 @@ public class lz4 implements InfoMapper {
                 .put(new Info("LZ4F_frameInfo_t").pointerTypes("LZ4FFrameInfo")) //
                 .put(new Info("LZ4F_preferences_t").pointerTypes("LZ4FPreferences")) //
         ;
+
+        // LZ4 PARALLEL
+        infoMap // Skip stuff
+                .put(new Info("lz4_parallel.h").linePatterns( //
+                        "^#ifndef LZ4_PARALLEL_PRIVATE_H$", // Skip private definitions
+                        "^#endif /\\* LZ4_PARALLEL_PRIVATE_H \\*/$" //
+                ).skip()) //
+                // Rename types
+                .put(new Info("LZ4F_parallelCtx").pointerTypes("LZ4FParallelContext")) //
+        ;
+
+        // LZ4 FILE
+        infoMap // Skip stuff
+                .put(new Info("lz4_file.h").linePatterns( //
+                        "^#ifndef LZ4_FILE_PRIVATE_H$", // Skip private definitions
+                        "^#endif /\\* LZ4_FILE_PRIVATE_H \\*/$" //
+                ).skip()) //
+        ;
     }
 
     /** Init the {@link LZ4FFrameInfo} object with the default values. */
@@ -0,0 +1,441 @@
+/*
+ * Streaming LZ4 frame compression and decompression between files in a single call.
+ *
+ * The files are processed in windows of a fixed size that get mapped in memory,
+ * compressed or decompressed directly from one mapping into the other, and
+ * unmapped, reusing the same LZ4F_cctx or LZ4F_dctx, so that the memory used
+ * stays constant regardless of the size of the files. On Windows, where mmap()
+ * is not available, the windows go through one read and one write buffer instead.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#define LZ4F_STATIC_LINKING_ONLY // for LZ4F_errorCodes
+#include <lz4frame.h>
+
+/** Default size of the windows used when 0 is passed to the functions below */
+#define LZ4F_FILE_WINDOW_SIZE (16 << 20)
+
+#ifndef LZ4_FILE_PRIVATE_H
+#define LZ4_FILE_PRIVATE_H
+
+#define LZ4F_FILE_ERROR(e) ((size_t)-(ptrdiff_t)LZ4F_ERROR_##e)
+
+#ifndef S_ISREG
+#define S_ISREG(m) (((m) & S_IFMT) == S_IFREG)
+#endif
+
+/* sequential reader of windows of an input file */
+typedef struct {
+    int fd;
+    long long pos, size;
+    size_t windowSize;
+    char* window;
+    size_t windowLength;
+#ifndef _WIN32
+    size_t delta; /* from the page boundary where the mapping starts */
+#endif
+} LZ4F_fileReader;
+
+/* sequential writer of windows of an output file, truncated to what got committed on close */
+typedef struct {
+    int fd;
+    long long pos;
+    size_t windowSize;
+    char* window;
+    size_t windowLength, used;
+#ifndef _WIN32
+    long long start; /* file offset of the mapping */
+#endif
+} LZ4F_fileWriter;
+
+static int LZ4F_fileReaderOpen(LZ4F_fileReader* r, int fd, size_t windowSize) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        return -1;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        errno = EINVAL;
+        return -1;
+    }
+    memset(r, 0, sizeof(*r));
+    r->fd = fd;
+    r->size = st.st_size;
+    r->windowSize = windowSize;
+#ifdef _WIN32
+    r->window = (char*)malloc(windowSize);
+    return r->window != NULL ? 0 : -1;
+#else
+    return 0;
+#endif
+}
+
+/* maps the next window and returns its length, 0 at the end of the file, or -1 on error */
+static long long LZ4F_fileReaderNext(LZ4F_fileReader* r, const char** data) {
+#ifdef _WIN32
+    int n = _read(r->fd, r->window, (unsigned)r->windowSize);
+    if (n < 0) {
+        return -1;
+    }
+    r->pos += n;
+    *data = r->window;
+    return n;
+#else
+    if (r->window != NULL) {
+        munmap(r->window, r->windowLength);
+        r->window = NULL;
+    }
+    if (r->pos >= r->size) {
+        return 0;
+    }
+    size_t length = r->size - r->pos < (long long)r->windowSize ? (size_t)(r->size - r->pos) : r->windowSize;
+    r->delta = (size_t)(r->pos % sysconf(_SC_PAGESIZE));
+    r->windowLength = length + r->delta;
+    void* p = mmap(NULL, r->windowLength, PROT_READ, MAP_SHARED, r->fd, r->pos - r->delta);
+    if (p == MAP_FAILED) {
+        return -1;
+    }
+    r->window = (char*)p;
+    madvise(r->window, r->windowLength, MADV_SEQUENTIAL);
+    r->pos += length;
+    *data = r->window + r->delta;
+    return (long long)length;
+#endif
+}
+
+static void LZ4F_fileReaderClose(LZ4F_fileReader* r) {
+#ifdef _WIN32
+    free(r->window);
+#else
+    if (r->window != NULL) {
+        munmap(r->window, r->windowLength);
+    }
+#endif
+    r->window = NULL;
+}
+
+static int LZ4F_fileWriterOpen(LZ4F_fileWriter* w, int fd, size_t windowSize) {
+#ifndef _WIN32
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        return -1;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        errno = EINVAL;
+        return -1;
+    }
+#endif
+    memset(w, 0, sizeof(*w));
+    w->fd = fd;
+    w->windowSize = windowSize;
+    return 0;
+}
+
+#ifndef _WIN32
+/* allocates the blocks of the range on disk, so that running out of space fails here with ENOSPC,
+ * instead of with SIGBUS when writing to the mapping of a sparse file */
+static int LZ4F_fileAllocate(int fd, long long offset, long long length) {
+#if defined(__APPLE__)
+    fstore_t store = { F_ALLOCATEALL, F_PEOFPOSMODE, 0, offset + length, 0 };
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        return -1;
+    }
+    store.fst_length -= st.st_size;
+    if (store.fst_length > 0 && fcntl(fd, F_PREALLOCATE, &store) != 0) {
+        return -1;
+    }
+    return st.st_size < offset + length ? ftruncate(fd, offset + length) : 0;
+#elif defined(__ANDROID__) && __ANDROID_API__ < 21
+    return ftruncate(fd, offset + length);
+#else
+    int err = posix_fallocate(fd, offset, length);
+    if (err == EINVAL || err == EOPNOTSUPP) {
+        /* not supported by the file system */
+        return ftruncate(fd, offset + length);
+    } else if (err != 0) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+#endif
+}
+#endif
+
+#ifdef _WIN32
+static int LZ4F_fileWriterFlush(LZ4F_fileWriter* w) {
+    size_t written = 0;
+    while (written < w->used) {
+        int n = _write(w->fd, w->window + written, (unsigned)(w->used - written));
+        if (n <= 0) {
+            return -1;
+        }
+        written += n;
+    }
+    w->used = 0;
+    return 0;
+}
+#endif
+
+/* returns where at least capacity bytes can be written, for LZ4F_fileWriterCommit() to account for */
+static char* LZ4F_fileWriterReserve(LZ4F_fileWriter* w, size_t capacity, size_t* available) {
+    if (w->window == NULL || w->windowLength - w->used < capacity) {
+        size_t length = capacity > w->windowSize ? capacity : w->windowSize;
+#ifdef _WIN32
+        if (w->window != NULL && LZ4F_fileWriterFlush(w) != 0) {
+            return NULL;
+        }
+        if (w->windowLength < length) {
+            char* p = (char*)realloc(w->window, length);
+            if (p == NULL) {
+                return NULL;
+            }
+            w->window = p;
+            w->windowLength = length;
+        }
+#else
+        if (w->window != NULL) {
+            munmap(w->window, w->windowLength);
+            w->window = NULL;
+        }
+        size_t delta = (size_t)(w->pos % sysconf(_SC_PAGESIZE));
+        w->start = w->pos - delta;
+        w->windowLength = length + delta;
+        w->used = delta;
+        if (LZ4F_fileAllocate(w->fd, w->start, (long long)w->windowLength) != 0) {
+            return NULL;
+        }
+        void* p = mmap(NULL, w->windowLength, PROT_READ | PROT_WRITE, MAP_SHARED, w->fd, w->start);
+        if (p == MAP_FAILED) {
+            return NULL;
+        }
+        w->window = (char*)p;
+#endif
+    }
+    *available = w->windowLength - w->used;
+    return w->window + w->used;
+}
+
+static void LZ4F_fileWriterCommit(LZ4F_fileWriter* w, size_t length) {
+    w->used += length;
+    w->pos += length;
+}
+
+static int LZ4F_fileWriterClose(LZ4F_fileWriter* w) {
+    int ret = 0;
+#ifdef _WIN32
+    if (w->window != NULL) {
+        ret = LZ4F_fileWriterFlush(w);
+        free(w->window);
+    }
+#else
+    if (w->window != NULL) {
+        munmap(w->window, w->windowLength);
+    }
+    if (ftruncate(w->fd, w->pos) != 0) {
+        ret = -1;
+    }
+#endif
+    w->window = NULL;
+    return ret;
+}
+
+#endif /* LZ4_FILE_PRIVATE_H */
+
+/** Compresses the regular file srcFd into an LZ4 frame written to the regular file dstFd,
+ *  from their current and start offsets respectively, in windows of windowSize bytes of input
+ *  (LZ4F_FILE_WINDOW_SIZE when 0). The content size gets recorded if preferencesPtr requests it.
+ *  The cctx can be reused for any number of files. Returns the size of the frame, or an error
+ *  code to be tested with LZ4F_isError(), where ERROR_GENERIC means I/O failure, as per errno. */
+size_t LZ4F_compressFd(LZ4F_cctx* cctx, int srcFd, int dstFd,
+                       const LZ4F_preferences_t* preferencesPtr, size_t windowSize) {
+    LZ4F_preferences_t prefs;
+    LZ4F_fileReader reader;
+    LZ4F_fileWriter writer;
+    const char* src;
+    char* dst;
+    long long length;
+    size_t available, ret;
+
+    if (windowSize == 0) {
+        windowSize = LZ4F_FILE_WINDOW_SIZE;
+    }
+    if (LZ4F_fileReaderOpen(&reader, srcFd, windowSize) != 0) {
+        return LZ4F_FILE_ERROR(GENERIC);
+    }
+#ifndef _WIN32
+    reader.pos = lseek(srcFd, 0, SEEK_CUR);
+    if (reader.pos < 0) {
+        reader.pos = 0;
+    }
+#endif
+    if (LZ4F_fileWriterOpen(&writer, dstFd, LZ4F_compressBound(windowSize, preferencesPtr)) != 0) {
+        LZ4F_fileReaderClose(&reader);
+        return LZ4F_FILE_ERROR(GENERIC);
+    }
+
+    memset(&prefs, 0, sizeof(prefs));
+    if (preferencesPtr != NULL) {
+        prefs = *preferencesPtr;
+    }
+    if (prefs.frameInfo.contentSize != 0) {
+        prefs.frameInfo.contentSize = reader.size - reader.pos;
+    }
+
+    dst = LZ4F_fileWriterReserve(&writer, LZ4F_HEADER_SIZE_MAX, &available);
+    ret = dst == NULL ? LZ4F_FILE_ERROR(GENERIC) : LZ4F_compressBegin(cctx, dst, available, &prefs);
+    while (!LZ4F_isError(ret)) {
+        LZ4F_fileWriterCommit(&writer, ret);
+        length = LZ4F_fileReaderNext(&reader, &src);
+        if (length < 0) {
+            ret = LZ4F_FILE_ERROR(GENERIC);
+            break;
+        }
+        dst = LZ4F_fileWriterReserve(&writer, LZ4F_compressBound((size_t)length, &prefs), &available);
+        if (dst == NULL) {
+            ret = LZ4F_FILE_ERROR(GENERIC);
+        } else if (length > 0) {
+            ret = LZ4F_compressUpdate(cctx, dst, available, src, (size_t)length, NULL);
+        } else {
+            ret = LZ4F_compressEnd(cctx, dst, available, NULL);
+            if (!LZ4F_isError(ret)) {
+                LZ4F_fileWriterCommit(&writer, ret);
+            }
+            break;
+        }
+    }
+    LZ4F_fileReaderClose(&reader);
+    if (LZ4F_fileWriterClose(&writer) != 0 && !LZ4F_isError(ret)) {
+        ret = LZ4F_FILE_ERROR(GENERIC);
+    }
+    return LZ4F_isError(ret) ? ret : (size_t)writer.pos;
+}
+
+/** Decompresses all the LZ4 frames of the regular file srcFd into the regular file dstFd,
+ *  from their current and start offsets respectively, in windows of windowSize bytes of output
+ *  (LZ4F_FILE_WINDOW_SIZE when 0). The dctx can be reused for any number of files.
+ *  Returns the decompressed size, or an error code to be tested with LZ4F_isError(). */
+size_t LZ4F_decompressFd(LZ4F_dctx* dctx, int srcFd, int dstFd, size_t windowSize) {
+    LZ4F_fileReader reader;
+    LZ4F_fileWriter writer;
+    const char* src;
+    char* dst;
+    long long length;
+    size_t available, ret = 0;
+
+    if (windowSize == 0) {
+        windowSize = LZ4F_FILE_WINDOW_SIZE;
+    }
+    if (LZ4F_fileReaderOpen(&reader, srcFd, windowSize) != 0) {
+        return LZ4F_FILE_ERROR(GENERIC);
+    }
+#ifndef _WIN32
+    reader.pos = lseek(srcFd, 0, SEEK_CUR);
+    if (reader.pos < 0) {
+        reader.pos = 0;
+    }
+#endif
+    if (LZ4F_fileWriterOpen(&writer, dstFd, windowSize) != 0) {
+        LZ4F_fileReaderClose(&reader);
+        return LZ4F_FILE_ERROR(GENERIC);
+    }
+    LZ4F_resetDecompressionContext(dctx);
+
+    while (!LZ4F_isError(ret) && (length = LZ4F_fileReaderNext(&reader, &src)) != 0) {
+        if (length < 0) {
+            ret = LZ4F_FILE_ERROR(GENERIC);
+            break;
+        }
+        while ((size_t)length > 0) {
+            size_t srcSize = (size_t)length, dstSize;
+            dst = LZ4F_fileWriterReserve(&writer, 1, &available);
+            if (dst == NULL) {
+                ret = LZ4F_FILE_ERROR(GENERIC);
+                break;
+            }
+            dstSize = available;
+            ret = LZ4F_decompress(dctx, dst, &dstSize, src, &srcSize, NULL);
+            if (LZ4F_isError(ret)) {
+                break;
+            }
+            LZ4F_fileWriterCommit(&writer, dstSize);
+            src += srcSize;
+            length -= srcSize;
+        }
+    }
+    if (!LZ4F_isError(ret)) {
+        // flush what remains of the last block, if the frame ended with the window
+        while (ret != 0) {
+            size_t srcSize = 0, dstSize;
+            dst = LZ4F_fileWriterReserve(&writer, 1, &available);
+            if (dst == NULL) {
+                ret = LZ4F_FILE_ERROR(GENERIC);
+                break;
+            }
+            dstSize = available;
+            ret = LZ4F_decompress(dctx, dst, &dstSize, NULL, &srcSize, NULL);
+            if (LZ4F_isError(ret) || dstSize == 0) {
+                ret = LZ4F_isError(ret) ? ret : LZ4F_FILE_ERROR(frameSize_wrong);
+                break;
+            }
+            LZ4F_fileWriterCommit(&writer, dstSize);
+        }
+    }
+    LZ4F_fileReaderClose(&reader);
+    if (LZ4F_fileWriterClose(&writer) != 0 && !LZ4F_isError(ret)) {
+        ret = LZ4F_FILE_ERROR(GENERIC);
+    }
+    return LZ4F_isError(ret) ? ret : (size_t)writer.pos;
+}
+
+/** Like LZ4F_compressFd(), but opens srcPath and creates or truncates dstPath. */
+size_t LZ4F_compressFile(LZ4F_cctx* cctx, const char* srcPath, const char* dstPath,
+                         const LZ4F_preferences_t* preferencesPtr, size_t windowSize) {
+#ifdef _WIN32
+    int srcFd = _open(srcPath, _O_RDONLY | _O_BINARY);
+    int dstFd = _open(dstPath, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    int srcFd = open(srcPath, O_RDONLY);
+    int dstFd = open(dstPath, O_RDWR | O_CREAT | O_TRUNC, 0666);
+#endif
+    size_t ret = srcFd < 0 || dstFd < 0 ? LZ4F_FILE_ERROR(GENERIC)
+               : LZ4F_compressFd(cctx, srcFd, dstFd, preferencesPtr, windowSize);
+    if (srcFd >= 0) {
+        close(srcFd);
+    }
+    if (dstFd >= 0) {
+        close(dstFd);
+    }
+    return ret;
+}
+
+/** Like LZ4F_decompressFd(), but opens srcPath and creates or truncates dstPath. */
+size_t LZ4F_decompressFile(LZ4F_dctx* dctx, const char* srcPath, const char* dstPath, size_t windowSize) {
+#ifdef _WIN32
+    int srcFd = _open(srcPath, _O_RDONLY | _O_BINARY);
+    int dstFd = _open(dstPath, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    int srcFd = open(srcPath, O_RDONLY);
+    int dstFd = open(dstPath, O_RDWR | O_CREAT | O_TRUNC, 0666);
+#endif
+    size_t ret = srcFd < 0 || dstFd < 0 ? LZ4F_FILE_ERROR(GENERIC)
+               : LZ4F_decompressFd(dctx, srcFd, dstFd, windowSize);
+    if (srcFd >= 0) {
+        close(srcFd);
+    }
+    if (dstFd >= 0) {
+        close(dstFd);
+    }
+    return ret;
+}
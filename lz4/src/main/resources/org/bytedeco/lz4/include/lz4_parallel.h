@@ -0,0 +1,308 @@
+/*
+ * Multithreaded compression and decompression of LZ4 frames with independent blocks.
+ *
+ * The input is split into blocks compressed on a pool of threads owned by a
+ * LZ4F_parallelCtx, each with its own LZ4F_cctx, and the result is a standard
+ * LZ4 frame readable by LZ4F_decompress() or the lz4 command line tool.
+ * Blocks are processed in rounds of 2 per thread, so the memory used on top of
+ * the source and destination buffers is about 2 * nbThreads * block size.
+ */
+
+#include <atomic>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include "batch_pool.h"
+
+#define LZ4F_STATIC_LINKING_ONLY // for LZ4F_errorCodes
+#include <lz4.h>
+#include <lz4frame.h>
+
+typedef struct LZ4F_parallelCtx_s LZ4F_parallelCtx;
+
+#ifndef LZ4_PARALLEL_PRIVATE_H
+#define LZ4_PARALLEL_PRIVATE_H
+
+struct LZ4F_parallelCtx_s {
+    unsigned nbThreads;
+    bytedeco::BatchPool* pool; /* calls jobs with the index of the worker, and so of its cctx */
+    std::vector<LZ4F_cctx*> cctxs;
+    LZ4F_dctx* dctx;
+    std::vector<std::vector<char> > slots;
+    std::vector<size_t> slotSizes;
+};
+
+#define LZ4F_PARALLEL_ERROR(e) ((size_t)-(ptrdiff_t)LZ4F_ERROR_##e)
+
+static size_t LZ4F_parallelBlockSize(LZ4F_blockSizeID_t blockSizeID) {
+    return (size_t)1 << (8 + 2 * blockSizeID);
+}
+
+/* applies the preferences enforced by LZ4F_compressFrameParallel() */
+static LZ4F_preferences_t LZ4F_parallelPreferences(size_t srcSize, const LZ4F_preferences_t* preferencesPtr) {
+    LZ4F_preferences_t prefs;
+    memset(&prefs, 0, sizeof(prefs));
+    if (preferencesPtr != NULL) {
+        prefs = *preferencesPtr;
+    }
+    if (prefs.frameInfo.blockSizeID == LZ4F_default) {
+        prefs.frameInfo.blockSizeID = LZ4F_max4MB;
+    }
+    prefs.frameInfo.blockMode = LZ4F_blockIndependent;
+    prefs.frameInfo.contentChecksumFlag = LZ4F_noContentChecksum;
+    prefs.frameInfo.contentSize = srcSize;
+    prefs.autoFlush = 1;
+    return prefs;
+}
+
+/* decompresses one frame of any kind with LZ4F_decompress() into dst, updating *srcSizePtr to what it read */
+static size_t LZ4F_decompressFrameSerial(char* dst, size_t dstCapacity, const char* src, size_t* srcSizePtr) {
+    // a fresh context, since LZ4F_resetDecompressionContext() keeps the content size of the last frame
+    LZ4F_dctx* dctx;
+    size_t srcPos = 0, dstPos = 0, ret = LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION);
+    if (LZ4F_isError(ret)) {
+        return ret;
+    }
+    do {
+        size_t dstSize = dstCapacity - dstPos;
+        size_t srcSize = *srcSizePtr - srcPos;
+        ret = LZ4F_decompress(dctx, dst + dstPos, &dstSize, src + srcPos, &srcSize, NULL);
+        if (!LZ4F_isError(ret) && dstSize == 0 && srcSize == 0) {
+            ret = dstPos == dstCapacity ? LZ4F_PARALLEL_ERROR(dstMaxSize_tooSmall)
+                                        : LZ4F_PARALLEL_ERROR(frameHeader_incomplete);
+        }
+        srcPos += srcSize;
+        dstPos += dstSize;
+    } while (ret != 0 && !LZ4F_isError(ret));
+    LZ4F_freeDecompressionContext(dctx);
+    *srcSizePtr = srcPos;
+    return LZ4F_isError(ret) ? ret : dstPos;
+}
+
+#endif /* LZ4_PARALLEL_PRIVATE_H */
+
+/** Stops the threads and releases all resources of the context. */
+void LZ4F_freeParallelContext(LZ4F_parallelCtx* ctx) {
+    if (ctx == NULL) {
+        return;
+    }
+    delete ctx->pool;
+    for (size_t i = 0; i < ctx->cctxs.size(); i++) {
+        LZ4F_freeCompressionContext(ctx->cctxs[i]);
+    }
+    LZ4F_freeDecompressionContext(ctx->dctx);
+    delete ctx;
+}
+
+/** Creates a context with nbThreads threads, or as many as there are hardware threads when 0.
+ *  Returns NULL on failure. The functions taking a context run their work on its threads and
+ *  return when it is done, so a context must not be used by more than one call at a time. */
+LZ4F_parallelCtx* LZ4F_createParallelContext(unsigned nbThreads) {
+    if (nbThreads == 0) {
+        nbThreads = std::thread::hardware_concurrency();
+    }
+    if (nbThreads == 0) {
+        nbThreads = 1;
+    }
+    LZ4F_parallelCtx* ctx = new LZ4F_parallelCtx();
+    ctx->nbThreads = nbThreads;
+    ctx->cctxs.resize(nbThreads);
+    ctx->dctx = NULL;
+    ctx->pool = NULL;
+    bool failed = LZ4F_isError(LZ4F_createDecompressionContext(&ctx->dctx, LZ4F_VERSION));
+    for (unsigned i = 0; i < nbThreads; i++) {
+        failed |= LZ4F_isError(LZ4F_createCompressionContext(&ctx->cctxs[i], LZ4F_VERSION));
+    }
+    try {
+        ctx->pool = new bytedeco::BatchPool((int)nbThreads);
+    } catch (...) {
+        failed = true;
+    }
+    if (failed) {
+        LZ4F_freeParallelContext(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+/** Returns the number of threads used by the context. */
+unsigned LZ4F_getParallelThreads(const LZ4F_parallelCtx* ctx) {
+    return ctx->nbThreads;
+}
+
+/** Returns the maximum size of a frame produced by LZ4F_compressFrameParallel(). */
+size_t LZ4F_compressFrameParallelBound(size_t srcSize, const LZ4F_preferences_t* preferencesPtr) {
+    LZ4F_preferences_t prefs = LZ4F_parallelPreferences(srcSize, preferencesPtr);
+    size_t blockSize = LZ4F_parallelBlockSize(prefs.frameInfo.blockSizeID);
+    size_t nbBlocks = (srcSize + blockSize - 1) / blockSize;
+    size_t blockOverhead = 4 + (prefs.frameInfo.blockChecksumFlag == LZ4F_blockChecksumEnabled ? 4 : 0);
+    return LZ4F_HEADER_SIZE_MAX + srcSize + nbBlocks * blockOverhead + 4;
+}
+
+/** Compresses srcBuffer into a complete LZ4 frame in dstBuffer using all threads of the context.
+ *  The preferences are honored, except that blocks are always independent, content checksums
+ *  are disabled, and the content size gets recorded. The block size defaults to 4 MB.
+ *  Returns the size of the frame, or an error code to be tested with LZ4F_isError(). */
+size_t LZ4F_compressFrameParallel(LZ4F_parallelCtx* ctx, void* dstBuffer, size_t dstCapacity,
+                                  const void* srcBuffer, size_t srcSize,
+                                  const LZ4F_preferences_t* preferencesPtr) {
+    LZ4F_preferences_t prefs = LZ4F_parallelPreferences(srcSize, preferencesPtr);
+    size_t blockSize = LZ4F_parallelBlockSize(prefs.frameInfo.blockSizeID);
+    size_t slotSize = LZ4F_compressBound(blockSize, &prefs);
+    size_t nbBlocks = (srcSize + blockSize - 1) / blockSize;
+    const char* src = (const char*)srcBuffer;
+    char* dst = (char*)dstBuffer;
+
+    size_t pos = LZ4F_compressBegin(ctx->cctxs[0], dst, dstCapacity, &prefs);
+    if (LZ4F_isError(pos)) {
+        return pos;
+    }
+
+    size_t roundSize = 2 * ctx->nbThreads;
+    ctx->slots.resize(roundSize);
+    ctx->slotSizes.resize(roundSize);
+    for (size_t first = 0; first < nbBlocks; first += roundSize) {
+        size_t count = nbBlocks - first < roundSize ? nbBlocks - first : roundSize;
+        std::atomic<size_t> next(0);
+        ctx->pool->run([&](int worker) {
+            LZ4F_cctx* cctx = ctx->cctxs[worker];
+            char header[LZ4F_HEADER_SIZE_MAX];
+            for (size_t i; (i = next++) < count; ) {
+                size_t offset = (first + i) * blockSize;
+                size_t size = srcSize - offset < blockSize ? srcSize - offset : blockSize;
+                std::vector<char>& slot = ctx->slots[i];
+                slot.resize(slotSize);
+                // a fresh frame per block, from which only the block gets kept
+                size_t r = LZ4F_compressBegin(cctx, header, sizeof(header), &prefs);
+                if (!LZ4F_isError(r)) {
+                    r = LZ4F_compressUpdate(cctx, slot.data(), slotSize, src + offset, size, NULL);
+                }
+                ctx->slotSizes[i] = r;
+            }
+        });
+
+        // lay out the blocks one after the other, and copy them in parallel as well
+        std::vector<size_t> offsets(count);
+        for (size_t i = 0; i < count; i++) {
+            if (LZ4F_isError(ctx->slotSizes[i])) {
+                return ctx->slotSizes[i];
+            }
+            offsets[i] = pos;
+            pos += ctx->slotSizes[i];
+        }
+        if (pos > dstCapacity) {
+            return LZ4F_PARALLEL_ERROR(dstMaxSize_tooSmall);
+        }
+        next = 0;
+        ctx->pool->run([&](int worker) {
+            for (size_t i; (i = next++) < count; ) {
+                memcpy(dst + offsets[i], ctx->slots[i].data(), ctx->slotSizes[i]);
+            }
+        });
+    }
+
+    // end mark, without content checksum
+    if (dstCapacity - pos < 4) {
+        return LZ4F_PARALLEL_ERROR(dstMaxSize_tooSmall);
+    }
+    memset(dst + pos, 0, 4);
+    return pos + 4;
+}
+
+/** Decompresses all the frames in srcBuffer into dstBuffer. Frames with independent blocks and
+ *  no checksums or dictionary, as produced by LZ4F_compressFrameParallel(), are decompressed
+ *  using all threads of the context, while other frames fall back on LZ4F_decompress().
+ *  Returns the decompressed size, or an error code to be tested with LZ4F_isError(). */
+size_t LZ4F_decompressFrameParallel(LZ4F_parallelCtx* ctx, void* dstBuffer, size_t dstCapacity,
+                                    const void* srcBuffer, size_t srcSize) {
+    const char* src = (const char*)srcBuffer;
+    char* dst = (char*)dstBuffer;
+    size_t srcPos = 0, dstPos = 0;
+
+    while (srcPos < srcSize) {
+        LZ4F_frameInfo_t info;
+        size_t headerSize = srcSize - srcPos;
+        LZ4F_resetDecompressionContext(ctx->dctx);
+        size_t r = LZ4F_getFrameInfo(ctx->dctx, &info, src + srcPos, &headerSize);
+        if (LZ4F_isError(r)) {
+            return r;
+        }
+        if (info.frameType != LZ4F_frame || info.blockMode != LZ4F_blockIndependent
+                || info.contentChecksumFlag != LZ4F_noContentChecksum
+                || info.blockChecksumFlag != LZ4F_noBlockChecksum || info.dictID != 0) {
+            size_t frameSize = srcSize - srcPos;
+            r = LZ4F_decompressFrameSerial(dst + dstPos, dstCapacity - dstPos, src + srcPos, &frameSize);
+            if (LZ4F_isError(r)) {
+                return r;
+            }
+            srcPos += frameSize;
+            dstPos += r;
+            continue;
+        }
+
+        // index the blocks, which only requires reading their sizes
+        size_t blockSize = LZ4F_parallelBlockSize(info.blockSizeID == LZ4F_default ? LZ4F_max64KB : info.blockSizeID);
+        std::vector<size_t> blockOffsets;
+        srcPos += headerSize;
+        for (;;) {
+            if (srcSize - srcPos < 4) {
+                return LZ4F_PARALLEL_ERROR(frameSize_wrong);
+            }
+            const unsigned char* p = (const unsigned char*)src + srcPos;
+            size_t size = (p[0] | (p[1] << 8) | (p[2] << 16) | ((size_t)p[3] << 24)) & 0x7FFFFFFFU;
+            if (size == 0 && p[3] == 0) {
+                srcPos += 4;
+                break;
+            }
+            if (size > blockSize || srcSize - srcPos - 4 < size) {
+                return LZ4F_PARALLEL_ERROR(frameSize_wrong);
+            }
+            blockOffsets.push_back(srcPos);
+            srcPos += 4 + size;
+        }
+
+        size_t nbBlocks = blockOffsets.size();
+        size_t roundSize = 2 * ctx->nbThreads;
+        ctx->slots.resize(roundSize);
+        ctx->slotSizes.resize(roundSize);
+        for (size_t first = 0; first < nbBlocks; first += roundSize) {
+            size_t count = nbBlocks - first < roundSize ? nbBlocks - first : roundSize;
+            std::atomic<size_t> next(0);
+            ctx->pool->run([&](int worker) {
+                for (size_t i; (i = next++) < count; ) {
+                    const unsigned char* p = (const unsigned char*)src + blockOffsets[first + i];
+                    size_t size = (p[0] | (p[1] << 8) | (p[2] << 16) | ((size_t)p[3] << 24)) & 0x7FFFFFFFU;
+                    std::vector<char>& slot = ctx->slots[i];
+                    slot.resize(blockSize);
+                    if (p[3] & 0x80) {
+                        memcpy(slot.data(), p + 4, size);
+                        ctx->slotSizes[i] = size;
+                    } else {
+                        int n = LZ4_decompress_safe((const char*)p + 4, slot.data(), (int)size, (int)blockSize);
+                        ctx->slotSizes[i] = n < 0 ? LZ4F_PARALLEL_ERROR(decompressionFailed) : (size_t)n;
+                    }
+                }
+            });
+
+            std::vector<size_t> offsets(count);
+            for (size_t i = 0; i < count; i++) {
+                if (LZ4F_isError(ctx->slotSizes[i])) {
+                    return ctx->slotSizes[i];
+                }
+                offsets[i] = dstPos;
+                dstPos += ctx->slotSizes[i];
+            }
+            if (dstPos > dstCapacity) {
+                return LZ4F_PARALLEL_ERROR(dstMaxSize_tooSmall);
+            }
+            next = 0;
+            ctx->pool->run([&](int worker) {
+                for (size_t i; (i = next++) < count; ) {
+                    memcpy(dst + offsets[i], ctx->slots[i].data(), ctx->slotSizes[i]);
+                }
+            });
+        }
+    }
+    return dstPos;
+}
@@ -0,0 +1,79 @@
+import java.io.ByteArrayOutputStream;
+import java.nio.charset.StandardCharsets;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.modsecurity.*;
+
+/**
+ * Evaluates a batch of requests with a TransactionBatch, packing their strings
+ * and bodies in a single buffer, and reports the number of requests per second.
+ */
+public class ModSecurityBatchIntervention {
+    private static final String RULES =
+            "SecRuleEngine On\n" +
+            "SecRequestBodyAccess On\n" +
+            "SecRule REQUEST_URI \"@contains /attack\" \"id:1,phase:1,t:lowercase,deny,status:403\"\n" +
+            "SecRule REQUEST_HEADERS:User-Agent \"@contains scanner\" \"id:2,phase:1,log,pass\"\n" +
+            "SecRule REQUEST_BODY \"@contains drop table\" \"id:3,phase:2,t:lowercase,deny,status:406\"";
+
+    static ByteArrayOutputStream data = new ByteArrayOutputStream();
+
+    static void slice(BatchSlice slice, String s) {
+        byte[] bytes = s.getBytes(StandardCharsets.UTF_8);
+        slice.offset(data.size()).length(bytes.length);
+        data.write(bytes, 0, bytes.length);
+    }
+
+    public static void main(String[] args) {
+        int count = args.length > 0 ? Integer.parseInt(args[0]) : 10000;
+        int threads = args.length > 1 ? Integer.parseInt(args[1]) : 0;
+
+        ModSecurity modSecurity = new ModSecurity();
+        RulesSet rulesSet = new RulesSet();
+        if (rulesSet.load(RULES) < 0) {
+            System.out.println("Cannot load rules: " + rulesSet.getParserError().getString());
+            System.exit(1);
+        }
+
+        BatchRequest requests = new BatchRequest(count);
+        BatchHeader headers = new BatchHeader(2 * count);
+        for (int i = 0; i < count; i++) {
+            BatchRequest request = requests.getPointer(i);
+            slice(request.clientIp(), "10.0.0." + (i % 250 + 1));
+            request.clientPort(40000 + i % 20000);
+            slice(request.serverIp(), "10.0.1.1");
+            request.serverPort(80);
+            slice(request.uri(), i % 10 == 0 ? "/attack?id=" + i : "/index.html?id=" + i);
+            slice(request.method(), i % 4 == 0 ? "POST" : "GET");
+            slice(request.httpVersion(), "1.1");
+            request.firstHeader(2 * i).headerCount(2);
+            BatchHeader host = headers.getPointer(2 * i), agent = headers.getPointer(2 * i + 1);
+            slice(host.key(), "Host");
+            slice(host.value(), "example.com");
+            slice(agent.key(), "User-Agent");
+            slice(agent.value(), i % 7 == 0 ? "scanner/1.0" : "Mozilla/5.0");
+            slice(request.body(), i % 4 == 0 ? (i % 12 == 0 ? "q=1; DROP TABLE users" : "q=" + i) : "");
+        }
+        BytePointer buffer = new BytePointer(data.toByteArray());
+        BatchResult results = new BatchResult(count);
+
+        TransactionBatch batch = new TransactionBatch(modSecurity, rulesSet, threads);
+        long start = System.nanoTime();
+        int disruptive = batch.process(buffer, requests, headers, count, results);
+        double seconds = (System.nanoTime() - start) / 1e9;
+
+        int errors = 0, matched = 0;
+        for (int i = 0; i < count; i++) {
+            BatchResult result = results.getPointer(i);
+            errors += result.error() != 0 ? 1 : 0;
+            matched += result.matchedRules() > 0 ? 1 : 0;
+            if (i < 12 && result.disruptive() != 0) {
+                System.out.println("Request " + i + ": status " + result.status() + " by rule " + result.ruleId()
+                        + " in phase " + result.phase());
+            }
+        }
+        System.out.printf("%d requests with %d threads in %.3f s, %.0f requests/s%n",
+                count, batch.getThreadCount(), seconds, count / seconds);
+        System.out.println(disruptive + " interrupted, " + matched + " matched, " + errors + " errors");
+        batch.deallocate();
+    }
+}
@@ -0,0 +1,35 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.modsecurity;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.modsecurity.global.modsecurity.*;
+
+
+/** A request header, as slices of the data buffer of a batch. */
+@Namespace("modsecurity") @Properties(inherit = org.bytedeco.modsecurity.presets.modsecurity.class)
+public class BatchHeader extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public BatchHeader() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public BatchHeader(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public BatchHeader(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public BatchHeader position(long position) {
+        return (BatchHeader)super.position(position);
+    }
+    @Override public BatchHeader getPointer(long i) {
+        return new BatchHeader((Pointer)this).offsetAddress(i);
+    }
+
+    public native @ByRef BatchSlice key(); public native BatchHeader key(BatchSlice setter);
+    public native @ByRef BatchSlice value(); public native BatchHeader value(BatchSlice setter);
+}
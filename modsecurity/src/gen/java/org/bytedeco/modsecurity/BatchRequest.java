@@ -0,0 +1,45 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.modsecurity;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.modsecurity.global.modsecurity.*;
+
+
+/** An HTTP request, as slices of the data buffer of a batch. */
+@Namespace("modsecurity") @Properties(inherit = org.bytedeco.modsecurity.presets.modsecurity.class)
+public class BatchRequest extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public BatchRequest() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public BatchRequest(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public BatchRequest(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public BatchRequest position(long position) {
+        return (BatchRequest)super.position(position);
+    }
+    @Override public BatchRequest getPointer(long i) {
+        return new BatchRequest((Pointer)this).offsetAddress(i);
+    }
+
+    public native @ByRef BatchSlice clientIp(); public native BatchRequest clientIp(BatchSlice setter);
+    public native int clientPort(); public native BatchRequest clientPort(int setter);
+    public native @ByRef BatchSlice serverIp(); public native BatchRequest serverIp(BatchSlice setter);
+    public native int serverPort(); public native BatchRequest serverPort(int setter);
+    public native @ByRef BatchSlice uri(); public native BatchRequest uri(BatchSlice setter);
+    public native @ByRef BatchSlice method(); public native BatchRequest method(BatchSlice setter);
+    /** The HTTP version, for example "1.1". */
+    public native @ByRef BatchSlice httpVersion(); public native BatchRequest httpVersion(BatchSlice setter);
+    /** The index of the first header in the header array of the batch. */
+    public native @Cast("size_t") long firstHeader(); public native BatchRequest firstHeader(long setter);
+    public native @Cast("size_t") long headerCount(); public native BatchRequest headerCount(long setter);
+    public native @ByRef BatchSlice body(); public native BatchRequest body(BatchSlice setter);
+}
@@ -0,0 +1,46 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.modsecurity;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.modsecurity.global.modsecurity.*;
+
+
+/** The outcome of a request, from the intervention of its transaction. */
+@Namespace("modsecurity") @Properties(inherit = org.bytedeco.modsecurity.presets.modsecurity.class)
+public class BatchResult extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public BatchResult() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public BatchResult(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public BatchResult(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public BatchResult position(long position) {
+        return (BatchResult)super.position(position);
+    }
+    @Override public BatchResult getPointer(long i) {
+        return new BatchResult((Pointer)this).offsetAddress(i);
+    }
+
+    /** The status code of the intervention, or 200 if there is none. */
+    public native int status(); public native BatchResult status(int setter);
+    public native int pause(); public native BatchResult pause(int setter);
+    /** Non-zero if the request must be interrupted. */
+    public native int disruptive(); public native BatchResult disruptive(int setter);
+    /** The id of the disruptive rule, or of the last rule that matched, or 0. */
+    public native int ruleId(); public native BatchResult ruleId(int setter);
+    /** The phase of that rule. */
+    public native int phase(); public native BatchResult phase(int setter);
+    /** The number of rules that matched. */
+    public native int matchedRules(); public native BatchResult matchedRules(int setter);
+    /** 0, or -1 if processing the request failed. */
+    public native int error(); public native BatchResult error(int setter);
+}
@@ -0,0 +1,35 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.modsecurity;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.modsecurity.global.modsecurity.*;
+
+
+/** A slice of the data buffer of a batch. */
+@Namespace("modsecurity") @Properties(inherit = org.bytedeco.modsecurity.presets.modsecurity.class)
+public class BatchSlice extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public BatchSlice() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public BatchSlice(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public BatchSlice(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public BatchSlice position(long position) {
+        return (BatchSlice)super.position(position);
+    }
+    @Override public BatchSlice getPointer(long i) {
+        return new BatchSlice((Pointer)this).offsetAddress(i);
+    }
+
+    public native @Cast("size_t") long offset(); public native BatchSlice offset(long setter);
+    public native @Cast("size_t") long length(); public native BatchSlice length(long setter);
+}
@@ -0,0 +1,53 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.modsecurity;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.modsecurity.global.modsecurity.*;
+
+
+/**
+ * Processes batches of requests on a pool of threads that all share the same
+ * ModSecurity and RulesSet objects. The calling thread takes part in the work.
+ * process() must not be called again before it returns, so a TransactionBatch
+ * must not be used from more than one thread at a time.
+ */
+@Namespace("modsecurity") @NoOffset @Properties(inherit = org.bytedeco.modsecurity.presets.modsecurity.class)
+public class TransactionBatch extends Pointer {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public TransactionBatch(Pointer p) { super(p); }
+
+    /**
+     * @param modsec the ModSecurity instance, which must outlive this object
+     * @param rules the rules to evaluate, which must outlive this object
+     * @param threads the number of threads to use, including the calling one,
+     *        or 0 for the number of hardware threads
+     */
+    public TransactionBatch(ModSecurity modsec, RulesSet rules, int threads) { super((Pointer)null); allocate(modsec, rules, threads); }
+    private native void allocate(ModSecurity modsec, RulesSet rules, int threads);
+
+    public native int getThreadCount();
+
+    /**
+     * Evaluates a batch of requests and waits for all of them.
+     *
+     * @param data the buffer holding all the slices of the requests and headers
+     * @param requests the array of count requests
+     * @param headers the array of headers, indexed by BatchRequest::firstHeader
+     * @param count the number of requests
+     * @param results the array receiving count results
+     * @return the number of requests with a disruptive intervention
+     */
+    public native int process(@Cast("const unsigned char*") BytePointer data, @Const BatchRequest requests,
+            @Const BatchHeader headers, int count, BatchResult results);
+    public native int process(@Cast("const unsigned char*") ByteBuffer data, @Const BatchRequest requests,
+            @Const BatchHeader headers, int count, BatchResult results);
+    public native int process(@Cast("const unsigned char*") byte[] data, @Const BatchRequest requests,
+            @Const BatchHeader headers, int count, BatchResult results);
+}
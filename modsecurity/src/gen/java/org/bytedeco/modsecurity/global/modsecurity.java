@@ -1054,4 +1054,51 @@ public static final int MODSECURITY_VERSION_NUM = 3080100;
 // #endif  // HEADERS_MODSECURITY_TRANSACTION_H_
 
 
+// Parsed from transaction_batch.h
+
+/*
+ * Evaluation of batches of HTTP requests against a shared RulesSet.
+ *
+ * The requests of a batch are described by arrays of BatchRequest and
+ * BatchHeader, with offsets into a single buffer holding all of their strings
+ * and bodies, and are processed on a pool of threads owned by a
+ * TransactionBatch, each with a Transaction going from processConnection()
+ * to processLogging(). Only a fixed-size BatchResult per request is returned.
+ */
+
+// #ifndef HEADERS_MODSECURITY_TRANSACTION_BATCH_H_
+// #define HEADERS_MODSECURITY_TRANSACTION_BATCH_H_
+
+// #include <atomic>
+// #include <list>
+// #include <string>
+// #include <thread>
+
+// #include "batch_pool.h"
+// #include "modsecurity/intervention.h"
+// #include "modsecurity/modsecurity.h"
+// #include "modsecurity/rule_message.h"
+// #include "modsecurity/rules_set.h"
+// #include "modsecurity/transaction.h"
+// Targeting ../BatchSlice.java
+
+
+// Targeting ../BatchHeader.java
+
+
+// Targeting ../BatchRequest.java
+
+
+// Targeting ../BatchResult.java
+
+
+// Targeting ../TransactionBatch.java
+
+
+
+  // namespace modsecurity
+
+// #endif  // HEADERS_MODSECURITY_TRANSACTION_BATCH_H_
+
+
 }
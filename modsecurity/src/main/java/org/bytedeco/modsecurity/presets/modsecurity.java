@@ -47,8 +47,10 @@ import org.bytedeco.javacpp.tools.InfoMapper;
                         "modsecurity/rules_set_properties.h",
                         "modsecurity/collection/collection.h",
                         "modsecurity/modsecurity.h",
-                        "modsecurity/transaction.h"},
+                        "modsecurity/transaction.h",
+                        "transaction_batch.h"},
                 cinclude = "modsecurity/intervention.h",
+                compiler = "cpp11",
                 linkpath = {"lib","include"},
                 includepath = {"lib","include"},
                 link = "modsecurity@.3"),
@@ -0,0 +1,189 @@
+/*
+ * Evaluation of batches of HTTP requests against a shared RulesSet.
+ *
+ * The requests of a batch are described by arrays of BatchRequest and
+ * BatchHeader, with offsets into a single buffer holding all of their strings
+ * and bodies, and are processed on a pool of threads owned by a
+ * TransactionBatch, each with a Transaction going from processConnection()
+ * to processLogging(). Only a fixed-size BatchResult per request is returned.
+ */
+
+#ifndef HEADERS_MODSECURITY_TRANSACTION_BATCH_H_
+#define HEADERS_MODSECURITY_TRANSACTION_BATCH_H_
+
+#include <atomic>
+#include <list>
+#include <string>
+#include <thread>
+
+#include "batch_pool.h"
+#include "modsecurity/intervention.h"
+#include "modsecurity/modsecurity.h"
+#include "modsecurity/rule_message.h"
+#include "modsecurity/rules_set.h"
+#include "modsecurity/transaction.h"
+
+namespace modsecurity {
+
+/** A slice of the data buffer of a batch. */
+struct BatchSlice {
+    size_t offset;
+    size_t length;
+};
+
+/** A request header, as slices of the data buffer of a batch. */
+struct BatchHeader {
+    BatchSlice key;
+    BatchSlice value;
+};
+
+/** An HTTP request, as slices of the data buffer of a batch. */
+struct BatchRequest {
+    BatchSlice clientIp;
+    int clientPort;
+    BatchSlice serverIp;
+    int serverPort;
+    BatchSlice uri;
+    BatchSlice method;
+    /** The HTTP version, for example "1.1". */
+    BatchSlice httpVersion;
+    /** The index of the first header in the header array of the batch. */
+    size_t firstHeader;
+    size_t headerCount;
+    BatchSlice body;
+};
+
+/** The outcome of a request, from the intervention of its transaction. */
+struct BatchResult {
+    /** The status code of the intervention, or 200 if there is none. */
+    int status;
+    int pause;
+    /** Non-zero if the request must be interrupted. */
+    int disruptive;
+    /** The id of the disruptive rule, or of the last rule that matched, or 0. */
+    int ruleId;
+    /** The phase of that rule. */
+    int phase;
+    /** The number of rules that matched. */
+    int matchedRules;
+    /** 0, or -1 if processing the request failed. */
+    int error;
+};
+
+/**
+ * Processes batches of requests on a pool of threads that all share the same
+ * ModSecurity and RulesSet objects. The calling thread takes part in the work.
+ * process() must not be called again before it returns, so a TransactionBatch
+ * must not be used from more than one thread at a time.
+ */
+class TransactionBatch {
+ public:
+    /**
+     * @param modsec the ModSecurity instance, which must outlive this object
+     * @param rules the rules to evaluate, which must outlive this object
+     * @param threads the number of threads to use, including the calling one,
+     *        or 0 for the number of hardware threads
+     */
+    TransactionBatch(ModSecurity *modsec, RulesSet *rules, int threads)
+        : m_modsec(modsec), m_rules(rules),
+        m_pool(threads > 0 ? threads : (int)std::thread::hardware_concurrency()) { }
+
+    int getThreadCount() { return m_pool.size(); }
+
+    /**
+     * Evaluates a batch of requests and waits for all of them.
+     *
+     * @param data the buffer holding all the slices of the requests and headers
+     * @param requests the array of count requests
+     * @param headers the array of headers, indexed by BatchRequest::firstHeader
+     * @param count the number of requests
+     * @param results the array receiving count results
+     * @return the number of requests with a disruptive intervention
+     */
+    int process(const unsigned char *data, const BatchRequest *requests,
+        const BatchHeader *headers, int count, BatchResult *results) {
+        std::atomic<int> next(0), disruptive(0);
+        m_pool.run([&](int) {
+            int i;
+            while ((i = next++) < count) {
+                processOne(data, requests[i], headers, &results[i]);
+                if (results[i].disruptive) {
+                    disruptive++;
+                }
+            }
+        });
+        return disruptive;
+    }
+
+ private:
+    TransactionBatch(const TransactionBatch &);
+    TransactionBatch &operator=(const TransactionBatch &);
+
+    static std::string str(const unsigned char *data, const BatchSlice &s) {
+        return std::string(reinterpret_cast<const char *>(data) + s.offset, s.length);
+    }
+
+    /* fills the result and returns true if the transaction got interrupted */
+    static bool intervene(Transaction *t, BatchResult *r) {
+        ModSecurityIntervention it;
+        intervention::clean(&it);
+        bool interrupted = t->intervention(&it);
+        r->status = it.status;
+        r->pause = it.pause;
+        r->disruptive = it.disruptive;
+        intervention::free(&it);
+        return interrupted;
+    }
+
+    void processOne(const unsigned char *data, const BatchRequest &q,
+        const BatchHeader *headers, BatchResult *r) {
+        r->status = 200;
+        r->pause = r->disruptive = r->ruleId = r->phase = r->matchedRules = r->error = 0;
+        try {
+            Transaction t(m_modsec, m_rules, NULL);
+            std::string clientIp = str(data, q.clientIp), serverIp = str(data, q.serverIp);
+            std::string uri = str(data, q.uri), method = str(data, q.method), version = str(data, q.httpVersion);
+            t.processConnection(clientIp.c_str(), q.clientPort, serverIp.c_str(), q.serverPort);
+            t.processURI(uri.c_str(), method.c_str(), version.c_str());
+            bool interrupted = intervene(&t, r);
+            if (!interrupted) {
+                for (size_t h = q.firstHeader; h < q.firstHeader + q.headerCount; h++) {
+                    const BatchHeader &header = headers[h];
+                    t.addRequestHeader(data + header.key.offset, header.key.length,
+                        data + header.value.offset, header.value.length);
+                }
+                t.processRequestHeaders();
+                interrupted = intervene(&t, r);
+            }
+            if (!interrupted) {
+                if (q.body.length > 0) {
+                    t.appendRequestBody(data + q.body.offset, q.body.length);
+                }
+                t.processRequestBody();
+                intervene(&t, r);
+            }
+            t.processLogging();
+            r->matchedRules = (int)t.m_rulesMessages.size();
+            for (std::list<RuleMessage>::const_iterator m = t.m_rulesMessages.begin();
+                m != t.m_rulesMessages.end(); ++m) {
+                if (r->ruleId == 0 || m->m_isDisruptive) {
+                    r->ruleId = m->m_ruleId;
+                    r->phase = m->m_phase;
+                }
+                if (m->m_isDisruptive) {
+                    break;
+                }
+            }
+        } catch (...) {
+            r->error = -1;
+        }
+    }
+
+    ModSecurity *m_modsec;
+    RulesSet *m_rules;
+    bytedeco::BatchPool m_pool;
+};
+
+}  // namespace modsecurity
+
+#endif  // HEADERS_MODSECURITY_TRANSACTION_BATCH_H_
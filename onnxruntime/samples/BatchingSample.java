@@ -0,0 +1,72 @@
+import java.util.Random;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.onnxruntime.*;
+import static org.bytedeco.onnxruntime.global.onnxruntime.*;
+
+/**
+ * Scores concurrent single-row requests from many threads, which a
+ * BatchingSession coalesces into batched runs of the model, and prints
+ * the latency and throughput counters.
+ *
+ * The model must take a batch dimension first, for example an MNIST
+ * classifier with an input of shape {-1, 1, 28, 28}.
+ */
+public class BatchingSample {
+    public static void main(String[] args) throws Exception {
+        if (args.length < 1) {
+            System.out.println("Usage: BatchingSample <model.onnx> [threads] [requests per thread] [max batch size] [max delay us]");
+            System.exit(-1);
+        }
+        int threadCount = args.length > 1 ? Integer.parseInt(args[1]) : 64;
+        final int requests = args.length > 2 ? Integer.parseInt(args[2]) : 1000;
+        int maxBatchSize = args.length > 3 ? Integer.parseInt(args[3]) : 32;
+        int maxDelay = args.length > 4 ? Integer.parseInt(args[4]) : 2000;
+
+        Env env = new Env(ORT_LOGGING_LEVEL_WARNING, "batching");
+        SessionOptions options = new SessionOptions();
+        Pointer modelPath = Loader.getPlatform().startsWith("windows") ? new CharPointer(args[0]) : new BytePointer(args[0]);
+        Session session = new Session(env, modelPath, options);
+        final BatchingSession batching = new BatchingSession(session, maxBatchSize, maxDelay);
+
+        final long inputCount = batching.GetInputCount(), outputCount = batching.GetOutputCount();
+        Thread[] threads = new Thread[threadCount];
+        for (int t = 0; t < threadCount; t++) {
+            threads[t] = new Thread() {
+                @Override public void run() {
+                    // buffers of one row for each input and output, reused for every request
+                    PointerPointer inputs = new PointerPointer(inputCount);
+                    PointerPointer outputs = new PointerPointer(outputCount);
+                    BytePointer[] inputRows = new BytePointer[(int)inputCount];
+                    for (int i = 0; i < inputCount; i++) {
+                        inputRows[i] = new BytePointer(batching.GetInputRowSize(i));
+                        inputs.put(i, inputRows[i]);
+                    }
+                    for (int i = 0; i < outputCount; i++) {
+                        outputs.put(i, new BytePointer(batching.GetOutputRowSize(i)));
+                    }
+                    Random random = new Random();
+                    byte[] bytes = new byte[(int)inputRows[0].capacity()];
+                    for (int r = 0; r < requests; r++) {
+                        random.nextBytes(bytes);
+                        inputRows[0].put(bytes);
+                        batching.Run(inputs, outputs);
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        for (Thread thread : threads) {
+            thread.join();
+        }
+
+        BatchingStats stats = batching.GetStats();
+        System.out.printf("%d requests in %d batches (mean size %.1f), %d errors%n",
+                stats.requests(), stats.batches(), stats.mean_batch_size(), stats.errors());
+        System.out.printf("latency p50 %.0f us, p99 %.0f us, max %.0f us, throughput %.0f requests/s%n",
+                stats.p50_latency_us(), stats.p99_latency_us(), stats.max_latency_us(), stats.throughput());
+
+        batching.close();
+        session.close();
+        System.exit(0);
+    }
+}
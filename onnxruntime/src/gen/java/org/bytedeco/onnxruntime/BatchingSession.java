@@ -0,0 +1,55 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.onnxruntime;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+import org.bytedeco.opencl.*;
+import static org.bytedeco.opencl.global.OpenCL.*;
+import org.bytedeco.dnnl.*;
+import static org.bytedeco.dnnl.global.dnnl.*;
+
+import static org.bytedeco.onnxruntime.global.onnxruntime.*;
+
+
+/** Coalesces concurrent single-row requests into batched runs of a Session.
+ *  All methods can be called from any number of threads. */
+@Namespace("Ort") @NoOffset @Properties(inherit = org.bytedeco.onnxruntime.presets.onnxruntime.class)
+public class BatchingSession extends Pointer {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public BatchingSession(Pointer p) { super(p); }
+
+  /** @param session The session to run, which must outlive this object
+   *  @param max_batch_size The maximum number of requests in a batch
+   *  @param max_delay_us How long in microseconds the first request of a batch waits for more
+   *  @param workers The number of batches that can run at the same time */
+  public BatchingSession(@ByRef Session session, @Cast("size_t") long max_batch_size, @Cast("int64_t") long max_delay_us, @Cast("size_t") long workers/*=1*/) { super((Pointer)null); allocate(session, max_batch_size, max_delay_us, workers); }
+  private native void allocate(@ByRef Session session, @Cast("size_t") long max_batch_size, @Cast("int64_t") long max_delay_us, @Cast("size_t") long workers/*=1*/);
+  public BatchingSession(@ByRef Session session, @Cast("size_t") long max_batch_size, @Cast("int64_t") long max_delay_us) { super((Pointer)null); allocate(session, max_batch_size, max_delay_us); }
+  private native void allocate(@ByRef Session session, @Cast("size_t") long max_batch_size, @Cast("int64_t") long max_delay_us);
+
+  /** Waits for the requests already queued and stops the workers. */
+
+  public native @Cast("size_t") long GetInputCount();
+  public native @Cast("size_t") long GetOutputCount();
+
+  /** Returns the size in bytes of one row of the given input. */
+  public native @Cast("size_t") long GetInputRowSize(@Cast("size_t") long index);
+
+  /** Returns the size in bytes of one row of the given output. */
+  public native @Cast("size_t") long GetOutputRowSize(@Cast("size_t") long index);
+
+  /** Runs a request of one row, and waits until its batch has run.
+   *  @param inputs Pointers to one row of each input, GetInputRowSize() bytes each
+   *  @param outputs Pointers receiving one row of each output, GetOutputRowSize() bytes each */
+  public native void Run(@Cast("const void*const*") PointerPointer inputs, @Cast("void*const*") PointerPointer outputs);
+  public native void Run(@Cast("const void*const*") @ByPtrPtr Pointer inputs, @Cast("void*const*") @ByPtrPtr Pointer outputs);
+
+  public native @ByVal BatchingStats GetStats();
+
+  public native void ResetStats();
+}
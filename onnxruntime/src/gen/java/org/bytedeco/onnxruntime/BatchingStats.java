@@ -0,0 +1,55 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.onnxruntime;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+import org.bytedeco.opencl.*;
+import static org.bytedeco.opencl.global.OpenCL.*;
+import org.bytedeco.dnnl.*;
+import static org.bytedeco.dnnl.global.dnnl.*;
+
+import static org.bytedeco.onnxruntime.global.onnxruntime.*;
+
+
+/** Counters of a BatchingSession since its creation or the last call to ResetStats().
+ *  Latencies are measured from the call to Run() until its outputs are ready,
+ *  over the last requests only. */
+@Namespace("Ort") @Properties(inherit = org.bytedeco.onnxruntime.presets.onnxruntime.class)
+public class BatchingStats extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public BatchingStats() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public BatchingStats(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public BatchingStats(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public BatchingStats position(long position) {
+        return (BatchingStats)super.position(position);
+    }
+    @Override public BatchingStats getPointer(long i) {
+        return new BatchingStats((Pointer)this).offsetAddress(i);
+    }
+
+  /** Number of completed requests, including failed ones */
+  public native @Cast("uint64_t") long requests(); public native BatchingStats requests(long setter);
+  /** Number of batches run */
+  public native @Cast("uint64_t") long batches(); public native BatchingStats batches(long setter);
+  /** Number of requests whose batch failed */
+  public native @Cast("uint64_t") long errors(); public native BatchingStats errors(long setter);
+  /** Mean number of requests per batch */
+  public native double mean_batch_size(); public native BatchingStats mean_batch_size(double setter);
+  /** Median latency in microseconds */
+  public native double p50_latency_us(); public native BatchingStats p50_latency_us(double setter);
+  /** 99th percentile of latency in microseconds */
+  public native double p99_latency_us(); public native BatchingStats p99_latency_us(double setter);
+  /** Maximum latency in microseconds */
+  public native double max_latency_us(); public native BatchingStats max_latency_us(double setter);
+  /** Completed requests per second */
+  public native double throughput(); public native BatchingStats throughput(double setter);
+}
@@ -780,4 +780,43 @@ public static native OrtStatus OrtSessionOptionsAppendExecutionProvider_Dnnl( Or
 // #endif
 
 
+// Parsed from onnxruntime_batching.h
+
+// Micro-batching of concurrent single-row requests on top of Ort::Session.
+//
+// Many threads call BatchingSession::Run() with one row of each input. The
+// requests go through a bounded lock-free queue to worker threads that
+// coalesce them into batches of up to max_batch_size rows, waiting at most
+// max_delay_us after the first request of a batch, and run each batch with
+// an Ort::IoBinding over input and output tensors allocated once per worker.
+// The rows of the outputs are then copied back to the requests, whose
+// latencies and counts are reported by GetStats().
+//
+// The first dimension of every input and output of the model must be a
+// dynamic batch dimension, and all other dimensions must be fixed.
+
+// #pragma once
+
+// #include <algorithm>
+// #include <atomic>
+// #include <chrono>
+// #include <condition_variable>
+// #include <cstring>
+// #include <memory>
+// #include <mutex>
+// #include <string>
+// #include <thread>
+// #include <vector>
+
+// #include "onnxruntime/core/session/onnxruntime_cxx_api.h"
+// Targeting ../BatchingStats.java
+
+
+// Targeting ../BatchingSession.java
+
+
+
+  // namespace Ort
+
+
 }
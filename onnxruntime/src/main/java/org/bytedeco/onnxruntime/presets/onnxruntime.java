@@ -60,6 +60,7 @@ import org.bytedeco.dnnl.presets.*;
 //                "onnxruntime/core/providers/coreml/coreml_provider_factory.h",
 //                "onnxruntime/core/providers/rocm/rocm_provider_factory.h",
 //                "onnxruntime/core/providers/dml/dml_provider_factory.h",
+                "onnxruntime_batching.h",
             },
             link = {"onnxruntime_providers_shared", "onnxruntime@.1.13.1"}
         ),
@@ -0,0 +1,449 @@
+// Micro-batching of concurrent single-row requests on top of Ort::Session.
+//
+// Many threads call BatchingSession::Run() with one row of each input. The
+// requests go through a bounded lock-free queue to worker threads that
+// coalesce them into batches of up to max_batch_size rows, waiting at most
+// max_delay_us after the first request of a batch, and run each batch with
+// an Ort::IoBinding over input and output tensors allocated once per worker.
+// The rows of the outputs are then copied back to the requests, whose
+// latencies and counts are reported by GetStats().
+//
+// The first dimension of every input and output of the model must be a
+// dynamic batch dimension, and all other dimensions must be fixed.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "onnxruntime/core/session/onnxruntime_cxx_api.h"
+
+namespace Ort {
+
+/// Counters of a BatchingSession since its creation or the last call to ResetStats().
+/// Latencies are measured from the call to Run() until its outputs are ready,
+/// over the last requests only.
+struct BatchingStats {
+  uint64_t requests;        ///< Number of completed requests, including failed ones
+  uint64_t batches;         ///< Number of batches run
+  uint64_t errors;          ///< Number of requests whose batch failed
+  double mean_batch_size;   ///< Mean number of requests per batch
+  double p50_latency_us;    ///< Median latency in microseconds
+  double p99_latency_us;    ///< 99th percentile of latency in microseconds
+  double max_latency_us;    ///< Maximum latency in microseconds
+  double throughput;        ///< Completed requests per second
+};
+
+/// Coalesces concurrent single-row requests into batched runs of a Session.
+/// All methods can be called from any number of threads.
+struct BatchingSession {
+  /// \param session The session to run, which must outlive this object
+  /// \param max_batch_size The maximum number of requests in a batch
+  /// \param max_delay_us How long in microseconds the first request of a batch waits for more
+  /// \param workers The number of batches that can run at the same time
+  BatchingSession(Session& session, size_t max_batch_size, int64_t max_delay_us, size_t workers = 1)
+      : session_(session),
+        memory_info_(MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault)),
+        max_batch_size_(std::max<size_t>(max_batch_size, 1)),
+        max_delay_(std::chrono::microseconds(std::max<int64_t>(max_delay_us, 0))),
+        stop_(false),
+        sleepers_(0),
+        blocked_(0),
+        enqueue_pos_(0),
+        dequeue_pos_(0),
+        latencies_(kLatencyWindow) {
+    AllocatorWithDefaultOptions allocator;
+    for (size_t i = 0; i < session.GetInputCount(); i++) {
+      AllocatedStringPtr name = session.GetInputNameAllocated(i, allocator);
+      inputs_.push_back(MakeTensorInfo(name.get(), session.GetInputTypeInfo(i)));
+    }
+    for (size_t i = 0; i < session.GetOutputCount(); i++) {
+      AllocatedStringPtr name = session.GetOutputNameAllocated(i, allocator);
+      outputs_.push_back(MakeTensorInfo(name.get(), session.GetOutputTypeInfo(i)));
+    }
+
+    capacity_ = 1024;
+    while (capacity_ < 4 * max_batch_size_ * std::max<size_t>(workers, 1)) {
+      capacity_ *= 2;
+    }
+    cells_.reset(new Cell[capacity_]);
+    for (size_t i = 0; i < capacity_; i++) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ResetStats();
+    for (size_t i = 0; i < std::max<size_t>(workers, 1); i++) {
+      threads_.push_back(std::thread(&BatchingSession::Loop, this));
+    }
+  }
+
+  /// Waits for the requests already queued and stops the workers.
+  ~BatchingSession() {
+    {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (size_t i = 0; i < threads_.size(); i++) {
+      threads_[i].join();
+    }
+  }
+
+  size_t GetInputCount() const { return inputs_.size(); }
+  size_t GetOutputCount() const { return outputs_.size(); }
+
+  /// Returns the size in bytes of one row of the given input.
+  size_t GetInputRowSize(size_t index) const { return inputs_.at(index).row_size; }
+
+  /// Returns the size in bytes of one row of the given output.
+  size_t GetOutputRowSize(size_t index) const { return outputs_.at(index).row_size; }
+
+  /// Runs a request of one row, and waits until its batch has run.
+  /// \param inputs Pointers to one row of each input, GetInputRowSize() bytes each
+  /// \param outputs Pointers receiving one row of each output, GetOutputRowSize() bytes each
+  void Run(const void* const* inputs, void* const* outputs) {
+    Request request;
+    request.inputs = inputs;
+    request.outputs = outputs;
+    request.start = Clock::now();
+    request.done = false;
+    if (!Push(&request)) {
+      // the queue is full, so wait for the workers to pop a batch
+      blocked_++;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      while (!Push(&request)) {
+        wake_.wait(lock);
+      }
+      lock.unlock();
+      blocked_--;
+    }
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers_.load() > 0) {
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      wake_.notify_all();
+    }
+    {
+      std::unique_lock<std::mutex> lock(request.mutex);
+      while (!request.done) {
+        request.finished.wait(lock);
+      }
+    }
+    if (!request.error.empty()) {
+      throw Exception(std::string(request.error), ORT_FAIL);
+    }
+  }
+
+  BatchingStats GetStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    BatchingStats stats = stats_;
+    stats.mean_batch_size = stats.batches > 0 ? (double)stats.requests / stats.batches : 0;
+    double seconds = std::chrono::duration<double>(Clock::now() - stats_start_).count();
+    stats.throughput = seconds > 0 ? stats.requests / seconds : 0;
+    size_t count = stats.requests < kLatencyWindow ? (size_t)stats.requests : kLatencyWindow;
+    if (count > 0) {
+      std::vector<double> window(latencies_.begin(), latencies_.begin() + count);
+      std::nth_element(window.begin(), window.begin() + count / 2, window.end());
+      stats.p50_latency_us = window[count / 2];
+      std::nth_element(window.begin(), window.begin() + count * 99 / 100, window.end());
+      stats.p99_latency_us = window[count * 99 / 100];
+    }
+    return stats;
+  }
+
+  void ResetStats() {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    std::memset(&stats_, 0, sizeof(stats_));
+    stats_start_ = Clock::now();
+  }
+
+ private:
+  typedef std::chrono::steady_clock Clock;
+
+  // the number of latencies kept to compute percentiles
+  static const size_t kLatencyWindow = 8192;
+
+  struct TensorInfo {
+    std::string name;
+    ONNXTensorElementDataType type;
+    std::vector<int64_t> shape;
+    size_t row_size;
+  };
+
+  struct Request {
+    const void* const* inputs;
+    void* const* outputs;
+    Clock::time_point start;
+    std::string error;
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done;
+  };
+
+  struct Cell {
+    std::atomic<size_t> sequence;
+    Request* request;
+  };
+
+  // tensors of a worker for a given batch size, over the buffers of the worker
+  struct Binding {
+    explicit Binding(Session& session) : binding(session) {}
+    IoBinding binding;
+    std::vector<Value> values;
+  };
+
+  struct Worker {
+    std::vector<std::vector<uint64_t> > inputs, outputs;
+    std::vector<std::unique_ptr<Binding> > bindings;
+  };
+
+  BatchingSession(const BatchingSession&);
+  BatchingSession& operator=(const BatchingSession&);
+
+  static size_t ElementSize(ONNXTensorElementDataType type) {
+    switch (type) {
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8: return 1;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16: return 2;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT: return 4;
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE: return 8;
+      default: return 0;
+    }
+  }
+
+  static TensorInfo MakeTensorInfo(const char* name, const TypeInfo& type_info) {
+    auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+    TensorInfo info;
+    info.name = name;
+    info.type = tensor_info.GetElementType();
+    info.shape = tensor_info.GetShape();
+    info.row_size = ElementSize(info.type);
+    if (info.row_size == 0) {
+      throw Exception("Cannot batch " + info.name + ": unsupported element type", ORT_INVALID_ARGUMENT);
+    }
+    if (info.shape.empty() || info.shape[0] >= 0) {
+      throw Exception("Cannot batch " + info.name + ": first dimension is not a dynamic batch dimension", ORT_INVALID_ARGUMENT);
+    }
+    for (size_t i = 1; i < info.shape.size(); i++) {
+      if (info.shape[i] <= 0) {
+        throw Exception("Cannot batch " + info.name + ": dimension " + std::to_string(i) + " is not fixed", ORT_INVALID_ARGUMENT);
+      }
+      info.row_size *= (size_t)info.shape[i];
+    }
+    return info;
+  }
+
+  // bounded multi-producer multi-consumer queue, after Dmitry Vyukov's
+  bool Push(Request* request) {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells_[pos & (capacity_ - 1)];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.request = request;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool Pop(Request** request) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = cells_[pos & (capacity_ - 1)];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          *request = cell.request;
+          cell.sequence.store(pos + capacity_, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // pops a request, waiting for one until the deadline, if any, or until stopped with an empty queue
+  bool WaitPop(Request** request, const Clock::time_point* deadline) {
+    for (;;) {
+      if (Pop(request)) {
+        return true;
+      }
+      sleepers_++;
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      bool popped = Pop(request);
+      bool timeout = false;
+      if (!popped && !stop_) {
+        if (deadline != NULL) {
+          timeout = wake_.wait_until(lock, *deadline) == std::cv_status::timeout;
+        } else {
+          wake_.wait(lock);
+        }
+      }
+      bool stop = stop_;
+      lock.unlock();
+      sleepers_--;
+      if (popped) {
+        return true;
+      } else if (timeout || stop) {
+        return Pop(request);
+      }
+    }
+  }
+
+  void Loop() {
+    Worker worker;
+    for (size_t i = 0; i < inputs_.size(); i++) {
+      worker.inputs.push_back(std::vector<uint64_t>((max_batch_size_ * inputs_[i].row_size + 7) / 8));
+    }
+    for (size_t i = 0; i < outputs_.size(); i++) {
+      worker.outputs.push_back(std::vector<uint64_t>((max_batch_size_ * outputs_[i].row_size + 7) / 8));
+    }
+    worker.bindings.resize(max_batch_size_);
+
+    std::vector<Request*> batch(max_batch_size_);
+    while (WaitPop(&batch[0], NULL)) {
+      size_t size = 1;
+      Clock::time_point deadline = batch[0]->start + max_delay_;
+      while (size < max_batch_size_) {
+        if (Pop(&batch[size])) {
+          size++;
+        } else if (Clock::now() >= deadline || !WaitPop(&batch[size], &deadline)) {
+          break;
+        } else {
+          size++;
+        }
+      }
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (blocked_.load() > 0) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_.notify_all();
+      }
+      RunBatch(worker, batch.data(), size);
+    }
+  }
+
+  Binding& GetBinding(Worker& worker, size_t size) {
+    std::unique_ptr<Binding>& binding = worker.bindings[size - 1];
+    if (!binding) {
+      binding.reset(new Binding(session_));
+      binding->values.reserve(inputs_.size() + outputs_.size());
+      for (size_t i = 0; i < inputs_.size() + outputs_.size(); i++) {
+        bool input = i < inputs_.size();
+        const TensorInfo& info = input ? inputs_[i] : outputs_[i - inputs_.size()];
+        std::vector<uint64_t>& buffer = input ? worker.inputs[i] : worker.outputs[i - inputs_.size()];
+        std::vector<int64_t> shape = info.shape;
+        shape[0] = (int64_t)size;
+        binding->values.push_back(Value::CreateTensor(memory_info_, buffer.data(), size * info.row_size,
+                                                      shape.data(), shape.size(), info.type));
+        if (input) {
+          binding->binding.BindInput(info.name.c_str(), binding->values.back());
+        } else {
+          binding->binding.BindOutput(info.name.c_str(), binding->values.back());
+        }
+      }
+    }
+    return *binding;
+  }
+
+  void RunBatch(Worker& worker, Request** batch, size_t size) {
+    std::string error;
+    try {
+      for (size_t i = 0; i < inputs_.size(); i++) {
+        char* buffer = (char*)worker.inputs[i].data();
+        for (size_t j = 0; j < size; j++) {
+          std::memcpy(buffer + j * inputs_[i].row_size, batch[j]->inputs[i], inputs_[i].row_size);
+        }
+      }
+      session_.Run(run_options_, GetBinding(worker, size).binding);
+      for (size_t i = 0; i < outputs_.size(); i++) {
+        const char* buffer = (const char*)worker.outputs[i].data();
+        for (size_t j = 0; j < size; j++) {
+          std::memcpy(batch[j]->outputs[i], buffer + j * outputs_[i].row_size, outputs_[i].row_size);
+        }
+      }
+    } catch (const std::exception& e) {
+      error = e.what();
+      if (error.empty()) {
+        error = "Batch failed";
+      }
+    }
+
+    Clock::time_point end = Clock::now();
+    {
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      for (size_t j = 0; j < size; j++) {
+        double latency = std::chrono::duration<double, std::micro>(end - batch[j]->start).count();
+        latencies_[stats_.requests % kLatencyWindow] = latency;
+        stats_.max_latency_us = std::max(stats_.max_latency_us, latency);
+        stats_.requests++;
+      }
+      stats_.batches++;
+      if (!error.empty()) {
+        stats_.errors += size;
+      }
+    }
+    for (size_t j = 0; j < size; j++) {
+      Request* request = batch[j];
+      std::lock_guard<std::mutex> lock(request->mutex);
+      request->error = error;
+      request->done = true;
+      request->finished.notify_one();
+    }
+  }
+
+  Session& session_;
+  MemoryInfo memory_info_;
+  RunOptions run_options_;
+  std::vector<TensorInfo> inputs_, outputs_;
+  size_t max_batch_size_;
+  Clock::duration max_delay_;
+
+  std::vector<std::thread> threads_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  bool stop_;
+  std::atomic<int> sleepers_;
+  std::atomic<int> blocked_;
+
+  std::unique_ptr<Cell[]> cells_;
+  size_t capacity_;
+  // keeps producers and consumers on separate cache lines
+  alignas(64) std::atomic<size_t> enqueue_pos_;
+  alignas(64) std::atomic<size_t> dequeue_pos_;
+
+  alignas(64) mutable std::mutex stats_mutex_;
+  BatchingStats stats_;
+  Clock::time_point stats_start_;
+  std::vector<double> latencies_;
+};
+
+}  // namespace Ort
@@ -0,0 +1,72 @@
+import java.util.ArrayList;
+import java.util.List;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.openblas.*;
+
+import static org.bytedeco.openblas.global.openblas_nolapack.*;
+
+/**
+ * Measures the throughput of many threads multiplying matrices at once, first
+ * with the full thread pool of the BLAS library for each of them, and then
+ * within compute regions sharing the cores. To try with MKL instead of OpenBLAS,
+ * run with -Dorg.bytedeco.openblas.load=mkl.
+ *
+ * Usage: ComputeRegionBenchmark [threads] [size] [iterations]
+ */
+public class ComputeRegionBenchmark {
+    static double run(final int threads, final int n, final int iterations, final boolean regions) throws InterruptedException {
+        List<Thread> list = new ArrayList<Thread>();
+        for (int t = 0; t < threads; t++) {
+            list.add(new Thread() {
+                @Override public void run() {
+                    try (DoublePointer a = new DoublePointer((long)n * n).zero();
+                         DoublePointer b = new DoublePointer((long)n * n).zero();
+                         DoublePointer c = new DoublePointer((long)n * n)) {
+                        for (int i = 0; i < iterations; i++) {
+                            if (regions) {
+                                try (ComputeRegion region = new ComputeRegion()) {
+                                    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1.0, a, n, b, n, 0.0, c, n);
+                                }
+                            } else {
+                                cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, n, n, n, 1.0, a, n, b, n, 0.0, c, n);
+                            }
+                        }
+                    }
+                }
+            });
+        }
+        long start = System.nanoTime();
+        for (Thread t : list) {
+            t.start();
+        }
+        for (Thread t : list) {
+            t.join();
+        }
+        double seconds = (System.nanoTime() - start) / 1e9;
+        return 2.0 * n * n * n * iterations * threads / seconds / 1e9;
+    }
+
+    public static void main(String[] args) throws InterruptedException {
+        int threads = args.length > 0 ? Integer.parseInt(args[0]) : Runtime.getRuntime().availableProcessors();
+        int n = args.length > 1 ? Integer.parseInt(args[1]) : 512;
+        int iterations = args.length > 2 ? Integer.parseInt(args[2]) : 50;
+        Loader.load(openblas_nolapack.class);
+
+        // warm up the thread pools
+        run(1, n, 2, false);
+        double uncoordinated = run(threads, n, iterations, false);
+
+        int libraries = compute_budget_set(0, threads);
+        System.out.println("Libraries found:"
+                + ((libraries & COMPUTE_BUDGET_OPENBLAS) != 0 ? " OpenBLAS" : "")
+                + ((libraries & COMPUTE_BUDGET_MKL) != 0 ? " MKL" : "")
+                + ((libraries & COMPUTE_BUDGET_OPENMP) != 0 ? " OpenMP" : ""));
+        double coordinated = run(threads, n, iterations, true);
+
+        System.out.printf("%d threads multiplying %dx%d matrices with a budget of %d cores%n",
+                threads, n, n, compute_budget_cores());
+        System.out.printf("Without compute regions: %8.2f GFLOPS%n", uncoordinated);
+        System.out.printf("With compute regions:    %8.2f GFLOPS (%.2fx)%n", coordinated, coordinated / uncoordinated);
+        System.exit(0);
+    }
+}
@@ -0,0 +1,26 @@
+// Targeted by JavaCPP version 1.5.8: DO NOT EDIT THIS FILE
+
+package org.bytedeco.openblas;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+
+import static org.bytedeco.openblas.global.openblas_nolapack.*;
+
+
+@NoOffset @Properties(inherit = org.bytedeco.openblas.presets.openblas_nolapack.class)
+public class ComputeRegion extends Pointer {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public ComputeRegion(Pointer p) { super(p); }
+
+    public ComputeRegion(int max_cores/*=0*/) { super((Pointer)null); allocate(max_cores); }
+    private native void allocate(int max_cores/*=0*/);
+    public ComputeRegion() { super((Pointer)null); allocate(); }
+    private native void allocate();
+
+    public native int cores();
+}
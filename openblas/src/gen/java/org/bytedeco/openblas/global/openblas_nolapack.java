@@ -725,4 +725,105 @@ public static native void cblas_zher2k(@Cast("const CBLAS_ORDER") int Order, @Ca
 // #endif
 
 
+// Parsed from compute_budget.h
+
+/*
+ * Compute regions sharing one budget of cores among the thread pools of
+ * OpenBLAS, MKL, OpenMP, oneDNN, and OpenCV loaded in the same process
+ *
+ * Each of these libraries sizes its thread pool for the whole machine, so
+ * application threads calling them concurrently oversubscribe the cores many
+ * times over. Instead, a thread wraps its calls in a compute region, which
+ * takes a number of cores from a global budget and hands them to the libraries
+ * through their threading API for the calling thread only, when they have one:
+ *
+ *   - MKL with mkl_set_num_threads_local(),
+ *   - OpenBLAS with openblas_set_num_threads_local(), when available,
+ *   - OpenMP, and so oneDNN and OpenBLAS built with it, with omp_set_num_threads(),
+ *   - oneDNN built with a threadpool with dnnl_threadpool_interop_set_max_concurrency().
+ *
+ * The cores are given back, and the previous settings restored, at the end of
+ * the region. Libraries with only a global setting, OpenBLAS with its own
+ * threads and OpenCV with cv::setNumThreads(), get instead a fixed partition
+ * of the budget when it is set with compute_budget_set().
+ *
+ * The functions of these libraries are looked up among the ones loaded in the
+ * process, so none of them is needed to link. compute_budget_set() looks them
+ * up again, to find libraries loaded afterwards.
+ */
+
+// #ifndef COMPUTE_BUDGET_H
+// #define COMPUTE_BUDGET_H
+
+// #include <mutex>
+// #include <thread>
+// #ifdef _WIN32
+// #include <windows.h>
+// #include <tlhelp32.h>
+// #else
+// #include <dlfcn.h>
+// #if defined(__APPLE__)
+// #include <mach-o/dyld.h>
+// #elif !defined(__ANDROID__) || __ANDROID_API__ >= 21
+// #include <link.h>
+// #endif
+// #endif
+
+/* Libraries found, returned by compute_budget_libraries() */
+public static final int COMPUTE_BUDGET_OPENBLAS = (1 << 0);
+public static final int COMPUTE_BUDGET_MKL =      (1 << 1);
+public static final int COMPUTE_BUDGET_OPENMP =   (1 << 2);
+public static final int COMPUTE_BUDGET_DNNL =     (1 << 3);
+public static final int COMPUTE_BUDGET_OPENCV =   (1 << 4);
+
+/*
+ * Sets the budget to the given number of cores, or to the number of hardware
+ * threads when 0, to share among as many regions as concurrency expected to
+ * run at once. The libraries with only a global setting get cores / concurrency
+ * threads, so this should be called before they start computing. Regions
+ * already running keep their cores. Returns the libraries found, a combination
+ * of COMPUTE_BUDGET_OPENBLAS, COMPUTE_BUDGET_MKL, etc.
+ */
+public static native int compute_budget_set(int cores, int concurrency/*=1*/);
+public static native int compute_budget_set(int cores);
+
+/* Returns the number of cores of the budget */
+public static native int compute_budget_cores();
+
+/* Returns the number of cores not taken by any region */
+public static native int compute_budget_available();
+
+/* Returns the libraries found, a combination of COMPUTE_BUDGET_OPENBLAS, COMPUTE_BUDGET_MKL, etc. */
+public static native int compute_budget_libraries();
+
+/*
+ * Begins a compute region on the calling thread, which takes a fair share of
+ * the budget: all of it when alone, down to 1 core, the calling thread itself,
+ * when the budget is exhausted, but never more than max_cores, unless 0.
+ * Regions can be nested, in which case the inner ones keep the cores of the
+ * outermost one. Returns the number of cores taken.
+ */
+public static native int compute_region_begin(int max_cores/*=0*/);
+public static native int compute_region_begin();
+
+/* Ends the compute region of the calling thread, restoring the previous settings when outermost */
+public static native void compute_region_end();
+
+/* Returns the number of cores of the compute region of the calling thread, or 0 outside of any */
+public static native int compute_region_cores();
+
+/*
+ * A compute region over the lifetime of the object, which must be destroyed
+ * on the thread that created it, for example, in Java:
+ *
+ *   try (ComputeRegion region = new ComputeRegion()) {
+ *       cblas_dgemm(...);
+ *   }
+ */
+// Targeting ../ComputeRegion.java
+
+
+// #endif /* COMPUTE_BUDGET_H */
+
+
 }
@@ -35,7 +35,7 @@ import org.bytedeco.javacpp.annotation.Properties;
  */
 @Properties(inherit = openblas_nolapack.class, global = "org.bytedeco.openblas.global.openblas", value = {
     @Platform(
-        include = {"openblas_config.h", "cblas.h", "lapacke_config.h", "lapacke_mangling.h", "lapack.h", "lapacke.h", "lapacke_utils.h"})})
+        include = {"openblas_config.h", "cblas.h", "lapacke_config.h", "lapacke_mangling.h", "lapack.h", "lapacke.h", "lapacke_utils.h", "compute_budget.h"})})
 @NoException
 public class openblas extends openblas_nolapack {
 
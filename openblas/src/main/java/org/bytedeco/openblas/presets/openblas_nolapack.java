@@ -42,7 +42,7 @@ import org.bytedeco.javacpp.tools.InfoMapper;
  */
 @Properties(inherit = javacpp.class, global = "org.bytedeco.openblas.global.openblas_nolapack", value = {
     @Platform(define = {"__OPENBLAS 1", "LAPACK_COMPLEX_CPP"},
-              include = {"openblas_config.h", "cblas.h"},
+              include = {"openblas_config.h", "cblas.h", "compute_budget.h"}, compiler = "cpp11",
               link    =  "openblas_nolapack@.0", resource = {"include", "lib"},
               preload = {"gcc_s@.1", "quadmath@.0", "gfortran@.5", "gfortran@.4", "gfortran@.3", "openblas@.0#openblas_nolapack@.0"},
               preloadpath = {"/opt/intel/oneapi/mkl/latest/lib/", "/opt/intel/oneapi/compiler/latest/mac/compiler/lib/"}),
@@ -118,6 +118,7 @@ public class openblas_nolapack implements LoadEnabled, InfoMapper {
 
     @Override public void map(InfoMap infoMap) {
         infoMap.put(new Info("lapack.h", "lapacke.h").linePatterns(".*LAPACK_GLOBAL.*").skip())
+               .put(new Info("compute_budget.h").linePatterns("^#ifndef COMPUTE_BUDGET_PRIVATE_H$", "^#endif /\\* COMPUTE_BUDGET_PRIVATE_H \\*/$").skip())
                .put(new Info("OPENBLAS_PTHREAD_CREATE_FUNC", "OPENBLAS_BUNDERSCORE", "OPENBLAS_FUNDERSCORE", "DOUBLE_DEFINED", "xdouble",
                              "FLOATRET", "OPENBLAS_CONST", "CBLAS_INDEX", "lapack_int", "lapack_logical").cppTypes().annotations())
                .put(new Info("OPENBLAS_QUAD_PRECISION", "defined OPENBLAS_EXPRECISION", "OPENBLAS_USE64BITINT",
@@ -0,0 +1,355 @@
+/*
+ * Compute regions sharing one budget of cores among the thread pools of
+ * OpenBLAS, MKL, OpenMP, oneDNN, and OpenCV loaded in the same process
+ *
+ * Each of these libraries sizes its thread pool for the whole machine, so
+ * application threads calling them concurrently oversubscribe the cores many
+ * times over. Instead, a thread wraps its calls in a compute region, which
+ * takes a number of cores from a global budget and hands them to the libraries
+ * through their threading API for the calling thread only, when they have one:
+ *
+ *   - MKL with mkl_set_num_threads_local(),
+ *   - OpenBLAS with openblas_set_num_threads_local(), when available,
+ *   - OpenMP, and so oneDNN and OpenBLAS built with it, with omp_set_num_threads(),
+ *   - oneDNN built with a threadpool with dnnl_threadpool_interop_set_max_concurrency().
+ *
+ * The cores are given back, and the previous settings restored, at the end of
+ * the region. Libraries with only a global setting, OpenBLAS with its own
+ * threads and OpenCV with cv::setNumThreads(), get instead a fixed partition
+ * of the budget when it is set with compute_budget_set().
+ *
+ * The functions of these libraries are looked up among the ones loaded in the
+ * process, so none of them is needed to link. compute_budget_set() looks them
+ * up again, to find libraries loaded afterwards.
+ */
+
+#ifndef COMPUTE_BUDGET_H
+#define COMPUTE_BUDGET_H
+
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <windows.h>
+#include <tlhelp32.h>
+#else
+#include <dlfcn.h>
+#if defined(__APPLE__)
+#include <mach-o/dyld.h>
+#elif !defined(__ANDROID__) || __ANDROID_API__ >= 21
+#include <link.h>
+#endif
+#endif
+
+/* Libraries found, returned by compute_budget_libraries() */
+#define COMPUTE_BUDGET_OPENBLAS (1 << 0)
+#define COMPUTE_BUDGET_MKL      (1 << 1)
+#define COMPUTE_BUDGET_OPENMP   (1 << 2)
+#define COMPUTE_BUDGET_DNNL     (1 << 3)
+#define COMPUTE_BUDGET_OPENCV   (1 << 4)
+
+#ifndef COMPUTE_BUDGET_PRIVATE_H
+#define COMPUTE_BUDGET_PRIVATE_H
+
+struct compute_budget {
+    std::mutex mutex;
+    int cores;          // size of the budget
+    int concurrency;    // number of regions expected to run at once
+    int used;           // cores taken by the regions running
+    int active;         // number of regions running
+    int libraries;
+
+    /* settings of the calling thread, returning the previous value when not void */
+    int (*mkl_set_num_threads_local)(int);
+    int (*openblas_set_num_threads_local)(int);
+    int (*omp_get_max_threads)();
+    void (*omp_set_num_threads)(int);
+    int (*dnnl_get_max_concurrency)(int *);
+    int (*dnnl_set_max_concurrency)(int);
+
+    /* global settings */
+    void (*openblas_set_num_threads)(int);
+    void (*opencv_set_num_threads)(int);
+
+    compute_budget() : cores(0), concurrency(1), used(0), active(0), libraries(0),
+            mkl_set_num_threads_local(NULL), openblas_set_num_threads_local(NULL),
+            omp_get_max_threads(NULL), omp_set_num_threads(NULL),
+            dnnl_get_max_concurrency(NULL), dnnl_set_max_concurrency(NULL),
+            openblas_set_num_threads(NULL), opencv_set_num_threads(NULL) {
+        cores = (int)std::thread::hardware_concurrency();
+        if (cores <= 0) {
+            cores = 1;
+        }
+        resolve();
+    }
+
+    static compute_budget &instance() {
+        static compute_budget budget;
+        return budget;
+    }
+
+    /* Returns the address of a function exported by any module loaded in the process */
+    static void *lookup(const char *name) {
+#ifdef _WIN32
+        void *address = NULL;
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE, GetCurrentProcessId());
+        if (snapshot != INVALID_HANDLE_VALUE) {
+            MODULEENTRY32 module;
+            module.dwSize = sizeof(module);
+            for (BOOL more = Module32First(snapshot, &module); more && address == NULL; more = Module32Next(snapshot, &module)) {
+                address = (void *)GetProcAddress(module.hModule, name);
+            }
+            CloseHandle(snapshot);
+        }
+        return address;
+#else
+        void *address = dlsym(RTLD_DEFAULT, name);
+        if (address != NULL) {
+            return address;
+        }
+        /* libraries loaded with RTLD_LOCAL, as by System.load(), need their own handle */
+#if defined(__APPLE__)
+        for (uint32_t i = 0; i < _dyld_image_count() && address == NULL; i++) {
+            void *handle = dlopen(_dyld_get_image_name(i), RTLD_LAZY | RTLD_NOLOAD);
+            if (handle != NULL) {
+                address = dlsym(handle, name);
+                dlclose(handle);
+            }
+        }
+#elif !defined(__ANDROID__) || __ANDROID_API__ >= 21
+        /* the loader lock is held during dl_iterate_phdr(), so no dlopen() in the callback */
+        struct search {
+            static int callback(struct dl_phdr_info *info, size_t, void *data) {
+                if (info->dlpi_name != NULL && info->dlpi_name[0] != '\0') {
+                    ((std::vector<std::string> *)data)->push_back(info->dlpi_name);
+                }
+                return 0;
+            }
+        };
+        std::vector<std::string> names;
+        dl_iterate_phdr(&search::callback, &names);
+        for (size_t i = 0; i < names.size() && address == NULL; i++) {
+            void *handle = dlopen(names[i].c_str(), RTLD_LAZY | RTLD_NOLOAD);
+            if (handle != NULL) {
+                address = dlsym(handle, name);
+                dlclose(handle);
+            }
+        }
+#endif
+        return address;
+#endif
+    }
+
+    template<class F> static bool find(F &f, const char *name, const char *name2 = NULL) {
+        void *address = lookup(name);
+        if (address == NULL && name2 != NULL) {
+            address = lookup(name2);
+        }
+        f = (F)address;
+        return address != NULL;
+    }
+
+    /* Called with the mutex locked, or from the constructor */
+    void resolve() {
+        libraries = 0;
+        if (find(mkl_set_num_threads_local, "mkl_set_num_threads_local", "MKL_Set_Num_Threads_Local")) {
+            libraries |= COMPUTE_BUDGET_MKL;
+        }
+        if (find(openblas_set_num_threads_local, "openblas_set_num_threads_local")
+                | find(openblas_set_num_threads, "openblas_set_num_threads")) {
+            libraries |= COMPUTE_BUDGET_OPENBLAS;
+        }
+        if (find(omp_get_max_threads, "omp_get_max_threads") & find(omp_set_num_threads, "omp_set_num_threads")) {
+            libraries |= COMPUTE_BUDGET_OPENMP;
+        } else {
+            omp_get_max_threads = NULL;
+            omp_set_num_threads = NULL;
+        }
+        if (find(dnnl_get_max_concurrency, "dnnl_threadpool_interop_get_max_concurrency")
+                & find(dnnl_set_max_concurrency, "dnnl_threadpool_interop_set_max_concurrency")) {
+            libraries |= COMPUTE_BUDGET_DNNL;
+        } else {
+            dnnl_get_max_concurrency = NULL;
+            dnnl_set_max_concurrency = NULL;
+        }
+#ifdef _MSC_VER
+        if (find(opencv_set_num_threads, "?setNumThreads@cv@@YAXH@Z")) {
+#else
+        if (find(opencv_set_num_threads, "_ZN2cv13setNumThreadsEi")) {
+#endif
+            libraries |= COMPUTE_BUDGET_OPENCV;
+        }
+    }
+};
+
+/* State of the compute region of the calling thread */
+struct compute_region_state {
+    int depth;
+    int cores;
+    int mkl_threads;
+    int openblas_threads;
+    int omp_threads;
+    int dnnl_concurrency;
+};
+
+inline compute_region_state &compute_region_current() {
+    static thread_local compute_region_state state = { 0, 0, 0, 0, 0, 0 };
+    return state;
+}
+
+#endif /* COMPUTE_BUDGET_PRIVATE_H */
+
+/*
+ * Sets the budget to the given number of cores, or to the number of hardware
+ * threads when 0, to share among as many regions as concurrency expected to
+ * run at once. The libraries with only a global setting get cores / concurrency
+ * threads, so this should be called before they start computing. Regions
+ * already running keep their cores. Returns the libraries found, a combination
+ * of COMPUTE_BUDGET_OPENBLAS, COMPUTE_BUDGET_MKL, etc.
+ */
+inline int compute_budget_set(int cores, int concurrency = 1) {
+    compute_budget &b = compute_budget::instance();
+    std::lock_guard<std::mutex> lock(b.mutex);
+    if (cores <= 0) {
+        cores = (int)std::thread::hardware_concurrency();
+    }
+    b.cores = cores > 0 ? cores : 1;
+    b.concurrency = concurrency > 0 ? concurrency : 1;
+    b.resolve();
+
+    int share = b.cores / b.concurrency > 0 ? b.cores / b.concurrency : 1;
+    if (b.openblas_set_num_threads != NULL && b.openblas_set_num_threads_local == NULL) {
+        b.openblas_set_num_threads(share);
+    }
+    if (b.opencv_set_num_threads != NULL) {
+        b.opencv_set_num_threads(share);
+    }
+    return b.libraries;
+}
+
+/* Returns the number of cores of the budget */
+inline int compute_budget_cores() {
+    compute_budget &b = compute_budget::instance();
+    std::lock_guard<std::mutex> lock(b.mutex);
+    return b.cores;
+}
+
+/* Returns the number of cores not taken by any region */
+inline int compute_budget_available() {
+    compute_budget &b = compute_budget::instance();
+    std::lock_guard<std::mutex> lock(b.mutex);
+    return b.used < b.cores ? b.cores - b.used : 0;
+}
+
+/* Returns the libraries found, a combination of COMPUTE_BUDGET_OPENBLAS, COMPUTE_BUDGET_MKL, etc. */
+inline int compute_budget_libraries() {
+    compute_budget &b = compute_budget::instance();
+    std::lock_guard<std::mutex> lock(b.mutex);
+    return b.libraries;
+}
+
+/*
+ * Begins a compute region on the calling thread, which takes a fair share of
+ * the budget: all of it when alone, down to 1 core, the calling thread itself,
+ * when the budget is exhausted, but never more than max_cores, unless 0.
+ * Regions can be nested, in which case the inner ones keep the cores of the
+ * outermost one. Returns the number of cores taken.
+ */
+inline int compute_region_begin(int max_cores = 0) {
+    compute_region_state &r = compute_region_current();
+    if (r.depth++ > 0) {
+        return r.cores;
+    }
+    compute_budget &b = compute_budget::instance();
+    {
+        std::lock_guard<std::mutex> lock(b.mutex);
+        int cores = b.cores / (b.active + 1);
+        if (cores > b.cores - b.used) {
+            cores = b.cores - b.used;
+        }
+        if (max_cores > 0 && cores > max_cores) {
+            cores = max_cores;
+        }
+        if (cores < 1) {
+            cores = 1;
+        }
+        b.used += cores;
+        b.active++;
+        r.cores = cores;
+    }
+
+    /* the pointers only change in compute_budget_set(), which should not run concurrently */
+    if (b.mkl_set_num_threads_local != NULL) {
+        r.mkl_threads = b.mkl_set_num_threads_local(r.cores);
+    }
+    if (b.openblas_set_num_threads_local != NULL) {
+        r.openblas_threads = b.openblas_set_num_threads_local(r.cores);
+    }
+    if (b.omp_set_num_threads != NULL) {
+        r.omp_threads = b.omp_get_max_threads();
+        b.omp_set_num_threads(r.cores);
+    }
+    if (b.dnnl_set_max_concurrency != NULL) {
+        r.dnnl_concurrency = 0;
+        if (b.dnnl_get_max_concurrency(&r.dnnl_concurrency) != 0 || r.dnnl_concurrency <= 0) {
+            r.dnnl_concurrency = (int)std::thread::hardware_concurrency();
+        }
+        b.dnnl_set_max_concurrency(r.cores);
+    }
+    return r.cores;
+}
+
+/* Ends the compute region of the calling thread, restoring the previous settings when outermost */
+inline void compute_region_end() {
+    compute_region_state &r = compute_region_current();
+    if (r.depth <= 0 || --r.depth > 0) {
+        return;
+    }
+    compute_budget &b = compute_budget::instance();
+    if (b.mkl_set_num_threads_local != NULL) {
+        b.mkl_set_num_threads_local(r.mkl_threads);
+    }
+    if (b.openblas_set_num_threads_local != NULL) {
+        b.openblas_set_num_threads_local(r.openblas_threads);
+    }
+    if (b.omp_set_num_threads != NULL) {
+        b.omp_set_num_threads(r.omp_threads);
+    }
+    if (b.dnnl_set_max_concurrency != NULL) {
+        b.dnnl_set_max_concurrency(r.dnnl_concurrency);
+    }
+    std::lock_guard<std::mutex> lock(b.mutex);
+    b.used -= r.cores;
+    b.active--;
+    r.cores = 0;
+}
+
+/* Returns the number of cores of the compute region of the calling thread, or 0 outside of any */
+inline int compute_region_cores() {
+    return compute_region_current().cores;
+}
+
+/*
+ * A compute region over the lifetime of the object, which must be destroyed
+ * on the thread that created it, for example, in Java:
+ *
+ *   try (ComputeRegion region = new ComputeRegion()) {
+ *       cblas_dgemm(...);
+ *   }
+ */
+class ComputeRegion {
+public:
+    ComputeRegion(int max_cores = 0) : cores_(compute_region_begin(max_cores)) { }
+    ~ComputeRegion() { compute_region_end(); }
+
+    int cores() const { return cores_; }
+
+private:
+    int cores_;
+
+    ComputeRegion(const ComputeRegion &);
+    ComputeRegion &operator=(const ComputeRegion &);
+};
+
+#endif /* COMPUTE_BUDGET_H */
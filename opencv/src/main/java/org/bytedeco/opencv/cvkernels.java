@@ -100,4 +100,7 @@ public class cvkernels {
 
     public static native void multiWarpColorTransform32F(KernelData data, int size, CvRect roi, CvScalar fillColor);
     public static native void multiWarpColorTransform8U(KernelData data, int size, CvRect roi, CvScalar fillColor);
+
+    /** Returns "baseline", "avx2", or "avx512", the variant of the kernels selected for the host. */
+    public static native String multiWarpColorTransformTarget();
 }
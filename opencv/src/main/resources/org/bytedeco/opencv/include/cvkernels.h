@@ -42,18 +42,91 @@ struct KernelData {
     double    srcDstDot, *dstDstDot;
 };
 
+// The kernels get compiled for the baseline of the compiler flags, and also for
+// AVX2 and AVX-512 with GCC and Clang on x86, with the targets of
+// dispatch_targets.h shared with cpu_features_dispatch.h, to be selected at
+// runtime with cv::checkHardwareSupport(), which also honors OPENCV_CPU_DISABLE.
+#include "dispatch_targets.h"
+#if defined(BYTEDECO_DISPATCH_HAVE_AVX2) && defined(BYTEDECO_DISPATCH_HAVE_AVX512)
+#define CVKERNELS_HAVE_AVX 1
+#endif
+
 #define PTYPE float
-#define multiWarpColorTransform multiWarpColorTransform32F
+#define multiWarpColorTransform multiWarpColorTransform32F_baseline
+#include "cvkernels.h"
+#undef multiWarpColorTransform
+#ifdef CVKERNELS_HAVE_AVX
+BYTEDECO_DISPATCH_BEGIN_AVX2
+#define multiWarpColorTransform multiWarpColorTransform32F_avx2
+#include "cvkernels.h"
+#undef multiWarpColorTransform
+BYTEDECO_DISPATCH_END
+BYTEDECO_DISPATCH_BEGIN_AVX512
+#define multiWarpColorTransform multiWarpColorTransform32F_avx512
 #include "cvkernels.h"
 #undef multiWarpColorTransform
+BYTEDECO_DISPATCH_END
+#endif
 #undef PTYPE
 
 #define PTYPE unsigned char
-#define multiWarpColorTransform multiWarpColorTransform8U
+#define multiWarpColorTransform multiWarpColorTransform8U_baseline
 #include "cvkernels.h"
 #undef multiWarpColorTransform
+#ifdef CVKERNELS_HAVE_AVX
+BYTEDECO_DISPATCH_BEGIN_AVX2
+#define multiWarpColorTransform multiWarpColorTransform8U_avx2
+#include "cvkernels.h"
+#undef multiWarpColorTransform
+BYTEDECO_DISPATCH_END
+BYTEDECO_DISPATCH_BEGIN_AVX512
+#define multiWarpColorTransform multiWarpColorTransform8U_avx512
+#include "cvkernels.h"
+#undef multiWarpColorTransform
+BYTEDECO_DISPATCH_END
+#endif
 #undef PTYPE
 
+enum { CVKERNELS_BASELINE, CVKERNELS_AVX2, CVKERNELS_AVX512 };
+
+static inline int cvkernelsTarget() {
+    static const int target =
+#ifdef CVKERNELS_HAVE_AVX
+        cv::checkHardwareSupport(CV_CPU_AVX2) && cv::checkHardwareSupport(CV_CPU_FMA3) &&
+        cv::checkHardwareSupport(CV_CPU_AVX_512F) && cv::checkHardwareSupport(CV_CPU_AVX_512CD) &&
+        cv::checkHardwareSupport(CV_CPU_AVX_512BW) && cv::checkHardwareSupport(CV_CPU_AVX_512DQ) &&
+        cv::checkHardwareSupport(CV_CPU_AVX_512VL) ? CVKERNELS_AVX512 :
+        cv::checkHardwareSupport(CV_CPU_AVX2) && cv::checkHardwareSupport(CV_CPU_FMA3) ? CVKERNELS_AVX2 :
+#endif
+        CVKERNELS_BASELINE;
+    return target;
+}
+
+// Returns "baseline", "avx2", or "avx512", the variant of the kernels in use
+static inline const char* multiWarpColorTransformTarget() {
+    static const char* names[] = { "baseline", "avx2", "avx512" };
+    return names[cvkernelsTarget()];
+}
+
+typedef void (*multiWarpColorTransformFunction)(KernelData data[], int size, CvRect* roi, CvScalar* fillColor);
+
+#ifdef CVKERNELS_HAVE_AVX
+#define CVKERNELS_SELECT(name) (cvkernelsTarget() == CVKERNELS_AVX512 ? name##_avx512 : \
+                                cvkernelsTarget() == CVKERNELS_AVX2   ? name##_avx2   : name##_baseline)
+#else
+#define CVKERNELS_SELECT(name) name##_baseline
+#endif
+
+static inline void multiWarpColorTransform32F(KernelData data[], int size, CvRect* roi, CvScalar* fillColor) {
+    static const multiWarpColorTransformFunction f = CVKERNELS_SELECT(multiWarpColorTransform32F);
+    f(data, size, roi, fillColor);
+}
+
+static inline void multiWarpColorTransform8U(KernelData data[], int size, CvRect* roi, CvScalar* fillColor) {
+    static const multiWarpColorTransformFunction f = CVKERNELS_SELECT(multiWarpColorTransform8U);
+    f(data, size, roi, fillColor);
+}
+
 #elif defined PTYPE //__JAVACV_CVKERNELS_H__
 
 // transImg  = warp(srcImg, H1) * (X*warp(srcImg2, H2))
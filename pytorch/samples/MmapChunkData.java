@@ -0,0 +1,82 @@
+import java.io.File;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.pytorch.*;
+import static org.bytedeco.pytorch.global.torch.*;
+
+/**
+ * Feeds a ChunkDataset from binary shards of fixed-size records with a native
+ * MmapChunkReader: its tensors point straight into the mapped files, and the
+ * preloader threads of the dataset fault in the pages in the background, without
+ * calling back Java for the chunks.
+ *
+ * Usage: MmapChunkData [directory] [shards] [records per shard]
+ */
+public class MmapChunkData {
+    static final long[] DATA_SHAPE = {28, 28};
+
+    /** Writes records of 28x28 floats followed by an int64 label, all equal to the index of the record. */
+    static void writeShard(File file, int first, int records) throws Exception {
+        int dataSize = 28 * 28 * 4, recordSize = dataSize + 8;
+        ByteBuffer buffer = ByteBuffer.allocateDirect(recordSize * records).order(ByteOrder.nativeOrder());
+        for (int r = 0; r < records; r++) {
+            for (int i = 0; i < dataSize; i += 4) {
+                buffer.putFloat(first + r);
+            }
+            buffer.putLong(first + r);
+        }
+        buffer.flip();
+        try (RandomAccessFile raf = new RandomAccessFile(file, "rw"); FileChannel channel = raf.getChannel()) {
+            raf.setLength(0);
+            while (buffer.hasRemaining()) {
+                channel.write(buffer);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        File directory = new File(args.length > 0 ? args[0] : System.getProperty("java.io.tmpdir"));
+        int shards = args.length > 1 ? Integer.parseInt(args[1]) : 4;
+        int records = args.length > 2 ? Integer.parseInt(args[2]) : 1000;
+
+        try (PointerScope scope = new PointerScope()) {
+            StringVector files = new StringVector();
+            for (int s = 0; s < shards; s++) {
+                File file = new File(directory, "shard" + s + ".bin");
+                writeShard(file, s * records, records);
+                files.push_back(file.getAbsolutePath());
+            }
+
+            long batch_size = 64;
+            long prefetch_count = 2;
+            MmapChunkReader data_reader = new MmapChunkReader(files, DATA_SHAPE, ScalarType.Float,
+                                                              new long[0], ScalarType.Long, 256);
+            RandomSampler sampler = new RandomSampler(0);
+            MmapChunkMapDataset data_set = new MmapChunkSharedBatchDataset(
+                    new MmapChunkDataset(data_reader, sampler, sampler,
+                            new ChunkDatasetOptions(prefetch_count, batch_size))).map(new ExampleStack());
+            MmapChunkRandomDataLoader data_loader = new MmapChunkRandomDataLoader(
+                    data_set, new DataLoaderOptions(batch_size));
+
+            System.out.println(data_reader.chunk_count() + " chunks of records of " + data_reader.record_size() + " bytes");
+            for (int epoch = 1; epoch <= 3; ++epoch) {
+                long start = System.nanoTime();
+                long count = 0, mismatches = 0;
+                for (ExampleIterator it = data_loader.begin(); !it.equals(data_loader.end()); it = it.increment()) {
+                    Example batch = it.access();
+                    // the data of each record must match its label
+                    Tensor labels = batch.target().to(ScalarType.Float);
+                    Tensor means = batch.data().mean(new long[] {1, 2});
+                    mismatches += means.ne(labels).sum().item_long();
+                    count += batch.target().size(0);
+                }
+                double seconds = (System.nanoTime() - start) / 1e9;
+                System.out.printf("Epoch %d: %d records in %.3f s (%.0f records/s), %d mismatches%n",
+                        epoch, count, seconds, count / seconds, mismatches);
+            }
+        }
+    }
+}
@@ -0,0 +1,41 @@
+// Targeted by JavaCPP version 1.5.9-SNAPSHOT: DO NOT EDIT THIS FILE
+
+package org.bytedeco.pytorch;
+
+import org.bytedeco.pytorch.Allocator;
+import org.bytedeco.pytorch.Function;
+import org.bytedeco.pytorch.Module;
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+import static org.bytedeco.openblas.global.openblas_nolapack.*;
+import static org.bytedeco.openblas.global.openblas.*;
+
+import static org.bytedeco.pytorch.global.torch.*;
+
+
+/** A dataloader for stateful datasets.
+ * 
+ *  A dataloader for stateful datatasets differs from one for stateless
+ *  datasets one in that the dataset is shared among worker threads, and that
+ *  this dataset is itself responsible for producing batches rather than
+ *  depending on a sampler. The statefulness here actually refers to the
+ *  dataset. The StatefulDataLoader simply alters the data loading algorithm to
+ *  accommodate the stateful, shared nature of the dataset. Note that the
+ *  dataset must be thread safe if more than one worker thread is used.
+ * 
+ *  A stateful dataloader is created by calling {@code make_data_loader} with a
+ *  stateful dataset. */
+@Name("torch::data::StatefulDataLoader<torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<torch::data::datasets::MmapChunkReader,torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > > >") @Properties(inherit = org.bytedeco.pytorch.presets.torch.class)
+public class MmapChunkRandomDataLoader extends MmapChunkRandomDataLoaderBase {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public MmapChunkRandomDataLoader(Pointer p) { super(p); }
+
+
+  /** Constructs the {@code StatefulDataLoader} from a {@code dataset} and some {@code options}. */
+  public MmapChunkRandomDataLoader(@ByVal MmapChunkMapDataset dataset, @ByVal DataLoaderOptions options) { super((Pointer)null); allocate(dataset, options); }
+  private native void allocate(@ByVal MmapChunkMapDataset dataset, @ByVal DataLoaderOptions options);
+}
@@ -0,0 +1,93 @@
+// Targeted by JavaCPP version 1.5.9-SNAPSHOT: DO NOT EDIT THIS FILE
+
+package org.bytedeco.pytorch;
+
+import org.bytedeco.pytorch.Allocator;
+import org.bytedeco.pytorch.Function;
+import org.bytedeco.pytorch.Module;
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+import static org.bytedeco.openblas.global.openblas_nolapack.*;
+import static org.bytedeco.openblas.global.openblas.*;
+
+import static org.bytedeco.pytorch.global.torch.*;
+
+
+@Namespace("torch::data::datasets") @NoOffset @Properties(inherit = org.bytedeco.pytorch.presets.torch.class)
+public class MmapChunkReader extends ChunkDataReader {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public MmapChunkReader(Pointer p) { super(p); }
+
+  /** Maps the files, which must all contain a whole number of records. */
+  public MmapChunkReader(
+      @Const @ByRef StringVector files,
+      @ByVal @Cast("c10::ArrayRef<int64_t>*") LongArrayRef data_shape,
+      ScalarType data_type,
+      @ByVal @Cast("c10::ArrayRef<int64_t>*") LongArrayRef target_shape,
+      ScalarType target_type,
+      @Cast("int64_t") long records_per_chunk/*=0*/) { super((Pointer)null); allocate(files, data_shape, data_type, target_shape, target_type, records_per_chunk); }
+  private native void allocate(
+      @Const @ByRef StringVector files,
+      @ByVal @Cast("c10::ArrayRef<int64_t>*") LongArrayRef data_shape,
+      ScalarType data_type,
+      @ByVal @Cast("c10::ArrayRef<int64_t>*") LongArrayRef target_shape,
+      ScalarType target_type,
+      @Cast("int64_t") long records_per_chunk/*=0*/);
+  public MmapChunkReader(
+      @Const @ByRef StringVector files,
+      @ByVal @Cast("c10::ArrayRef<int64_t>*") LongArrayRef data_shape,
+      ScalarType data_type,
+      @ByVal @Cast("c10::ArrayRef<int64_t>*") LongArrayRef target_shape,
+      ScalarType target_type) { super((Pointer)null); allocate(files, data_shape, data_type, target_shape, target_type); }
+  private native void allocate(
+      @Const @ByRef StringVector files,
+      @ByVal @Cast("c10::ArrayRef<int64_t>*") LongArrayRef data_shape,
+      ScalarType data_type,
+      @ByVal @Cast("c10::ArrayRef<int64_t>*") LongArrayRef target_shape,
+      ScalarType target_type);
+  public MmapChunkReader(
+      @Const @ByRef StringVector files,
+      @ByVal @Cast({"int64_t*", "c10::ArrayRef<int64_t>", "std::vector<int64_t>&"}) @StdVector long[] data_shape,
+      ScalarType data_type,
+      @ByVal @Cast({"int64_t*", "c10::ArrayRef<int64_t>", "std::vector<int64_t>&"}) @StdVector long[] target_shape,
+      ScalarType target_type,
+      @Cast("int64_t") long records_per_chunk/*=0*/) { super((Pointer)null); allocate(files, data_shape, data_type, target_shape, target_type, records_per_chunk); }
+  private native void allocate(
+      @Const @ByRef StringVector files,
+      @ByVal @Cast({"int64_t*", "c10::ArrayRef<int64_t>", "std::vector<int64_t>&"}) @StdVector long[] data_shape,
+      ScalarType data_type,
+      @ByVal @Cast({"int64_t*", "c10::ArrayRef<int64_t>", "std::vector<int64_t>&"}) @StdVector long[] target_shape,
+      ScalarType target_type,
+      @Cast("int64_t") long records_per_chunk/*=0*/);
+  public MmapChunkReader(
+      @Const @ByRef StringVector files,
+      @ByVal @Cast({"int64_t*", "c10::ArrayRef<int64_t>", "std::vector<int64_t>&"}) @StdVector long[] data_shape,
+      ScalarType data_type,
+      @ByVal @Cast({"int64_t*", "c10::ArrayRef<int64_t>", "std::vector<int64_t>&"}) @StdVector long[] target_shape,
+      ScalarType target_type) { super((Pointer)null); allocate(files, data_shape, data_type, target_shape, target_type); }
+  private native void allocate(
+      @Const @ByRef StringVector files,
+      @ByVal @Cast({"int64_t*", "c10::ArrayRef<int64_t>", "std::vector<int64_t>&"}) @StdVector long[] data_shape,
+      ScalarType data_type,
+      @ByVal @Cast({"int64_t*", "c10::ArrayRef<int64_t>", "std::vector<int64_t>&"}) @StdVector long[] target_shape,
+      ScalarType target_type);
+
+  /** Returns the examples of the chunk, over the mapped pages of its shard. */
+  public native @ByVal @Cast("torch::data::datasets::MmapChunkReader::ChunkType*") ExampleVector read_chunk(@Cast("size_t") long chunk_index);
+
+  /** Returns the number of chunks of all the shards. */
+  public native @Cast("size_t") long chunk_count();
+
+  /** Does nothing, as the reader has no state. */
+  public native void reset();
+
+  /** Returns the number of records of the chunk. */
+  public native @Cast("int64_t") long record_count(@Cast("size_t") long chunk_index);
+
+  /** Returns the size of a record in bytes. */
+  public native @Cast("int64_t") long record_size();
+}
@@ -74987,6 +74987,9 @@ public static final long kSourceRangeTagIndex = kSourceRangeTagIndex();
 // Targeting ../ChunkRandomDataLoaderBase.java
 
 
+// Targeting ../MmapChunkRandomDataLoaderBase.java
+
+
 // Targeting ../MNISTRandomDataLoaderBase.java
 
 
@@ -75026,6 +75029,9 @@ public static final long kSourceRangeTagIndex = kSourceRangeTagIndex();
 // Targeting ../ChunkRandomDataLoader.java
 
 
+// Targeting ../MmapChunkRandomDataLoader.java
+
+
  // namespace data
  // namespace torch
 
@@ -75086,12 +75092,21 @@ public static final long kSourceRangeTagIndex = kSourceRangeTagIndex();
 // Targeting ../ChunkBatchDataset.java
 
 
+// Targeting ../MmapChunkBatchDataset.java
+
+
 // Targeting ../ChunkBatchSharedBatchDataset.java
 
 
+// Targeting ../MmapChunkBatchSharedBatchDataset.java
+
+
 // Targeting ../ChunkMapBatchDataset.java
 
 
+// Targeting ../MmapChunkMapBatchDataset.java
+
+
 // Targeting ../MNISTBatchDataset.java
 
 
@@ -75144,6 +75159,9 @@ public static final long kSourceRangeTagIndex = kSourceRangeTagIndex();
 // Targeting ../ChunkDataset.java
 
 
+// Targeting ../MmapChunkDataset.java
+
+
  // namespace datasets
  // namespace data
  // namespace torch
@@ -75165,6 +75183,9 @@ public static final long kSourceRangeTagIndex = kSourceRangeTagIndex();
 // Targeting ../ChunkMapDataset.java
 
 
+// Targeting ../MmapChunkMapDataset.java
+
+
 // Targeting ../MNISTMapDataset.java
 
 
@@ -75207,6 +75228,9 @@ public static final long kSourceRangeTagIndex = kSourceRangeTagIndex();
 // Targeting ../ChunkSharedBatchDataset.java
 
 
+// Targeting ../MmapChunkSharedBatchDataset.java
+
+
 
 /** Constructs a new {@code SharedBatchDataset} by creating a
  *  {@code shared_ptr<UnderlyingDatase>}. All arguments are forwarded to
@@ -75230,6 +75254,9 @@ public static final long kSourceRangeTagIndex = kSourceRangeTagIndex();
 // Targeting ../ChunkStatefulDataset.java
 
 
+// Targeting ../MmapChunkStatefulDataset.java
+
+
 
 /** Serializes a statefulDataset to {@code OutputArchive}. */
 
@@ -75254,6 +75281,62 @@ public static final long kSourceRangeTagIndex = kSourceRangeTagIndex();
 
 
 
+ // namespace datasets
+ // namespace data
+ // namespace torch
+
+
+// Parsed from mmap_chunk_reader.h
+
+// Memory-mapped chunk reader of fixed-size records
+//
+// The records are stored back to back in binary shard files, each record made
+// of the bytes of its data tensor followed by the ones of its target tensor,
+// with the given shapes and types, in native byte order. A chunk groups
+// records_per_chunk consecutive records of a shard, or all of them when 0.
+// Tensors are only as aligned as their offset in the records, so padding may
+// be needed for types whose kernels require it.
+//
+// read_chunk() returns examples with tensors created with torch::from_blob()
+// straight over the mapped pages, without copy. The pages are mapped copy on
+// write, so the tensors can be modified in place without changing the files,
+// and they keep the mapping alive. Before returning, it also faults in all the
+// pages of the chunk, so that when called by the preloader threads of
+// ChunkDataset, the disk gets read in the background instead of at the first
+// access from the training loop.
+//
+// MmapChunkReader is a ChunkDataReader, and ChunkDataset copies it by value
+// as its ChunkReader, with copies sharing the same mappings. The presets map
+// ChunkDataset<MmapChunkReader> along with its batch dataset and data loader,
+// so that from Java as well, the chunks get read without calling back Java.
+
+// #pragma once
+
+// #include <torch/data/datasets/chunk.h>
+// #include <torch/data/example.h>
+// #include <torch/types.h>
+
+// #include <algorithm>
+// #include <cstddef>
+// #include <memory>
+// #include <string>
+// #include <vector>
+
+// #ifdef _WIN32
+// #ifndef NOMINMAX
+// #define NOMINMAX
+// #endif
+// #include <windows.h>
+// #else
+// #include <fcntl.h>
+// #include <sys/mman.h>
+// #include <sys/stat.h>
+// #include <unistd.h>
+// #endif
+// Targeting ../MmapChunkReader.java
+
+
+
  // namespace datasets
  // namespace data
  // namespace torch
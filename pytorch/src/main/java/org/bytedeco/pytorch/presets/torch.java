@@ -1609,6 +1609,7 @@ import org.bytedeco.openblas.presets.openblas;
                 "torch/data/datasets/shared.h",
                 "torch/data/datasets/stateful.h",
                 "torch/data/datasets/tensor.h",
+                "mmap_chunk_reader.h",
                 "torch/data/samplers.h",
                 "torch/data/samplers/base.h",
                 "torch/data/samplers/custom_batch_request.h",
@@ -2535,12 +2536,16 @@ public class torch implements LoadEnabled, InfoMapper {
                .put(new Info("torch::jit::Wrap<torch::jit::Value>").pointerTypes("ValueWrap"));
 
         String VirtualChunkDataReader = "JavaCPP_torch_0003a_0003adata_0003a_0003adatasets_0003a_0003aChunkDataReader_0003ctorch_0003a_0003adata_0003a_0003aExample_0003c_0003e_0002cstd_0003a_0003avector_0003ctorch_0003a_0003adata_0003a_0003aExample_0003c_0003e_00020_0003e_00020_0003e";
+        String MmapChunkReader = "torch::data::datasets::MmapChunkReader";
 
         infoMap.put(new Info("std::vector<torch::data::Example<> >", // "UnwrappedBatchType",
-                             "std::vector<torch::data::datasets::Dataset<torch::data::datasets::MNIST,torch::data::Example<> >::ExampleType>").pointerTypes("ExampleVector").define())
+                             "std::vector<torch::data::datasets::Dataset<torch::data::datasets::MNIST,torch::data::Example<> >::ExampleType>",
+                             MmapChunkReader + "::ChunkType").pointerTypes("ExampleVector").define())
                .put(new Info("std::vector<torch::data::Example<torch::Tensor,torch::data::example::NoTarget> >").pointerTypes("TensorExampleVector").define())
                .put(new Info("c10::optional<std::vector<torch::data::Example<> > >", "c10::optional<" + VirtualChunkDataReader + "::BatchType>",
-                             "torch::data::datasets::ChunkDataset<" + VirtualChunkDataReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>::BatchType")
+                             "torch::data::datasets::ChunkDataset<" + VirtualChunkDataReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>::BatchType",
+                             "c10::optional<" + MmapChunkReader + "::BatchType>",
+                             "torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>::BatchType")
                        .pointerTypes("ExampleVectorOptional").define())
 
                .put(new Info("torch::data::Example<torch::Tensor,torch::Tensor>", "torch::data::Example<>").pointerTypes("Example"))
@@ -2565,7 +2570,8 @@ public class torch implements LoadEnabled, InfoMapper {
                              "torch::data::transforms::Collation<torch::data::Example<> >").pointerTypes("ExampleCollation"))
                .put(new Info("torch::data::transforms::Stack<torch::data::Example<> >").pointerTypes("ExampleStack"))
 
-               .put(new Info("torch::data::datasets::ChunkDataReader<torch::data::Example<>,std::vector<torch::data::Example<> > >", VirtualChunkDataReader).pointerTypes("ChunkDataReader").virtualize())
+               .put(new Info("torch::data::datasets::ChunkDataReader<torch::data::Example<>,std::vector<torch::data::Example<> > >",
+                             "torch::data::datasets::ChunkDataReader<torch::data::Example<> >", VirtualChunkDataReader).pointerTypes("ChunkDataReader").virtualize())
                .put(new Info("torch::data::datasets::ChunkDataset<" + VirtualChunkDataReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>").pointerTypes("ChunkDataset"))
                .put(new Info("torch::data::datasets::ChunkDataset<" + VirtualChunkDataReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>::ChunkDataset").javaText(
                        "public ChunkDataset(\n"
@@ -2620,6 +2626,54 @@ public class torch implements LoadEnabled, InfoMapper {
                .put(new Info("torch::data::StatefulDataLoader<torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + VirtualChunkDataReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > > >")
                        .pointerTypes("ChunkRandomDataLoader"))
 
+               .put(new Info("torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>").pointerTypes("MmapChunkDataset"))
+               .put(new Info("torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>::ChunkDataset").javaText(
+                       "public MmapChunkDataset(\n"
+                     + "      MmapChunkReader chunk_reader,\n"
+                     + "      RandomSampler chunk_sampler,\n"
+                     + "      RandomSampler example_sampler,\n"
+                     + "      ChunkDatasetOptions options) { super((Pointer)null); allocate(chunk_reader, chunk_sampler, example_sampler, options, null); }\n"
+                     + "public MmapChunkDataset(\n"
+                     + "      MmapChunkReader chunk_reader,\n"
+                     + "      RandomSampler chunk_sampler,\n"
+                     + "      RandomSampler example_sampler,\n"
+                     + "      ChunkDatasetOptions options,\n"
+                     + "      Pointer preprocessing_policy) { super((Pointer)null); allocate(chunk_reader, chunk_sampler, example_sampler, options, preprocessing_policy); }\n"
+                     + "private native void allocate(\n"
+                     + "      @ByVal MmapChunkReader chunk_reader,\n"
+                     + "      @ByVal RandomSampler chunk_sampler,\n"
+                     + "      @ByVal RandomSampler example_sampler,\n"
+                     + "      @ByVal ChunkDatasetOptions options,\n"
+                     + "      @ByVal(nullValue = \"std::function<void(std::vector<torch::data::Example<>>&)>()\") @Cast(\"std::function<void(std::vector<torch::data::Example<>>&)>*\") Pointer preprocessing_policy);\n"))
+               .put(new Info("torch::data::datasets::StatefulDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>," + MmapChunkReader + "::BatchType,size_t>")
+                       .pointerTypes("MmapChunkStatefulDataset"))
+               .put(new Info("torch::data::datasets::BatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>,c10::optional<" + MmapChunkReader + "::BatchType>,size_t>",
+                             "torch::data::datasets::BatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>,std::vector<torch::data::Example<> > >")
+                       .pointerTypes("MmapChunkBatchDataset"))
+               .put(new Info("torch::data::datasets::BatchDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,c10::optional<" + MmapChunkReader + "::BatchType>,size_t>",
+                             "torch::data::datasets::BatchDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>::BatchType,torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler>::BatchRequestType>")
+                       .pointerTypes("MmapChunkBatchSharedBatchDataset"))
+               .put(new Info("torch::data::datasets::BatchDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,c10::optional<" + MmapChunkReader + "::BatchType>,size_t>::map")
+                       .javaText("public native @ByVal MmapChunkMapDataset map(@ByVal ExampleStack transform);"))
+               .put(new Info("torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >")
+                       .pointerTypes("MmapChunkSharedBatchDataset"))
+               .put(new Info("torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >")
+                       .pointerTypes("MmapChunkMapDataset"))
+               .put(new Info("torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >::reset")
+                       .skip())
+               .put(new Info("torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >::DatasetType")
+                       .pointerTypes("MmapChunkSharedBatchDataset"))
+               .put(new Info("torch::data::datasets::BatchDataset<torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >,std::vector<torch::data::Example<> >,at::ArrayRef<size_t> >",
+                             "torch::data::datasets::BatchDataset<torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >,torch::data::datasets::detail::optional_if_t<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >::is_stateful,torch::data::transforms::Stack<torch::data::Example<> >::OutputBatchType>,torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >::BatchRequestType>")
+                       .pointerTypes("MmapChunkMapBatchDataset"))
+               .put(new Info("torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >::get_batch")
+                       .javaText("public native @Name(\"get_batch\") @ByVal ExampleOptional get_batch_example(@Cast(\"size_t\") long indices);"))
+               .put(new Info("torch::data::DataLoaderBase<torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >,torch::data::Example<>,size_t>",
+                             "torch::data::DataLoaderBase<torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >,torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >::BatchType::value_type,torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > >::BatchRequestType>")
+                       .purify().pointerTypes("MmapChunkRandomDataLoaderBase"))
+               .put(new Info("torch::data::StatefulDataLoader<torch::data::datasets::MapDataset<torch::data::datasets::SharedBatchDataset<torch::data::datasets::ChunkDataset<" + MmapChunkReader + ",torch::data::samplers::RandomSampler,torch::data::samplers::RandomSampler> >,torch::data::transforms::Stack<torch::data::Example<> > > >")
+                       .pointerTypes("MmapChunkRandomDataLoader"))
+
                .put(new Info("torch::data::DataLoaderBase<torch::data::datasets::MapDataset<torch::data::datasets::MNIST,torch::data::transforms::Stack<torch::data::Example<> > >,torch::data::Example<>,std::vector<size_t> >",
                              "torch::data::DataLoaderBase<torch::data::datasets::MapDataset<torch::data::datasets::MNIST,torch::data::transforms::Stack<torch::data::Example<> > >,torch::data::datasets::MapDataset<torch::data::datasets::MNIST,torch::data::transforms::Stack<torch::data::Example<> > >::BatchType,torch::data::samplers::RandomSampler::BatchRequestType>")
                        .purify().pointerTypes("MNISTRandomDataLoaderBase"))
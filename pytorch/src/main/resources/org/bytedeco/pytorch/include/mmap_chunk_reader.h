@@ -0,0 +1,226 @@
+// Memory-mapped chunk reader of fixed-size records
+//
+// The records are stored back to back in binary shard files, each record made
+// of the bytes of its data tensor followed by the ones of its target tensor,
+// with the given shapes and types, in native byte order. A chunk groups
+// records_per_chunk consecutive records of a shard, or all of them when 0.
+// Tensors are only as aligned as their offset in the records, so padding may
+// be needed for types whose kernels require it.
+//
+// read_chunk() returns examples with tensors created with torch::from_blob()
+// straight over the mapped pages, without copy. The pages are mapped copy on
+// write, so the tensors can be modified in place without changing the files,
+// and they keep the mapping alive. Before returning, it also faults in all the
+// pages of the chunk, so that when called by the preloader threads of
+// ChunkDataset, the disk gets read in the background instead of at the first
+// access from the training loop.
+//
+// MmapChunkReader is a ChunkDataReader, and ChunkDataset copies it by value
+// as its ChunkReader, with copies sharing the same mappings. The presets map
+// ChunkDataset<MmapChunkReader> along with its batch dataset and data loader,
+// so that from Java as well, the chunks get read without calling back Java.
+
+#pragma once
+
+#include <torch/data/datasets/chunk.h>
+#include <torch/data/example.h>
+#include <torch/types.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace torch {
+namespace data {
+namespace datasets {
+
+class MmapChunkReader : public ChunkDataReader<Example<>> {
+ public:
+  /// Maps the files, which must all contain a whole number of records.
+  MmapChunkReader(
+      const std::vector<std::string>& files,
+      at::IntArrayRef data_shape,
+      at::ScalarType data_type,
+      at::IntArrayRef target_shape,
+      at::ScalarType target_type,
+      int64_t records_per_chunk = 0)
+      : data_shape_(data_shape.vec()),
+        target_shape_(target_shape.vec()),
+        data_options_(at::TensorOptions().dtype(data_type)),
+        target_options_(at::TensorOptions().dtype(target_type)),
+        data_size_(c10::multiply_integers(data_shape) * c10::elementSize(data_type)),
+        record_size_(data_size_ + c10::multiply_integers(target_shape) * c10::elementSize(target_type)) {
+    TORCH_CHECK(records_per_chunk >= 0, "records_per_chunk must not be negative");
+    TORCH_CHECK(record_size_ > 0, "Records must not be empty");
+    for (const auto& file : files) {
+      auto shard = std::make_shared<Shard>(file);
+      TORCH_CHECK(shard->size % record_size_ == 0, "Size of file ", file, " (", shard->size,
+                  " bytes) is not a multiple of the size of a record (", record_size_, " bytes)");
+      int64_t records = shard->size / record_size_;
+      int64_t count = records_per_chunk > 0 ? records_per_chunk : records;
+      for (int64_t first = 0; first < records; first += count) {
+        chunks_.push_back({shards_.size(), first, std::min(count, records - first)});
+      }
+      shards_.push_back(std::move(shard));
+    }
+  }
+
+  /// Returns the examples of the chunk, over the mapped pages of its shard.
+  ChunkType read_chunk(size_t chunk_index) override {
+    TORCH_CHECK(chunk_index < chunks_.size(), "Chunk index ", chunk_index,
+                " out of range for ", chunks_.size(), " chunks");
+    const Chunk& chunk = chunks_[chunk_index];
+    std::shared_ptr<Shard> shard = shards_[chunk.shard];
+    char* begin = shard->data + chunk.first * record_size_;
+    shard->prefault(begin, chunk.count * record_size_);
+
+    // every tensor holds a reference to the mapping of its shard
+    auto deleter = [shard](void*) {};
+    ChunkType examples;
+    examples.reserve(chunk.count);
+    for (int64_t i = 0; i < chunk.count; i++) {
+      char* record = begin + i * record_size_;
+      examples.emplace_back(
+          torch::from_blob(record, data_shape_, deleter, data_options_),
+          torch::from_blob(record + data_size_, target_shape_, deleter, target_options_));
+    }
+    return examples;
+  }
+
+  /// Returns the number of chunks of all the shards.
+  size_t chunk_count() override {
+    return chunks_.size();
+  }
+
+  /// Does nothing, as the reader has no state.
+  void reset() override {}
+
+  /// Returns the number of records of the chunk.
+  int64_t record_count(size_t chunk_index) const {
+    return chunks_.at(chunk_index).count;
+  }
+
+  /// Returns the size of a record in bytes.
+  int64_t record_size() const {
+    return record_size_;
+  }
+
+ private:
+  struct Shard {
+    char* data = nullptr;
+    int64_t size = 0;
+#ifdef _WIN32
+    HANDLE mapping = NULL;
+#endif
+
+    Shard(const Shard&) = delete;
+    Shard& operator=(const Shard&) = delete;
+
+    explicit Shard(const std::string& file) {
+#ifdef _WIN32
+      HANDLE handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+      TORCH_CHECK(handle != INVALID_HANDLE_VALUE, "Could not open ", file);
+      LARGE_INTEGER length;
+      if (!GetFileSizeEx(handle, &length)) {
+        CloseHandle(handle);
+        TORCH_CHECK(false, "Could not get the size of ", file);
+      }
+      size = length.QuadPart;
+      if (size > 0) {
+        mapping = CreateFileMappingA(handle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+        data = mapping != NULL ? (char*)MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : nullptr;
+      }
+      CloseHandle(handle);
+      if (size > 0 && data == nullptr) {
+        if (mapping != NULL) {
+          CloseHandle(mapping);
+        }
+        TORCH_CHECK(false, "Could not map ", file);
+      }
+#else
+      int fd = open(file.c_str(), O_RDONLY);
+      TORCH_CHECK(fd >= 0, "Could not open ", file);
+      struct stat st;
+      if (fstat(fd, &st) != 0) {
+        close(fd);
+        TORCH_CHECK(false, "Could not get the size of ", file);
+      }
+      size = st.st_size;
+      if (size > 0) {
+        void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        data = p != MAP_FAILED ? (char*)p : nullptr;
+      }
+      close(fd);
+      TORCH_CHECK(size == 0 || data != nullptr, "Could not map ", file);
+#endif
+    }
+
+    ~Shard() {
+#ifdef _WIN32
+      if (data != nullptr) {
+        UnmapViewOfFile(data);
+      }
+      if (mapping != NULL) {
+        CloseHandle(mapping);
+      }
+#else
+      if (data != nullptr) {
+        munmap(data, size);
+      }
+#endif
+    }
+
+    // reads all the pages of the range from the disk, if not already in memory
+    void prefault(char* begin, int64_t length) {
+#ifdef _WIN32
+      const int64_t page = 4096;
+#else
+      const int64_t page = sysconf(_SC_PAGESIZE);
+      char* aligned = data + (begin - data) / page * page;
+      madvise(aligned, length + (begin - aligned), MADV_WILLNEED);
+#endif
+      volatile char sink = 0;
+      for (int64_t i = 0; i < length; i += page) {
+        sink += begin[i];
+      }
+      if (length > 0) {
+        sink += begin[length - 1];
+      }
+      (void)sink;
+    }
+  };
+
+  struct Chunk {
+    size_t shard;
+    int64_t first;
+    int64_t count;
+  };
+
+  std::vector<int64_t> data_shape_;
+  std::vector<int64_t> target_shape_;
+  at::TensorOptions data_options_;
+  at::TensorOptions target_options_;
+  int64_t data_size_;
+  int64_t record_size_;
+  std::vector<std::shared_ptr<Shard>> shards_;
+  std::vector<Chunk> chunks_;
+};
+
+} // namespace datasets
+} // namespace data
+} // namespace torch
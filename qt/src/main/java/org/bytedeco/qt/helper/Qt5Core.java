@@ -23,8 +23,16 @@
 package org.bytedeco.qt.helper;
 
 import java.io.File;
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+import org.bytedeco.javacpp.FunctionPointer;
 import org.bytedeco.javacpp.Loader;
+import org.bytedeco.javacpp.LongPointer;
 import org.bytedeco.javacpp.Pointer;
+import org.bytedeco.javacpp.annotation.Cast;
 import org.bytedeco.qt.Qt5Core.QString;
 
 public class Qt5Core extends org.bytedeco.qt.presets.Qt5Core {
@@ -48,6 +56,101 @@ public class Qt5Core extends org.bytedeco.qt.presets.Qt5Core {
    */
   public static native void QtCore_verifyMainThread();
 
+  /**
+   * Receives on the main thread the ids posted since the last call, in posting order,
+   * along with the ids that got replaced by a later post with the same key
+   */
+  public static class QtCore_DispatchCallback extends FunctionPointer {
+    static { Loader.load(); }
+    public QtCore_DispatchCallback(Pointer p) { super(p); }
+    protected QtCore_DispatchCallback() { allocate(); }
+    private native void allocate();
+    public native void call(@Cast("const long long*") LongPointer ids, int count,
+                            @Cast("const long long*") LongPointer droppedIds, int droppedCount);
+  }
+
+  /**
+   * Sets the callback that receives the posted ids on the main thread
+   */
+  public static native void QtCore_setDispatchCallback(QtCore_DispatchCallback callback);
+
+  /**
+   * Posts an id from any thread, replacing any pending post with the same key unless it is 0,
+   * and delivered once the QCoreApplication exists when posted before its creation
+   */
+  public static native void QtCore_post(@Cast("long long") long key, @Cast("long long") long id);
+
+  /**
+   * Posts a batch of ids from any thread at once, with optional keys
+   */
+  public static native void QtCore_postBatch(@Cast("const long long*") long[] keys,
+                                             @Cast("const long long*") long[] ids, int count);
+
+  /**
+   * Delivers the pending ids right away, when called from the main thread
+   */
+  public static native void QtCore_drain();
+
+  /**
+   * Runs tasks posted from any thread on the main thread, all together once per
+   * iteration of the event loop, without a call to Qt for each of them. Tasks
+   * posted with the same nonzero key, such as the address of the widget they
+   * update, replace each other until they run.
+   */
+  public static class MainThreadDispatcher {
+
+    private static final Logger log = Logger.getLogger(MainThreadDispatcher.class.getName());
+
+    private static final Map<Long, Runnable> tasks = new ConcurrentHashMap<Long, Runnable>();
+
+    private static final AtomicLong nextId = new AtomicLong(1);
+
+    private static final QtCore_DispatchCallback callback = new QtCore_DispatchCallback() {
+      @Override
+      public void call(LongPointer ids, int count, LongPointer droppedIds, int droppedCount) {
+        for (int i = 0; i < droppedCount; i++) {
+          tasks.remove(droppedIds.get(i));
+        }
+        for (int i = 0; i < count; i++) {
+          Runnable task = tasks.remove(ids.get(i));
+          if (task != null) {
+            try {
+              task.run();
+            } catch (RuntimeException e) {
+              log.log(Level.WARNING, "Task posted to the main thread failed", e);
+            }
+          }
+        }
+      }
+    };
+
+    static {
+      QtCore_setDispatchCallback(callback);
+    }
+
+    private MainThreadDispatcher() {
+    }
+
+    public static void post(Runnable task) {
+      post(0, task);
+    }
+
+    public static void post(long key, Runnable task) {
+      long id = nextId.getAndIncrement();
+      tasks.put(id, task);
+      QtCore_post(key, id);
+    }
+
+    public static void postAll(long[] keys, Runnable[] tasks) {
+      long[] ids = new long[tasks.length];
+      for (int i = 0; i < tasks.length; i++) {
+        ids[i] = nextId.getAndIncrement();
+        MainThreadDispatcher.tasks.put(ids[i], tasks[i]);
+      }
+      QtCore_postBatch(keys, ids, tasks.length);
+    }
+  }
+
   public abstract static class AbstractQString extends Pointer {
 
     protected AbstractQString(Pointer pointer) {
@@ -20,7 +20,12 @@
  * limitations under the License.
  */
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
+#include <QtCore/QVector>
+#include <algorithm>
+#include <atomic>
 
 #ifdef __APPLE__
 #include <pthread.h>
@@ -37,3 +42,110 @@ void QtCore_verifyMainThread() {
     }
 #endif
 }
+
+/*
+ * Main-thread dispatcher: any thread posts (key, id) pairs onto a lock-free stack,
+ * and the main thread drains all of them at once in the next iteration of its
+ * event loop, handing the surviving ids to a single callback. Posts with the same
+ * nonzero key coalesce into the last one, whose ids are reported as dropped. Posts
+ * made before the QCoreApplication exists wait until its constructor schedules a drain.
+ */
+
+typedef void (*QtCore_DispatchCallback)(const long long* ids, int count,
+                                        const long long* droppedIds, int droppedCount);
+
+struct QtCore_DispatchNode {
+    long long key, id;
+    QtCore_DispatchNode* next;
+};
+
+static std::atomic<QtCore_DispatchCallback> QtCore_dispatchCallback(nullptr);
+static std::atomic<QtCore_DispatchNode*> QtCore_dispatchHead(nullptr);
+static std::atomic<bool> QtCore_drainScheduled(false);
+
+void QtCore_drain() {
+    // cleared before taking the stack, so that any later post schedules another drain
+    QtCore_drainScheduled.store(false);
+    QtCore_DispatchNode* node = QtCore_dispatchHead.exchange(nullptr, std::memory_order_acquire);
+    QVector<QtCore_DispatchNode*> nodes;
+    for (; node != nullptr; node = node->next) {
+        nodes.append(node);
+    }
+    if (nodes.isEmpty()) {
+        return;
+    }
+
+    // the stack holds the newest post first, so the first node seen for a key wins
+    QHash<long long, long long> latest;
+    QVector<long long> ids, droppedIds;
+    for (int i = 0; i < nodes.size(); i++) {
+        node = nodes[i];
+        if (node->key != 0) {
+            if (latest.contains(node->key)) {
+                droppedIds.append(node->id);
+                continue;
+            }
+            latest.insert(node->key, node->id);
+        }
+        ids.append(node->id);
+    }
+    std::reverse(ids.begin(), ids.end());
+    qDeleteAll(nodes);
+
+    QtCore_DispatchCallback callback = QtCore_dispatchCallback.load();
+    if (callback != nullptr) {
+        callback(ids.constData(), ids.size(), droppedIds.constData(), droppedIds.size());
+    }
+}
+
+// wakes up the main thread, unless a drain is already pending, or the application does not exist yet
+static void QtCore_scheduleDrain() {
+    QCoreApplication* app = QCoreApplication::instance();
+    if (app != nullptr && !QtCore_drainScheduled.exchange(true)) {
+        QMetaObject::invokeMethod(app, &QtCore_drain, Qt::QueuedConnection);
+    }
+}
+
+// called by the constructor of QCoreApplication, for the posts made before it existed
+static void QtCore_startDispatch() {
+    if (QtCore_dispatchHead.load() != nullptr) {
+        QtCore_scheduleDrain();
+    }
+}
+Q_COREAPP_STARTUP_FUNCTION(QtCore_startDispatch)
+
+static void QtCore_push(QtCore_DispatchNode* first, QtCore_DispatchNode* last) {
+    QtCore_DispatchNode* head = QtCore_dispatchHead.load(std::memory_order_relaxed);
+    do {
+        last->next = head;
+    } while (!QtCore_dispatchHead.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    QtCore_scheduleDrain();
+}
+
+void QtCore_setDispatchCallback(QtCore_DispatchCallback callback) {
+    QtCore_dispatchCallback = callback;
+    if (QtCore_dispatchHead.load() != nullptr) {
+        QtCore_scheduleDrain();
+    }
+}
+
+void QtCore_post(long long key, long long id) {
+    QtCore_DispatchNode* node = new QtCore_DispatchNode{key, id, nullptr};
+    QtCore_push(node, node);
+}
+
+void QtCore_postBatch(const long long* keys, const long long* ids, int count) {
+    if (count <= 0) {
+        return;
+    }
+    // link the batch in reverse so that the stack still holds the newest post first
+    QtCore_DispatchNode* first = nullptr;
+    QtCore_DispatchNode* last = nullptr;
+    for (int i = 0; i < count; i++) {
+        first = new QtCore_DispatchNode{keys != nullptr ? keys[i] : 0, ids[i], first};
+        if (last == nullptr) {
+            last = first;
+        }
+    }
+    QtCore_push(first, last);
+}
@@ -0,0 +1,63 @@
+import org.bytedeco.javacpp.*;
+import org.bytedeco.leptonica.*;
+import org.bytedeco.tesseract.*;
+import static org.bytedeco.leptonica.global.leptonica.*;
+import static org.bytedeco.tesseract.global.tesseract.*;
+
+/**
+ * Recognizes the image files given as arguments, for example the pages of a
+ * document, concurrently on all cores with TessBatchAPI. To run this program,
+ * you need to configure:
+ * <ul>
+ * <li>An environment variable pointing to the dictionaries installed on the system
+ * TESSDATA_PREFIX=/usr/share/tesseract-ocr/4.00</li>
+ * <li>An environment variable to tweak the Locale
+ * LC_ALL=C</li>
+ * <li>An environment variable to avoid nested OpenMP threads
+ * OMP_THREAD_LIMIT=1</li>
+ * </ul>
+ */
+public class BatchExample {
+    public static void main(String[] args) {
+        if (args.length == 0) {
+            System.err.println("Usage: BatchExample <image files...>");
+            System.exit(1);
+        }
+
+        TessBatchAPI api = new TessBatchAPI();
+        if (api.Init(System.getenv("TESSDATA_PREFIX") + "/tessdata", "eng", OEM_DEFAULT, 0) != 0) {
+            System.err.println("Could not initialize tesseract.");
+            System.exit(1);
+        }
+        api.SetPageSegMode(PSM_AUTO);
+
+        PointerPointer filenames = new PointerPointer(args);
+        long start = System.nanoTime();
+        int failed = api.RecognizeFiles(filenames, args.length);
+        double seconds = (System.nanoTime() - start) / 1e9;
+
+        BytePointer text = api.GetText().capacity(api.GetTextLength());
+        TessBatchPage pages = api.GetPages();
+        TessBatchWord words = api.GetWords();
+        for (int i = 0; i < args.length; i++) {
+            TessBatchPage page = pages.getPointer(i);
+            if (page.error() != 0) {
+                System.out.println(args[i] + ": could not be recognized");
+                continue;
+            }
+            System.out.println(args[i] + ": " + page.wordCount() + " words, confidence " + page.meanConfidence());
+            System.out.println(text.position(page.textOffset()).limit(page.textOffset() + page.textLength()).getString("UTF-8"));
+            for (long j = page.firstWord(); j < page.firstWord() + Math.min(page.wordCount(), 10); j++) {
+                TessBatchWord word = words.getPointer(j);
+                String s = text.position(word.textOffset()).limit(word.textOffset() + word.textLength()).getString("UTF-8");
+                System.out.printf("word: '%s';  \tconf: %.2f; BoundingBox: %d,%d,%d,%d;%n", s, word.confidence(),
+                        word.left(), word.top(), word.right(), word.bottom());
+            }
+        }
+        System.out.printf("%d pages (%d failed) with %d threads in %.2f s%n",
+                args.length, failed, api.GetThreadCount(), seconds);
+
+        api.End();
+        api.deallocate();
+    }
+}
@@ -0,0 +1,108 @@
+// Targeted by JavaCPP version 1.5.9-SNAPSHOT: DO NOT EDIT THIS FILE
+
+package org.bytedeco.tesseract;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+import org.bytedeco.leptonica.*;
+import static org.bytedeco.leptonica.global.leptonica.*;
+
+import static org.bytedeco.tesseract.global.tesseract.*;
+
+
+/**
+ * Recognizes batches of pages concurrently with one TessBaseAPI instance per
+ * thread. The traineddata files are read from disk only once, and the
+ * instances are kept from one batch to the next, so that the cost of
+ * initialization is paid at most once per thread. The results of a batch are
+ * packed in three arrays: the UTF-8 text of all pages and words, one
+ * TessBatchPage per image, and one TessBatchWord per word.
+ *
+ * When Tesseract is built with OpenMP, setting OMP_THREAD_LIMIT=1 avoids
+ * oversubscribing the cores. Recognize() and RecognizeFiles() run on all the
+ * threads and must not be called again before they return, so a TessBatchAPI
+ * must not be used from more than one thread at a time.
+ */
+@Namespace("tesseract") @NoOffset @Properties(inherit = org.bytedeco.tesseract.presets.tesseract.class)
+public class TessBatchAPI extends Pointer {
+    static { Loader.load(); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public TessBatchAPI(Pointer p) { super(p); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public TessBatchAPI(long size) { super((Pointer)null); allocateArray(size); }
+    private native void allocateArray(long size);
+    @Override public TessBatchAPI position(long position) {
+        return (TessBatchAPI)super.position(position);
+    }
+    @Override public TessBatchAPI getPointer(long i) {
+        return new TessBatchAPI((Pointer)this).offsetAddress(i);
+    }
+
+  public TessBatchAPI() { super((Pointer)null); allocate(); }
+  private native void allocate();
+
+  /**
+   * Initializes the instance of the calling thread, with the same parameters
+   * as TessBaseAPI::Init(), and starts the other threads, which initialize
+   * their instances the first time they are needed from the same data.
+   * @param threads the number of threads, including the calling one, or 0
+   * for the number of hardware threads
+   * @return 0 on success and -1 on initialization failure.
+   */
+  public native int Init(@Cast("const char*") BytePointer datapath, @Cast("const char*") BytePointer language, @Cast("tesseract::OcrEngineMode") int oem, int threads);
+  public native int Init(String datapath, String language, @Cast("tesseract::OcrEngineMode") int oem, int threads);
+
+  /**
+   * Sets a variable on all instances, including the ones not yet initialized.
+   * Can be called before Init() for init-only variables.
+   * @return false if the name lookup failed.
+   */
+  public native @Cast("bool") boolean SetVariable(@Cast("const char*") BytePointer name, @Cast("const char*") BytePointer value);
+  public native @Cast("bool") boolean SetVariable(String name, String value);
+
+  /** Sets the page segmentation mode of all instances. */
+  public native void SetPageSegMode(@Cast("tesseract::PageSegMode") int mode);
+
+  /** Returns the number of threads, including the calling one. */
+  public native int GetThreadCount();
+
+  /** Returns the number of instances initialized so far. */
+  public native int GetInstanceCount();
+
+  /**
+   * Recognizes images and replaces the results of the previous batch. The
+   * images are not modified and remain owned by the caller.
+   * @return the number of pages that could not be recognized, or -1 if Init()
+   * did not succeed.
+   */
+  public native int Recognize(@Cast("Pix**") PointerPointer images, int count);
+  public native int Recognize(@ByPtrPtr PIX images, int count);
+
+  /**
+   * Reads images with pixRead() and recognizes them, on the same threads.
+   * @return the number of pages that could not be read or recognized, or -1
+   * if Init() did not succeed.
+   */
+  public native int RecognizeFiles(@Cast("const char*const*") PointerPointer filenames, int count);
+  public native int RecognizeFiles(@Cast("const char*const*") @ByPtrPtr BytePointer filenames, int count);
+  public native int RecognizeFiles(@Cast("const char*const*") @ByPtrPtr ByteBuffer filenames, int count);
+  public native int RecognizeFiles(@Cast("const char*const*") @ByPtrPtr byte[] filenames, int count);
+
+  /** Returns the UTF-8 text of all pages and words of the last batch. */
+  public native @Cast("const char*") BytePointer GetText();
+  public native @Cast("size_t") long GetTextLength();
+
+  /** Returns the pages of the last batch, in the order of the images. */
+  public native @Const TessBatchPage GetPages();
+  public native int GetPageCount();
+
+  /** Returns the words of all pages of the last batch. */
+  public native @Const TessBatchWord GetWords();
+  public native @Cast("size_t") long GetWordCount();
+
+  /** Stops the threads and frees the instances and the data read. */
+  public native void End();
+}
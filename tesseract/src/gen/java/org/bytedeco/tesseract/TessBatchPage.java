@@ -0,0 +1,44 @@
+// Targeted by JavaCPP version 1.5.9-SNAPSHOT: DO NOT EDIT THIS FILE
+
+package org.bytedeco.tesseract;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+import org.bytedeco.leptonica.*;
+import static org.bytedeco.leptonica.global.leptonica.*;
+
+import static org.bytedeco.tesseract.global.tesseract.*;
+
+
+/** A recognized page, as a slice of the text of a batch and a range of its words. */
+@Namespace("tesseract") @Properties(inherit = org.bytedeco.tesseract.presets.tesseract.class)
+public class TessBatchPage extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public TessBatchPage() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public TessBatchPage(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public TessBatchPage(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public TessBatchPage position(long position) {
+        return (TessBatchPage)super.position(position);
+    }
+    @Override public TessBatchPage getPointer(long i) {
+        return new TessBatchPage((Pointer)this).offsetAddress(i);
+    }
+
+  public native @Cast("size_t") long textOffset(); public native TessBatchPage textOffset(long setter);
+  public native @Cast("size_t") long textLength(); public native TessBatchPage textLength(long setter);
+  /** The index of the first word of the page in the words of the batch. */
+  public native @Cast("size_t") long firstWord(); public native TessBatchPage firstWord(long setter);
+  public native @Cast("size_t") long wordCount(); public native TessBatchPage wordCount(long setter);
+  /** The mean confidence of the text, between 0 and 100. */
+  public native int meanConfidence(); public native TessBatchPage meanConfidence(int setter);
+  /** 0, or -1 if the image could not be read or recognized. */
+  public native int error(); public native TessBatchPage error(int setter);
+}
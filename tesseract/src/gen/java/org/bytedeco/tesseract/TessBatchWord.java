@@ -0,0 +1,43 @@
+// Targeted by JavaCPP version 1.5.9-SNAPSHOT: DO NOT EDIT THIS FILE
+
+package org.bytedeco.tesseract;
+
+import java.nio.*;
+import org.bytedeco.javacpp.*;
+import org.bytedeco.javacpp.annotation.*;
+
+import static org.bytedeco.javacpp.presets.javacpp.*;
+import org.bytedeco.leptonica.*;
+import static org.bytedeco.leptonica.global.leptonica.*;
+
+import static org.bytedeco.tesseract.global.tesseract.*;
+
+
+/** A recognized word, as a slice of the text of a batch and its bounding box. */
+@Namespace("tesseract") @Properties(inherit = org.bytedeco.tesseract.presets.tesseract.class)
+public class TessBatchWord extends Pointer {
+    static { Loader.load(); }
+    /** Default native constructor. */
+    public TessBatchWord() { super((Pointer)null); allocate(); }
+    /** Native array allocator. Access with {@link Pointer#position(long)}. */
+    public TessBatchWord(long size) { super((Pointer)null); allocateArray(size); }
+    /** Pointer cast constructor. Invokes {@link Pointer#Pointer(Pointer)}. */
+    public TessBatchWord(Pointer p) { super(p); }
+    private native void allocate();
+    private native void allocateArray(long size);
+    @Override public TessBatchWord position(long position) {
+        return (TessBatchWord)super.position(position);
+    }
+    @Override public TessBatchWord getPointer(long i) {
+        return new TessBatchWord((Pointer)this).offsetAddress(i);
+    }
+
+  public native @Cast("size_t") long textOffset(); public native TessBatchWord textOffset(long setter);
+  public native @Cast("size_t") long textLength(); public native TessBatchWord textLength(long setter);
+  public native int left(); public native TessBatchWord left(int setter);
+  public native int top(); public native TessBatchWord top(int setter);
+  public native int right(); public native TessBatchWord right(int setter);
+  public native int bottom(); public native TessBatchWord bottom(int setter);
+  /** The confidence of the word, between 0 and 100. */
+  public native float confidence(); public native TessBatchWord confidence(float setter);
+}
@@ -1445,4 +1445,53 @@ public static native void TessMonitorSetDeadlineMSecs(ETEXT_DESC monitor, int de
 // #endif // API_CAPI_H_
 
 
+// Parsed from batchapi.h
+
+// File:        batchapi.h
+// Description: Concurrent recognition of batches of pages with a pool of
+//              TessBaseAPI instances.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// #ifndef TESSERACT_API_BATCHAPI_H_
+// #define TESSERACT_API_BATCHAPI_H_
+
+// #include <leptonica/allheaders.h>
+// #include <tesseract/baseapi.h>
+// #include <tesseract/resultiterator.h>
+// #include "batch_pool.h"
+
+// #include <atomic>
+// #include <cstdio>
+// #include <cstring>
+// #include <functional>
+// #include <map>
+// #include <memory>
+// #include <mutex>
+// #include <string>
+// #include <thread>
+// #include <vector>
+// Targeting ../TessBatchPage.java
+
+
+// Targeting ../TessBatchWord.java
+
+
+// Targeting ../TessBatchAPI.java
+
+
+
+ // namespace tesseract.
+
+// #endif // TESSERACT_API_BATCHAPI_H_
+
+
 }
@@ -41,7 +41,7 @@ import org.bytedeco.leptonica.presets.leptonica;
 @Properties(target = "org.bytedeco.tesseract", global = "org.bytedeco.tesseract.global.tesseract", inherit = leptonica.class, value = {
     @Platform(define = "TESS_CAPI_INCLUDE_BASEAPI", include = {"tesseract/export.h", /*"tesseract/osdetect.h",*/ "tesseract/unichar.h",
         "tesseract/version.h", "tesseract/publictypes.h", "tesseract/pageiterator.h", "tesseract/ocrclass.h", "tesseract/ltrresultiterator.h",
-        "tesseract/renderer.h", "tesseract/resultiterator.h", "tesseract/baseapi.h", "tesseract/capi.h", "locale.h"},
+        "tesseract/renderer.h", "tesseract/resultiterator.h", "tesseract/baseapi.h", "tesseract/capi.h", "batchapi.h", "locale.h"},
         compiler = "cpp11", link = "tesseract@.5.3.0"/*, resource = {"include", "lib"}*/),
     @Platform(value = "android", link = "tesseract"),
     @Platform(value = "windows", link = "tesseract53", preload = "libtesseract53") })
@@ -0,0 +1,395 @@
+// File:        batchapi.h
+// Description: Concurrent recognition of batches of pages with a pool of
+//              TessBaseAPI instances.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TESSERACT_API_BATCHAPI_H_
+#define TESSERACT_API_BATCHAPI_H_
+
+#include <leptonica/allheaders.h>
+#include <tesseract/baseapi.h>
+#include <tesseract/resultiterator.h>
+#include "batch_pool.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tesseract {
+
+/** A recognized page, as a slice of the text of a batch and a range of its words. */
+struct TessBatchPage {
+  size_t textOffset;
+  size_t textLength;
+  /** The index of the first word of the page in the words of the batch. */
+  size_t firstWord;
+  size_t wordCount;
+  /** The mean confidence of the text, between 0 and 100. */
+  int meanConfidence;
+  /** 0, or -1 if the image could not be read or recognized. */
+  int error;
+};
+
+/** A recognized word, as a slice of the text of a batch and its bounding box. */
+struct TessBatchWord {
+  size_t textOffset;
+  size_t textLength;
+  int left;
+  int top;
+  int right;
+  int bottom;
+  /** The confidence of the word, between 0 and 100. */
+  float confidence;
+};
+
+/**
+ * Recognizes batches of pages concurrently with one TessBaseAPI instance per
+ * thread. The traineddata files are read from disk only once, and the
+ * instances are kept from one batch to the next, so that the cost of
+ * initialization is paid at most once per thread. The results of a batch are
+ * packed in three arrays: the UTF-8 text of all pages and words, one
+ * TessBatchPage per image, and one TessBatchWord per word.
+ *
+ * When Tesseract is built with OpenMP, setting OMP_THREAD_LIMIT=1 avoids
+ * oversubscribing the cores. Recognize() and RecognizeFiles() run on all the
+ * threads and must not be called again before they return, so a TessBatchAPI
+ * must not be used from more than one thread at a time.
+ */
+class TessBatchAPI {
+ public:
+  TessBatchAPI() : pageSegMode_(-1) {}
+  ~TessBatchAPI() {
+    End();
+  }
+
+  /**
+   * Initializes the instance of the calling thread, with the same parameters
+   * as TessBaseAPI::Init(), and starts the other threads, which initialize
+   * their instances the first time they are needed from the same data.
+   * @param threads the number of threads, including the calling one, or 0
+   * for the number of hardware threads
+   * @return 0 on success and -1 on initialization failure.
+   */
+  int Init(const char *datapath, const char *language, OcrEngineMode oem, int threads) {
+    End();
+    datapath_ = datapath != nullptr ? datapath : "";
+    hasDatapath_ = datapath != nullptr;
+    language_ = language != nullptr ? language : "";
+    hasLanguage_ = language != nullptr;
+    oem_ = oem;
+    if (threads <= 0) {
+      threads = std::thread::hardware_concurrency();
+    }
+    instances_.resize(threads > 0 ? threads : 1);
+    failed_.assign(instances_.size(), 0);
+    instances_[0] = NewInstance();
+    if (!instances_[0]) {
+      End();
+      return -1;
+    }
+    pool_.reset(new bytedeco::BatchPool((int)instances_.size()));
+    return 0;
+  }
+
+  /**
+   * Sets a variable on all instances, including the ones not yet initialized.
+   * Can be called before Init() for init-only variables.
+   * @return false if the name lookup failed.
+   */
+  bool SetVariable(const char *name, const char *value) {
+    varNames_.push_back(name);
+    varValues_.push_back(value);
+    bool found = true;
+    for (size_t i = 0; i < instances_.size(); i++) {
+      if (instances_[i]) {
+        found = instances_[i]->SetVariable(name, value) && found;
+      }
+    }
+    return found;
+  }
+
+  /** Sets the page segmentation mode of all instances. */
+  void SetPageSegMode(PageSegMode mode) {
+    pageSegMode_ = mode;
+  }
+
+  /** Returns the number of threads, including the calling one. */
+  int GetThreadCount() const {
+    return (int)instances_.size();
+  }
+
+  /** Returns the number of instances initialized so far. */
+  int GetInstanceCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int count = 0;
+    for (size_t i = 0; i < instances_.size(); i++) {
+      count += instances_[i] ? 1 : 0;
+    }
+    return count;
+  }
+
+  /**
+   * Recognizes images and replaces the results of the previous batch. The
+   * images are not modified and remain owned by the caller.
+   * @return the number of pages that could not be recognized, or -1 if Init()
+   * did not succeed.
+   */
+  int Recognize(Pix **images, int count) {
+    return RecognizeAll(images, nullptr, count);
+  }
+
+  /**
+   * Reads images with pixRead() and recognizes them, on the same threads.
+   * @return the number of pages that could not be read or recognized, or -1
+   * if Init() did not succeed.
+   */
+  int RecognizeFiles(const char *const *filenames, int count) {
+    return RecognizeAll(nullptr, filenames, count);
+  }
+
+  /** Returns the UTF-8 text of all pages and words of the last batch. */
+  const char *GetText() const {
+    return text_.c_str();
+  }
+  size_t GetTextLength() const {
+    return text_.size();
+  }
+
+  /** Returns the pages of the last batch, in the order of the images. */
+  const TessBatchPage *GetPages() const {
+    return pages_.data();
+  }
+  int GetPageCount() const {
+    return (int)pages_.size();
+  }
+
+  /** Returns the words of all pages of the last batch. */
+  const TessBatchWord *GetWords() const {
+    return words_.data();
+  }
+  size_t GetWordCount() const {
+    return words_.size();
+  }
+
+  /** Stops the threads and frees the instances and the data read. */
+  void End() {
+    pool_.reset();
+    instances_.clear();
+    files_.clear();
+  }
+
+ private:
+  TessBatchAPI(const TessBatchAPI &);
+  TessBatchAPI &operator=(const TessBatchAPI &);
+
+  /* the results of one page, before they get packed */
+  struct PageResult {
+    std::string text;
+    std::string wordText;
+    std::vector<TessBatchWord> words;
+    int meanConfidence;
+    int error;
+  };
+
+  static TessBatchAPI *&Reading() {
+    static thread_local TessBatchAPI *reading = nullptr;
+    return reading;
+  }
+
+  /* a FileReader returning the content of files read only once per TessBatchAPI */
+  static bool ReadCached(const char *filename, std::vector<char> *data) {
+    TessBatchAPI *api = Reading();
+    std::lock_guard<std::mutex> lock(api->filesMutex_);
+    std::shared_ptr<std::vector<char>> &file = api->files_[filename];
+    if (!file) {
+      FILE *fp = fopen(filename, "rb");
+      if (fp == nullptr) {
+        api->files_.erase(filename);
+        return false;
+      }
+      std::shared_ptr<std::vector<char>> bytes(new std::vector<char>());
+      char buffer[65536];
+      size_t n;
+      while ((n = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+        bytes->insert(bytes->end(), buffer, buffer + n);
+      }
+      bool failed = ferror(fp) != 0;
+      fclose(fp);
+      if (failed) {
+        api->files_.erase(filename);
+        return false;
+      }
+      file = bytes;
+    }
+    *data = *file;
+    return true;
+  }
+
+  std::unique_ptr<TessBaseAPI> NewInstance() {
+    std::unique_ptr<TessBaseAPI> api(new TessBaseAPI());
+    Reading() = this;
+    int ret = api->Init(hasDatapath_ ? datapath_.c_str() : nullptr, 0,
+                        hasLanguage_ ? language_.c_str() : nullptr, oem_, nullptr, 0,
+                        &varNames_, &varValues_, false, ReadCached);
+    Reading() = nullptr;
+    if (ret != 0) {
+      api.reset();
+    }
+    return api;
+  }
+
+  static void RecognizePage(TessBaseAPI *api, Pix *pix, int pageSegMode, PageResult *r) {
+    if (pageSegMode >= 0) {
+      api->SetPageSegMode((PageSegMode)pageSegMode);
+    }
+    api->SetImage(pix);
+    if (api->Recognize(nullptr) != 0) {
+      r->error = -1;
+      api->Clear();
+      return;
+    }
+    char *text = api->GetUTF8Text();
+    if (text != nullptr) {
+      r->text = text;
+      delete[] text;
+    }
+    r->meanConfidence = api->MeanTextConf();
+    ResultIterator *it = api->GetIterator();
+    if (it != nullptr) {
+      do {
+        if (it->Empty(RIL_WORD)) {
+          continue;
+        }
+        TessBatchWord w;
+        char *word = it->GetUTF8Text(RIL_WORD);
+        w.textOffset = r->wordText.size();
+        w.textLength = word != nullptr ? strlen(word) : 0;
+        if (word != nullptr) {
+          r->wordText += word;
+          delete[] word;
+        }
+        it->BoundingBox(RIL_WORD, &w.left, &w.top, &w.right, &w.bottom);
+        w.confidence = it->Confidence(RIL_WORD);
+        r->words.push_back(w);
+      } while (it->Next(RIL_WORD));
+      delete it;
+    }
+    api->Clear();
+  }
+
+  int RecognizeAll(Pix **images, const char *const *filenames, int count) {
+    text_.clear();
+    pages_.clear();
+    words_.clear();
+    if (instances_.empty() || !instances_[0] || count < 0) {
+      return -1;
+    }
+    std::vector<PageResult> results(count);
+    std::atomic<int> next(0);
+    int pageSegMode = pageSegMode_;
+    Run([&](TessBaseAPI *api) {
+      int i;
+      while ((i = next++) < count) {
+        PageResult &r = results[i];
+        r.meanConfidence = 0;
+        r.error = 0;
+        Pix *pix = images != nullptr ? images[i] : pixRead(filenames[i]);
+        if (pix == nullptr) {
+          r.error = -1;
+          continue;
+        }
+        RecognizePage(api, pix, pageSegMode, &r);
+        if (images == nullptr) {
+          pixDestroy(&pix);
+        }
+      }
+    });
+
+    int failed = 0;
+    size_t textLength = 0, wordCount = 0;
+    for (int i = 0; i < count; i++) {
+      textLength += results[i].text.size() + results[i].wordText.size();
+      wordCount += results[i].words.size();
+    }
+    text_.reserve(textLength);
+    pages_.resize(count);
+    words_.reserve(wordCount);
+    for (int i = 0; i < count; i++) {
+      PageResult &r = results[i];
+      TessBatchPage &p = pages_[i];
+      p.textOffset = text_.size();
+      p.textLength = r.text.size();
+      text_ += r.text;
+      size_t base = text_.size();
+      text_ += r.wordText;
+      p.firstWord = words_.size();
+      p.wordCount = r.words.size();
+      for (size_t j = 0; j < r.words.size(); j++) {
+        words_.push_back(r.words[j]);
+        words_.back().textOffset += base;
+      }
+      p.meanConfidence = r.meanConfidence;
+      p.error = r.error;
+      failed += r.error != 0 ? 1 : 0;
+    }
+    return failed;
+  }
+
+  /* runs job() on the threads of the pool with their instance, initialized the first time */
+  void Run(const std::function<void(TessBaseAPI *)> &job) {
+    pool_->run([&](int index) {
+      TessBaseAPI *api = instances_[index].get();
+      if (api == nullptr && !failed_[index]) {
+        std::unique_ptr<TessBaseAPI> instance = NewInstance();
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed_[index] = !instance;
+        instances_[index] = std::move(instance);
+        api = instances_[index].get();
+      }
+      if (api != nullptr) {
+        job(api);
+      }
+    });
+  }
+
+  std::string datapath_;
+  std::string language_;
+  bool hasDatapath_;
+  bool hasLanguage_;
+  OcrEngineMode oem_;
+  int pageSegMode_;
+  std::vector<std::string> varNames_;
+  std::vector<std::string> varValues_;
+
+  std::mutex filesMutex_;
+  std::map<std::string, std::shared_ptr<std::vector<char>>> files_;
+
+  std::vector<std::unique_ptr<TessBaseAPI>> instances_;
+  std::vector<char> failed_;
+  std::mutex mutex_;
+  std::unique_ptr<bytedeco::BatchPool> pool_;
+
+  std::string text_;
+  std::vector<TessBatchPage> pages_;
+  std::vector<TessBatchWord> words_;
+};
+
+} // namespace tesseract.
+
+#endif // TESSERACT_API_BATCHAPI_H_